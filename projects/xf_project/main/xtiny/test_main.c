@@ -36,6 +36,15 @@
 #define EXAMPLE_TASK_AWAIT              5
 #define EXAMPLE_TASK_WAIT_EVENT         6
 #define EXAMPLE_TASK_SCENE              7
+#define EXAMPLE_TASK_CHAN               8
+#define EXAMPLE_TASK_DELAY_UNTIL        9
+#define EXAMPLE_STD_MEM_BENCH           10
+#define EXAMPLE_STD_STRING_FUZZ         11
+#define EXAMPLE_STD_PRINTF_BENCH        12
+#define EXAMPLE_DSTRUCT_TLSF            13
+#define EXAMPLE_ALGO_BITOPS             14
+#define EXAMPLE_SYSTEM_PROF             15
+#define EXAMPLE_STD_PRINTF_CHECK        16
 
 #define EXAMPLE                         EXAMPLE_TASK_AWAIT
 
@@ -45,6 +54,7 @@
 
 void ex_random_seed(uint32_t seed);
 uint32_t ex_random(void);
+uint32_t bench_now_us(void);
 
 /* ==================== [Static Variables] ================================== */
 
@@ -54,6 +64,14 @@ static uint32_t l_rnd = 42; // random seed
 
 /* ==================== [Global Functions] ================================== */
 
+/* 各耗时对比示例共用的微秒时间戳 */
+uint32_t bench_now_us(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (uint32_t)(tv.tv_sec * 1000000U + tv.tv_usec);
+}
+
 #if EXAMPLE == EXAMPLE_PS
 
 void subscr_cb1(xf_subscr_t *s, uint8_t ref_cnt, void *arg)
@@ -602,6 +620,697 @@ void _xf_uart_write(int uart_id, const char *buf, int len)
     XF_LOGI("_xf_uart_write", "uart_id: %d, buf: \"%s\", len: %d", uart_id, buf, len);
 }
 
+#elif EXAMPLE == EXAMPLE_TASK_CHAN
+
+XF_TASK_FUNC(producer_task);
+XF_TASK_FUNC(consumer_task);
+
+static xf_chan_t s_chan;
+static uint32_t s_chan_buf[4];
+
+void test_main(void)
+{
+    xf_tick_t delay_tick;
+    xf_task_sched_init();
+    xf_chan_init_array(&s_chan, s_chan_buf);
+
+    xf_task_create(consumer_task, NULL);
+    xf_task_create(producer_task, NULL);
+
+    while (1) {
+        delay_tick = xf_stimer_handler();
+        if (delay_tick != 0) {
+            osDelayMs(delay_tick);
+            (void)xf_tick_inc(delay_tick);
+        }
+    }
+}
+
+XF_TASK_FUNC(producer_task)
+{
+    const char *const tag = "producer_task";
+    /* 阻塞期间局部变量不保留，待发送的数据放在静态存储中 */
+    static uint32_t s_value = 0;
+    xf_task_begin(me);
+    while (1) {
+        s_value++;
+        xf_chan_send(me, &s_chan, &s_value);
+        XF_LOGI(tag, "sent: %u, filled: %u",
+                (unsigned int)s_value, (unsigned int)xf_chan_get_filled(&s_chan));
+    }
+    xf_task_end(me);
+}
+
+XF_TASK_FUNC(consumer_task)
+{
+    const char *const tag = "consumer_task";
+    uint32_t value;
+    xf_task_begin(me);
+    while (1) {
+        xf_chan_recv(me, &s_chan, &value);
+        XF_LOGI(tag, "got: %u", (unsigned int)value);
+        xf_task_delay_ms(me, 500);
+    }
+    xf_task_end(me);
+}
+
+#elif EXAMPLE == EXAMPLE_TASK_DELAY_UNTIL
+
+XF_TASK_FUNC(sample_task);
+
+static void sample_timer_cb(xf_stimer_t *t)
+{
+    XF_LOGI(TAG, "timer: %u", (unsigned int)t->tick_last_run);
+}
+
+void test_main(void)
+{
+    xf_tick_t delay_tick;
+    xf_stimer_t *stimer;
+    xf_task_sched_init();
+
+    /* 固定速率定时器，执行延迟不会累积 */
+    stimer = xf_stimer_create(100U, (xf_stimer_cb_t)sample_timer_cb, NULL);
+    xf_stimer_set_fixed_rate(stimer, TRUE);
+
+    xf_task_create(sample_task, NULL);
+
+    while (1) {
+        delay_tick = xf_stimer_handler();
+        if (delay_tick != 0) {
+            osDelayMs(delay_tick);
+            (void)xf_tick_inc(delay_tick);
+        }
+    }
+}
+
+XF_TASK_FUNC(sample_task)
+{
+    const char *const tag = "sample_task";
+    /* 阻塞期间局部变量不保留，上一次唤醒时间放在静态存储中 */
+    static xf_tick_t s_tick_last_wake;
+    xf_task_begin(me);
+    s_tick_last_wake = xf_tick_get_count();
+    while (1) {
+        xf_task_delay_until(me, &s_tick_last_wake, 100U);
+        XF_LOGI(tag, "wake: %u, now: %u",
+                (unsigned int)s_tick_last_wake, (unsigned int)xf_tick_get_count());
+    }
+    xf_task_end(me);
+}
+
+#elif EXAMPLE == EXAMPLE_STD_MEM_BENCH
+
+/*
+    对比 xf_mem* 与 libc 在不同长度、对齐下的耗时。
+    xf_mem* 的实现由 XF_STRING_ENABLE_BUILTIN / XF_STRING_ENABLE_LIBC /
+    XF_STRING_ENABLE_SIMD 决定，分别编译运行即可得到三者的对比。
+ */
+
+#define BENCH_BUF_SIZE                  (4096 + 64)
+
+static uint8_t s_bench_src[BENCH_BUF_SIZE];
+static uint8_t s_bench_dst[BENCH_BUF_SIZE];
+
+void test_main(void)
+{
+    static const size_t sizes[] = {8, 32, 64, 256, 1024, 4096};
+    static const size_t aligns[][2] = {{0, 0}, {1, 0}, {3, 5}};
+    volatile int sink = 0;
+    uint32_t t0;
+    uint32_t t_xf;
+    uint32_t t_libc;
+    uint32_t iter;
+    size_t i;
+    size_t j;
+    uint32_t k;
+
+    for (i = 0; i < BENCH_BUF_SIZE; i++) {
+        s_bench_src[i] = (uint8_t)ex_random();
+    }
+    XF_LOGI(TAG, "%-8s %6s %6s %10s %10s", "func", "size", "align", "xf(us)", "libc(us)");
+    for (j = 0; j < ARRAY_SIZE(aligns); j++) {
+        uint8_t *d = &s_bench_dst[aligns[j][0]];
+        const uint8_t *s = &s_bench_src[aligns[j][1]];
+        for (i = 0; i < ARRAY_SIZE(sizes); i++) {
+            iter = (uint32_t)(4U * 1024U * 1024U / sizes[i]);
+
+            t0 = bench_now_us();
+            for (k = 0; k < iter; k++) { xf_memcpy(d, s, sizes[i]); }
+            t_xf = bench_now_us() - t0;
+            t0 = bench_now_us();
+            for (k = 0; k < iter; k++) { memcpy(d, s, sizes[i]); }
+            t_libc = bench_now_us() - t0;
+            XF_LOGI(TAG, "%-8s %6u %3u/%-2u %10u %10u", "memcpy", (unsigned int)sizes[i],
+                    (unsigned int)aligns[j][0], (unsigned int)aligns[j][1],
+                    (unsigned int)t_xf, (unsigned int)t_libc);
+
+            t0 = bench_now_us();
+            for (k = 0; k < iter; k++) { xf_memmove(d, s, sizes[i]); }
+            t_xf = bench_now_us() - t0;
+            t0 = bench_now_us();
+            for (k = 0; k < iter; k++) { memmove(d, s, sizes[i]); }
+            t_libc = bench_now_us() - t0;
+            XF_LOGI(TAG, "%-8s %6u %3u/%-2u %10u %10u", "memmove", (unsigned int)sizes[i],
+                    (unsigned int)aligns[j][0], (unsigned int)aligns[j][1],
+                    (unsigned int)t_xf, (unsigned int)t_libc);
+
+            t0 = bench_now_us();
+            for (k = 0; k < iter; k++) { xf_memset(d, (uint8_t)k, sizes[i]); }
+            t_xf = bench_now_us() - t0;
+            t0 = bench_now_us();
+            for (k = 0; k < iter; k++) { memset(d, (int)(uint8_t)k, sizes[i]); }
+            t_libc = bench_now_us() - t0;
+            XF_LOGI(TAG, "%-8s %6u %3u/%-2u %10u %10u", "memset", (unsigned int)sizes[i],
+                    (unsigned int)aligns[j][0], (unsigned int)aligns[j][1],
+                    (unsigned int)t_xf, (unsigned int)t_libc);
+
+            xf_memcpy(d, s, sizes[i]);
+            t0 = bench_now_us();
+            for (k = 0; k < iter; k++) { sink += xf_memcmp(d, s, sizes[i]); }
+            t_xf = bench_now_us() - t0;
+            t0 = bench_now_us();
+            for (k = 0; k < iter; k++) { sink += memcmp(d, s, sizes[i]); }
+            t_libc = bench_now_us() - t0;
+            XF_LOGI(TAG, "%-8s %6u %3u/%-2u %10u %10u", "memcmp", (unsigned int)sizes[i],
+                    (unsigned int)aligns[j][0], (unsigned int)aligns[j][1],
+                    (unsigned int)t_xf, (unsigned int)t_libc);
+        }
+    }
+    UNUSED(sink);
+}
+
+#elif EXAMPLE == EXAMPLE_STD_STRING_FUZZ
+
+/*
+    以 libc 为参照随机比对 xf_strlen/xf_strnlen/xf_strcmp/xf_strlcpy,
+    覆盖不同起始对齐、长度和截断长度。
+ */
+
+#define FUZZ_ITER                       100000U
+#define FUZZ_BUF_SIZE                   160
+
+static int fuzz_sign(int x)
+{
+    return (x > 0) - (x < 0);
+}
+
+void test_main(void)
+{
+    char a[FUZZ_BUF_SIZE];
+    char b[FUZZ_BUF_SIZE];
+    char d1[FUZZ_BUF_SIZE];
+    char d2[FUZZ_BUF_SIZE];
+    uint32_t fails = 0;
+    uint32_t it;
+    uint32_t i;
+
+    for (it = 0; it < FUZZ_ITER; it++) {
+        /* 字符集小时更容易出现长公共前缀 */
+        uint32_t charset = (it & 1U) ? 3U : 255U;
+        uint32_t la = ex_random() % 100U;
+        uint32_t lb;
+        uint32_t oa = ex_random() % 9U;
+        uint32_t ob = ex_random() % 9U;
+        size_t n = ex_random() % 120U;
+        size_t ds = ex_random() % 110U;
+        size_t r1;
+        size_t r2;
+        size_t c;
+
+        for (i = 0; i < la; i++) {
+            a[oa + i] = (char)(1U + ex_random() % charset);
+        }
+        a[oa + la] = '\0';
+        if (ex_random() & 1U) {
+            lb = la;
+            memcpy(&b[ob], &a[oa], la + 1U);
+            if ((la != 0) && (ex_random() & 1U)) {
+                b[ob + ex_random() % la] ^= (char)(1U + ex_random() % 2U);
+            }
+        } else {
+            lb = ex_random() % 100U;
+            for (i = 0; i < lb; i++) {
+                b[ob + i] = (char)(1U + ex_random() % 3U);
+            }
+            b[ob + lb] = '\0';
+        }
+
+        if (xf_strlen(&a[oa]) != strlen(&a[oa])) {
+            fails++;
+            XF_LOGE(TAG, "strlen: la=%u oa=%u", (unsigned int)la, (unsigned int)oa);
+        }
+        if (xf_strnlen(&a[oa], n) != strnlen(&a[oa], n)) {
+            fails++;
+            XF_LOGE(TAG, "strnlen: la=%u oa=%u n=%u", (unsigned int)la, (unsigned int)oa, (unsigned int)n);
+        }
+        if (fuzz_sign(xf_strcmp(&a[oa], &b[ob])) != fuzz_sign(strcmp(&a[oa], &b[ob]))) {
+            fails++;
+            XF_LOGE(TAG, "strcmp: la=%u lb=%u", (unsigned int)la, (unsigned int)lb);
+        }
+
+        memset(d1, 0x55, sizeof(d1));
+        memset(d2, 0x55, sizeof(d2));
+        r1 = xf_strlcpy(&d1[ob], &a[oa], ds);
+        r2 = strlen(&a[oa]);
+        if (ds != 0) {
+            c = (r2 < (ds - 1U)) ? r2 : (ds - 1U);
+            memcpy(&d2[ob], &a[oa], c);
+            d2[ob + c] = '\0';
+        }
+        if ((r1 != r2) || (memcmp(d1, d2, sizeof(d1)) != 0)) {
+            fails++;
+            XF_LOGE(TAG, "strlcpy: la=%u ds=%u", (unsigned int)la, (unsigned int)ds);
+        }
+    }
+    XF_LOGI(TAG, "string fuzz: %u iterations, %u failures", (unsigned int)FUZZ_ITER, (unsigned int)fails);
+}
+
+#elif EXAMPLE == EXAMPLE_STD_PRINTF_BENCH
+
+/* 对比 xf_snprintf 与 libc snprintf 的耗时 */
+
+#define BENCH_ITER                      200000U
+
+void test_main(void)
+{
+    char buf[128];
+    uint32_t t0;
+    uint32_t t_xf;
+    uint32_t t_libc;
+    uint32_t k;
+
+#define BENCH_ONE(_name, ...) \
+    do { \
+        t0 = bench_now_us(); \
+        for (k = 0; k < BENCH_ITER; k++) { (void)xf_snprintf(buf, sizeof(buf), __VA_ARGS__); } \
+        t_xf = bench_now_us() - t0; \
+        t0 = bench_now_us(); \
+        for (k = 0; k < BENCH_ITER; k++) { (void)snprintf(buf, sizeof(buf), __VA_ARGS__); } \
+        t_libc = bench_now_us() - t0; \
+        XF_LOGI(TAG, "%-10s xf: %8u us, libc: %8u us", (_name), \
+                (unsigned int)t_xf, (unsigned int)t_libc); \
+    } while (0)
+
+    BENCH_ONE("u32", "%u", (unsigned int)(k * 2654435761U));
+    BENCH_ONE("i32 width", "%10d|%-6d", (int)k - 100000, (int)k);
+    BENCH_ONE("hex", "0x%08x", (unsigned int)k);
+    BENCH_ONE("u64", "%llu", (unsigned long long)k * 1000000007ULL);
+    BENCH_ONE("str", "%s: %.*s", "tag", 5, "message");
+    BENCH_ONE("log line", "%c (%lu)-%s: hi: %u", 'I', (unsigned long)k, "task", (unsigned int)k);
+
+#undef BENCH_ONE
+}
+
+#elif EXAMPLE == EXAMPLE_STD_PRINTF_CHECK
+
+/*
+    xf_snprintf 正确性：先对比固定的参照字符串，
+    再以 libc snprintf 为参照随机比对 %f（需要 XF_PRINTF_ENABLE_FLOAT 为 1）。
+ */
+
+#define PRINTF_CHECK_ITER               1000000U
+
+#define PRINTF_CHECK(_expect, ...) \
+    do { \
+        (void)xf_snprintf(buf, sizeof(buf), __VA_ARGS__); \
+        if (strcmp(buf, (_expect)) != 0) { \
+            XF_LOGE(TAG, "line %d: got \"%s\", expect \"%s\"", __LINE__, buf, (_expect)); \
+            fails++; \
+        } \
+    } while (0)
+
+void test_main(void)
+{
+    char buf[128];
+    char ref[128];
+    uint32_t fails = 0;
+    uint32_t it;
+
+    PRINTF_CHECK("42|-42|  42|42  |0042", "%d|%d|%4d|%-4d|%04d", 42, -42, 42, 42, 42);
+    PRINTF_CHECK("+1| 1|-0001", "%+d|% d|%05d", 1, 1, -1);
+    PRINTF_CHECK("0x1f|1F|017|0", "%#x|%X|%#o|%#x", 31U, 31U, 15U, 0U);
+    PRINTF_CHECK("[0][][][0]", "[%#.0o][%.0o][%.0d][%#o]", 0U, 0U, 0, 0U);
+    PRINTF_CHECK("18446744073709551615|-9223372036854775808",
+                 "%llu|%lld", 18446744073709551615ULL, (-9223372036854775807LL - 1));
+    PRINTF_CHECK("abc|  abc|ab", "%s|%5s|%.2s", "abc", "abc", "abc");
+    PRINTF_CHECK("x|%|(null)", "%c|%%|%s", 'x', (const char *)NULL);
+    PRINTF_CHECK("0x0|0x10", "%p|%p", (void *)NULL, (void *)(uintptr_t)0x10U);
+    /* 不支持的转换取出参数后原样输出，后面的参数不错位 */
+    PRINTF_CHECK("%e %g 7 %a ok", "%e %g %d %a %s", 1.0, 2.0, 7, 3.0, "ok");
+#if XF_PRINTF_ENABLE_FLOAT
+    PRINTF_CHECK("2.9|0.1|0.21|1.00", "%.1f|%.1f|%.2f|%.2f", 2.85, 0.05, 0.215, 1.005);
+    PRINTF_CHECK("0|2|2|0.2", "%.0f|%.0f|%.0f|%.1f", 0.5, 1.5, 2.5, 0.25);
+    PRINTF_CHECK("3.140000|-0.500|+003.14|1.|3.250000", "%f|%.3f|%+07.2f|%#.0f|%Lf",
+                 3.14, -0.5, 3.14159, 1.0, (long double)3.25);
+    PRINTF_CHECK("nan|inf|-inf", "%f|%f|%f", 0.0 / 0.0, 1.0 / 0.0, -1.0 / 0.0);
+    /* 超过 2^64 的整数部分、超过 9 位的精度与 -0.0 */
+    PRINTF_CHECK("100000000000000000000.000000|0.333333333333333|0.000000000100000000|-0.00",
+                 "%f|%.15f|%.18f|%.2f", 1e20, 1.0 / 3.0, 1e-10, -0.0);
+    PRINTF_CHECK("1267650600228229401496703205376|301",
+                 "%.0f|%d", 1267650600228229401496703205376.0,
+                 xf_snprintf(NULL, 0, "%.0f", 1e300));
+
+    for (it = 0; it < PRINTF_CHECK_ITER; it++) {
+        static const char *const s_fmt[] = {"%.0f", "%.1f", "%.2f", "%.3f", "%.6f", "%.9f", "%.17f", "%.25f"};
+        const char *fmt = s_fmt[it % (sizeof(s_fmt) / sizeof(s_fmt[0]))];
+        /* 小数位较少的值容易落在舍入的一半附近 */
+        double v = (it & 1U) ? ((double)(ex_random() % 100000U) / 1000.0)
+                   : ((double)ex_random() / (double)(1U + ex_random() % 100000U));
+        if ((it % 5U) == 4U) {
+            v *= (it & 2U) ? 1e18 : 1e-12;
+        }
+        (void)xf_snprintf(buf, sizeof(buf), fmt, v);
+        (void)snprintf(ref, sizeof(ref), fmt, v);
+        if (strcmp(buf, ref) != 0) {
+            if (fails < 10U) {
+                XF_LOGE(TAG, "%s %.17g: got \"%s\", libc \"%s\"", fmt, v, buf, ref);
+            }
+            fails++;
+        }
+    }
+#else
+    UNUSED(ref);
+    UNUSED(it);
+#endif
+
+    XF_LOGI(TAG, "printf check fails: %u", (unsigned int)fails);
+}
+
+#undef PRINTF_CHECK
+
+#elif EXAMPLE == EXAMPLE_DSTRUCT_TLSF
+
+/*
+    在 xf_tlsf 上随机分配、释放不同大小的块，校验数据与堆完整性，
+    并以相同的操作序列对比 libc malloc/free 的耗时。
+ */
+
+#define TLSF_HEAP_SIZE                  (16 * 1024)
+#define TLSF_SLOT_NUM                   64
+#define TLSF_ITER                       200000U
+
+static uint8_t s_tlsf_heap[TLSF_HEAP_SIZE];
+
+static size_t tlsf_rand_size(void)
+{
+    /* 多数为小块，少量大块 */
+    return ((ex_random() & 7U) == 0) ? (ex_random() % 1024U) : (1U + ex_random() % 48U);
+}
+
+void test_main(void)
+{
+    void *slot[TLSF_SLOT_NUM] = {0};
+    uint8_t tag[TLSF_SLOT_NUM] = {0};
+    xf_tlsf_stats_t stats;
+    xf_tlsf_t *p_tlsf;
+    uint32_t fails = 0;
+    uint32_t t0;
+    uint32_t t_xf;
+    uint32_t t_libc;
+    uint32_t it;
+    uint32_t i;
+
+    p_tlsf = xf_tlsf_create(s_tlsf_heap, sizeof(s_tlsf_heap));
+    if (p_tlsf == NULL) {
+        XF_LOGE(TAG, "xf_tlsf_create failed");
+        return;
+    }
+
+    ex_random_seed(1);
+    for (it = 0; it < TLSF_ITER; it++) {
+        i = ex_random() % TLSF_SLOT_NUM;
+        if (slot[i] != NULL) {
+            size_t size = xf_tlsf_block_size(slot[i]);
+            if ((size != 0) && (((uint8_t *)slot[i])[size - 1U] != tag[i])) {
+                fails++;
+            }
+            xf_tlsf_free(p_tlsf, slot[i]);
+            slot[i] = NULL;
+        } else {
+            slot[i] = xf_tlsf_malloc(p_tlsf, tlsf_rand_size());
+            if (slot[i] != NULL) {
+                tag[i] = (uint8_t)it;
+                memset(slot[i], tag[i], xf_tlsf_block_size(slot[i]));
+            }
+        }
+        if (((it % 1000U) == 0) && (xf_tlsf_check(p_tlsf) != XF_OK)) {
+            fails++;
+        }
+    }
+    xf_tlsf_get_stats(p_tlsf, &stats);
+    XF_LOGI(TAG, "tlsf: %u failures, used %u/%u (max %u), free blocks %u, largest free %u, malloc fails %u",
+            (unsigned int)fails, (unsigned int)stats.size_used,
+            (unsigned int)(stats.size_used + stats.size_free), (unsigned int)stats.size_used_max,
+            (unsigned int)stats.blk_free, (unsigned int)stats.size_free_max, (unsigned int)stats.fail_cnt);
+
+#define BENCH_LOOP(_alloc, _free) \
+    do { \
+        ex_random_seed(2); \
+        t0 = bench_now_us(); \
+        for (it = 0; it < TLSF_ITER; it++) { \
+            i = ex_random() % TLSF_SLOT_NUM; \
+            if (slot[i] != NULL) { _free(slot[i]); slot[i] = NULL; } \
+            else { slot[i] = _alloc(tlsf_rand_size()); } \
+        } \
+        for (i = 0; i < TLSF_SLOT_NUM; i++) { if (slot[i] != NULL) { _free(slot[i]); slot[i] = NULL; } } \
+    } while (0)
+
+#define TLSF_ALLOC(_size)               xf_tlsf_malloc(p_tlsf, (_size))
+#define TLSF_FREE(_p)                   xf_tlsf_free(p_tlsf, (_p))
+
+    for (i = 0; i < TLSF_SLOT_NUM; i++) {
+        xf_tlsf_free(p_tlsf, slot[i]);
+        slot[i] = NULL;
+    }
+    BENCH_LOOP(TLSF_ALLOC, TLSF_FREE);
+    t_xf = bench_now_us() - t0;
+    BENCH_LOOP(malloc, free);
+    t_libc = bench_now_us() - t0;
+    XF_LOGI(TAG, "%u ops, xf_tlsf: %u us, libc: %u us",
+            (unsigned int)TLSF_ITER, (unsigned int)t_xf, (unsigned int)t_libc);
+
+#undef TLSF_ALLOC
+#undef TLSF_FREE
+#undef BENCH_LOOP
+}
+
+#elif EXAMPLE == EXAMPLE_ALGO_BITOPS
+
+/*
+    校验 xf_am_* 在当前后端（XF_AM_BUILTIN_*）下与可移植实现 (*_sw) 对全部 2^32 个输入结果一致，
+    用逐位计算的参照随机抽查 *_sw 及 64 位版本，最后对比两者的耗时。
+    分别以 XF_COMMON_ENABLE_BUILTIN 为 0/1 编译运行。
+ */
+
+#define BITOPS_RANDOM_ITER              1000000U
+#define BITOPS_BENCH_ITER               (16U * 1024U * 1024U)
+
+static uint32_t bitops_ref_clz(uint32_t n)
+{
+    uint32_t i = 0;
+    while ((i < 32U) && ((n & (0x80000000U >> i)) == 0U)) {
+        i++;
+    }
+    return i;
+}
+
+static uint32_t bitops_ref_reverse(uint32_t n)
+{
+    uint32_t r = 0;
+    uint32_t i;
+    for (i = 0; i < 32U; i++) {
+        r |= ((n >> i) & 1U) << (31U - i);
+    }
+    return r;
+}
+
+static uint32_t bitops_check_u64(uint64_t x)
+{
+    uint64_t r = 0;
+    uint64_t p = 1;
+    uint32_t clz = 0;
+    uint32_t ctz = 0;
+    uint32_t pop = 0;
+    uint32_t i;
+    for (i = 0; i < 64U; i++) {
+        r |= ((x >> i) & 1U) << (63U - i);
+        pop += (uint32_t)((x >> i) & 1U);
+    }
+    while ((clz < 64U) && ((x & (0x8000000000000000ULL >> clz)) == 0U)) {
+        clz++;
+    }
+    while ((ctz < 64U) && ((x & ((uint64_t)1 << ctz)) == 0U)) {
+        ctz++;
+    }
+    while ((p < x) && (p != 0x8000000000000000ULL)) {
+        p <<= 1;
+    }
+    return (xf_am_clz_u64(x) != clz)
+           + (xf_am_clz_u64_sw(x) != clz)
+           + (xf_am_ctz_u64(x) != ctz)
+           + (xf_am_popcount_u64(x) != pop)
+           + (xf_am_log2_u64(x) != ((x != 0U) ? (63U - clz) : 0U))
+           + (xf_am_reverse_u64(x) != r)
+           + (xf_am_swap_u64(xf_am_swap_u64(x)) != x)
+           + ((uint32_t)xf_am_swap_u64(x) != xf_am_swap_u32((uint32_t)(x >> 32)))
+           + (xf_am_flp2_u64(x) != ((x != 0U) ? ((uint64_t)1 << (63U - clz)) : 0U))
+           + (xf_am_clp2_u64(x) != ((x == 0U) ? 0U : ((p >= x) ? p : 0U)));
+}
+
+void test_main(void)
+{
+    volatile uint32_t sink = 0;
+    uint32_t fails = 0;
+    uint32_t n = 0;
+    uint32_t t0;
+    uint32_t t_hw;
+    uint32_t t_sw;
+    uint32_t k;
+
+    XF_LOGI(TAG, "backend: clz=%d popcount=%d bswap=%d reverse=%d",
+            XF_AM_BUILTIN_CLZ, XF_AM_BUILTIN_POPCOUNT, XF_AM_BUILTIN_BSWAP, XF_AM_BUILTIN_REVERSE);
+
+    do {
+        if ((xf_am_clz_u32(n) != xf_am_clz_u32_sw(n))
+                || (xf_am_ctz_u32(n) != xf_am_ctz_u32_sw(n))
+                || (xf_am_log2_u32(n) != xf_am_log2_u32_sw(n))
+                || (xf_am_popcount_u32(n) != xf_am_popcount_u32_v1(n))
+                || (xf_am_swap_u32(n) != xf_am_swap_u32_sw(n))
+                || (xf_am_reverse_u32(n) != xf_am_reverse_u32_sw(n))
+                || (xf_am_flp2_u32(n) != xf_am_flp2_u32_sw(n))
+                || (xf_am_clp2_u32(n) != xf_am_clp2_u32_sw(n))) {
+            if (fails++ < 8U) {
+                XF_LOGE(TAG, "mismatch: 0x%08x", (unsigned int)n);
+            }
+        }
+    } while (++n != 0U);
+    XF_LOGI(TAG, "exhaustive: %u failures", (unsigned int)fails);
+
+    fails = 0;
+    for (k = 0; k < BITOPS_RANDOM_ITER; k++) {
+        /* 随机截断，覆盖各种前导 0 个数 */
+        n = (ex_random() ^ (ex_random() << 24)) >> (k % 33U == 32U ? 31U : k % 33U);
+        if ((xf_am_clz_u32_sw(n) != bitops_ref_clz(n))
+                || (xf_am_ctz_u32_sw(n) != ((n != 0U) ? (31U - bitops_ref_clz(n & (0U - n))) : 32U))
+                || (xf_am_reverse_u32_sw(n) != bitops_ref_reverse(n))
+                || (xf_am_swap_u32_sw(n) != ((n >> 24) | ((n >> 8) & 0xFF00U)
+                                             | ((n << 8) & 0xFF0000U) | (n << 24)))) {
+            if (fails++ < 8U) {
+                XF_LOGE(TAG, "reference mismatch: 0x%08x", (unsigned int)n);
+            }
+        }
+    }
+    XF_LOGI(TAG, "reference: %u iterations, %u failures", (unsigned int)BITOPS_RANDOM_ITER, (unsigned int)fails);
+
+    fails = 0;
+    for (k = 0; k < BITOPS_RANDOM_ITER; k++) {
+        uint64_t x = ((uint64_t)(ex_random() ^ (ex_random() << 24)) << 32) | (ex_random() ^ (ex_random() << 24));
+        x >>= k % 65U == 64U ? 63U : k % 65U;
+        if (bitops_check_u64(x) != 0U) {
+            if (fails++ < 8U) {
+                XF_LOGE(TAG, "u64 mismatch: 0x%016llx", (unsigned long long)x);
+            }
+        }
+    }
+    fails += bitops_check_u64(0) + bitops_check_u64(~(uint64_t)0) + bitops_check_u64(0x8000000000000001ULL);
+    XF_LOGI(TAG, "u64: %u iterations, %u failures", (unsigned int)BITOPS_RANDOM_ITER, (unsigned int)fails);
+
+#define BENCH_ONE(_name, _hw, _sw) \
+    do { \
+        t0 = bench_now_us(); \
+        for (k = 0; k < BITOPS_BENCH_ITER; k++) { sink += _hw(k * 2654435761U); } \
+        t_hw = bench_now_us() - t0; \
+        t0 = bench_now_us(); \
+        for (k = 0; k < BITOPS_BENCH_ITER; k++) { sink += _sw(k * 2654435761U); } \
+        t_sw = bench_now_us() - t0; \
+        XF_LOGI(TAG, "%-10s xf: %8u us, sw: %8u us", (_name), \
+                (unsigned int)t_hw, (unsigned int)t_sw); \
+    } while (0)
+
+    BENCH_ONE("clz", xf_am_clz_u32, xf_am_clz_u32_sw);
+    BENCH_ONE("ctz", xf_am_ctz_u32, xf_am_ctz_u32_sw);
+    BENCH_ONE("log2", xf_am_log2_u32, xf_am_log2_u32_sw);
+    BENCH_ONE("popcount", xf_am_popcount_u32, xf_am_popcount_u32_v2);
+    BENCH_ONE("swap", xf_am_swap_u32, xf_am_swap_u32_sw);
+    BENCH_ONE("reverse", xf_am_reverse_u32, xf_am_reverse_u32_sw);
+    BENCH_ONE("clp2", xf_am_clp2_u32, xf_am_clp2_u32_sw);
+
+#undef BENCH_ONE
+    UNUSED(sink);
+}
+
+#elif EXAMPLE == EXAMPLE_SYSTEM_PROF
+
+/* 需要 XF_PROF_ENABLE 为 1 */
+
+#define EVENT_ID_WORK                   1
+
+XF_TASK_FUNC(work_task);
+
+static void work_subscr_cb(xf_subscr_t *s, uint8_t ref_cnt, void *arg)
+{
+    volatile uint32_t i;
+    UNUSED(s);
+    UNUSED(ref_cnt);
+    for (i = 0; i < (uint32_t)(uintptr_t)arg; i++) {}
+}
+
+static void publish_timer_cb(xf_stimer_t *t)
+{
+    UNUSED(t);
+    xf_ps_publish(EVENT_ID_WORK, (void *)(uintptr_t)(ex_random() % 5000U));
+}
+
+static void report_timer_cb(xf_stimer_t *t)
+{
+    xf_prof_zone_t *zone = NULL;
+    xf_prof_stats_t stats;
+    UNUSED(t);
+    XF_LOGI(TAG, "%-18s %8s %8s %8s %8s", "zone", "count", "min", "avg", "max");
+    while ((zone = xf_prof_iter_next(zone)) != NULL) {
+        xf_prof_get_stats(zone, &stats);
+        XF_LOGI(TAG, "%-18s %8u %8u %8u %8u", zone->name, (unsigned int)stats.count,
+                (unsigned int)stats.min, (unsigned int)stats.avg, (unsigned int)stats.max);
+    }
+    xf_prof_reset(NULL);
+}
+
+void test_main(void)
+{
+    xf_tick_t delay_tick;
+    xf_prof_init();
+    xf_ps_init();
+    xf_task_sched_init();
+    xf_subscribe(EVENT_ID_WORK, work_subscr_cb, 0);
+    xf_stimer_create(10U, (xf_stimer_cb_t)publish_timer_cb, NULL);
+    xf_stimer_create(1000U, (xf_stimer_cb_t)report_timer_cb, NULL);
+    xf_task_create(work_task, NULL);
+
+    while (1) {
+        delay_tick = xf_stimer_handler();
+        xf_dispatch();
+        if (delay_tick != 0) {
+            osDelayMs(delay_tick);
+            (void)xf_tick_inc(delay_tick);
+        }
+    }
+}
+
+XF_TASK_FUNC(work_task)
+{
+    volatile uint32_t i;
+    xf_task_begin(me);
+    while (1) {
+        /* 自定义区段 */
+        XF_PROF_ZONE_BEGIN(work_task_body);
+        for (i = 0; i < 20000U; i++) {}
+        XF_PROF_ZONE_END(work_task_body);
+        xf_task_delay_ms(me, 20);
+    }
+    xf_task_end(me);
+}
+
 #endif
 
 /* ==================== [Static Functions] ================================== */
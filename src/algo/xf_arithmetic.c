@@ -28,7 +28,7 @@
 
 /* ==================== [Global Functions] ================================== */
 
-uint32_t xf_am_log2_u32(uint32_t n)
+uint32_t xf_am_log2_u32_sw(uint32_t n)
 {
     uint32_t result = 0;
 /* *INDENT-OFF* */
@@ -65,15 +65,9 @@ uint32_t xf_am_popcount_u32_v2(uint32_t n)
 }
 #endif
 
-uint32_t xf_am_clz_u32(uint32_t n)
+uint32_t xf_am_clz_u32_sw(uint32_t n)
 {
-#if XF_COMMON_ENABLE_GNU /* (__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 5) */
-    if (!n) {
-        return 32;
-    }
-    return __builtin_clz(n);
-#else
-    int result = 0;
+    uint32_t result = 0;
     if (n == 0) {
         return 32;
     }
@@ -85,22 +79,14 @@ uint32_t xf_am_clz_u32(uint32_t n)
    if (n <= 0x7FFFFFFF) { result = result +  1;              }
 /* *INDENT-ON* */
     return result;
-#endif
-/* *INDENT-ON* */
 }
 
-uint32_t xf_am_ctz_u32(uint32_t n)
+uint32_t xf_am_ctz_u32_sw(uint32_t n)
 {
-#if XF_COMMON_ENABLE_GNU /* (__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 5) */
-    if (!n) {
-        return 32;
-    }
-    return __builtin_ctz(n);
-#else
+    uint32_t tmp = 1;
     if (n == 0) {
         return 32;
     }
-    int tmp = 1;
 /* *INDENT-OFF* */
    if ((n & 0x0000FFFF) == 0) { tmp = tmp + 16; n = n >> 16; }
    if ((n & 0x000000FF) == 0) { tmp = tmp +  8; n = n >>  8; }
@@ -108,23 +94,16 @@ uint32_t xf_am_ctz_u32(uint32_t n)
    if ((n & 0x00000003) == 0) { tmp = tmp +  2; n = n >>  2; }
 /* *INDENT-ON* */
     return tmp - (n & 1);
-#endif
-/* *INDENT-ON* */
 }
 
-uint32_t xf_am_swap_u32(uint32_t n)
+uint32_t xf_am_swap_u32_sw(uint32_t n)
 {
-#if XF_COMMON_ENABLE_GNU /* (__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 5) */
-    return __builtin_bswap32(n);
-#else
-    n = ((n & 0xF0F0F0F0) >> 4) | ((n & 0x0F0F0F0F) << 4);
-    n = ((n & 0xCCCCCCCC) >> 2) | ((n & 0x33333333) << 2);
-    n = ((n & 0xAAAAAAAA) >> 1) | ((n & 0x55555555) << 1);
+    n = ((n & 0x00FF00FF) <<  8) | ((n & 0xFF00FF00) >>  8);
+    n = ((n & 0x0000FFFF) << 16) | ((n & 0xFFFF0000) >> 16);
     return n;
-#endif
 }
 
-uint32_t xf_am_reverse_u32(uint32_t n)
+uint32_t xf_am_reverse_u32_sw(uint32_t n)
 {
     n = ((n & 0x55555555) <<  1) | ((n & 0xAAAAAAAA) >>  1);
     n = ((n & 0x33333333) <<  2) | ((n & 0xCCCCCCCC) >>  2);
@@ -134,7 +113,7 @@ uint32_t xf_am_reverse_u32(uint32_t n)
     return n;
 }
 
-uint32_t xf_am_flp2_u32(uint32_t n)
+uint32_t xf_am_flp2_u32_sw(uint32_t n)
 {
     n = n | (n >> 1);
     n = n | (n >> 2);
@@ -144,7 +123,7 @@ uint32_t xf_am_flp2_u32(uint32_t n)
     return n - (n >> 1);
 }
 
-uint32_t xf_am_clp2_u32(uint32_t n)
+uint32_t xf_am_clp2_u32_sw(uint32_t n)
 {
     n = n - 1;
     n = n | (n >> 1);
@@ -156,7 +135,7 @@ uint32_t xf_am_clp2_u32(uint32_t n)
 }
 
 #if XF_COMMON_ENABLE_64BITS
-uint32_t xf_am_clz_u64(uint64_t x)
+uint32_t xf_am_clz_u64_sw(uint64_t x)
 {
 /* *INDENT-OFF* */
     uint32_t n = 0U;
@@ -32,8 +32,55 @@ extern "C" {
           | BIT(XF_AM_POPCOUNT_U32_V1) \
           | BIT(XF_AM_POPCOUNT_U32_V2))
 
+/*
+    位运算后端，编译时按目标选择，选不到时使用 xf_arithmetic.c 中的可移植实现 (*_sw).
+    XF_AM_BUILTIN_CLZ:      clz/ctz/log2/flp2/clp2 使用 __builtin_clz/ctz,
+                            仅在目标有对应指令时启用（x86 BSR/BSF/LZCNT/TZCNT,
+                            ARM CLZ(+RBIT), RISC-V Zbb），否则 libgcc 的软件实现不比查表快。
+    XF_AM_BUILTIN_POPCOUNT: 仅在目标有 POPCNT/CNT/CPOP 指令时启用，否则使用 V2.
+    XF_AM_BUILTIN_BSWAP:    __builtin_bswap32, 编译器总能展开为 REV/BSWAP 或移位组合。
+    XF_AM_BUILTIN_REVERSE:  1: clang __builtin_bitreverse32; 2: ARM/AArch64 RBIT 指令;
+                            0: 有 bswap 时先按字节翻转再翻转字节内的位，否则 *_sw.
+ */
+#if XF_COMMON_ENABLE_BUILTIN && defined(__GNUC__)
+#   define XF_AM_BUILTIN_BSWAP          1
+#   if defined(__i386__) || defined(__x86_64__) || defined(__aarch64__) \
+            || defined(__ARM_FEATURE_CLZ) || defined(__riscv_zbb)
+#       define XF_AM_BUILTIN_CLZ        1
+#   endif
+#   if defined(__POPCNT__) || defined(__aarch64__) || defined(__riscv_zbb)
+#       define XF_AM_BUILTIN_POPCOUNT   1
+#   endif
+#   if defined(__has_builtin)
+#       if __has_builtin(__builtin_bitreverse32)
+#           define XF_AM_BUILTIN_REVERSE    1
+#       endif
+#   endif
+#   if !defined(XF_AM_BUILTIN_REVERSE) && (defined(__aarch64__) \
+            || (defined(__ARM_ARCH) && (__ARM_ARCH >= 7) \
+                && (defined(__ARM_ARCH_ISA_ARM) || (__ARM_ARCH_ISA_THUMB == 2))))
+#       define XF_AM_BUILTIN_REVERSE    2
+#   endif
+#endif
+#if !defined(XF_AM_BUILTIN_BSWAP)
+#   define XF_AM_BUILTIN_BSWAP          0
+#endif
+#if !defined(XF_AM_BUILTIN_CLZ)
+#   define XF_AM_BUILTIN_CLZ            0
+#endif
+#if !defined(XF_AM_BUILTIN_POPCOUNT)
+#   define XF_AM_BUILTIN_POPCOUNT       0
+#endif
+#if !defined(XF_AM_BUILTIN_REVERSE)
+#   define XF_AM_BUILTIN_REVERSE        0
+#endif
+
 #if !defined(XF_AM_POPCOUNT_U32_DEFAULT)
-#define XF_AM_POPCOUNT_U32_DEFAULT  XF_AM_POPCOUNT_U32_V2
+#   if XF_AM_BUILTIN_POPCOUNT
+#       define XF_AM_POPCOUNT_U32_DEFAULT  XF_AM_POPCOUNT_U32_GUN
+#   else
+#       define XF_AM_POPCOUNT_U32_DEFAULT  XF_AM_POPCOUNT_U32_V2
+#   endif
 #endif
 
 /* ==================== [Typedefs] ========================================== */
@@ -49,7 +96,50 @@ __STATIC_INLINE uint32_t xf_am_popcount_u32_gnu(uint32_t n)
 uint32_t xf_am_popcount_u32_v1(uint32_t n);
 uint32_t xf_am_popcount_u32_v2(uint32_t n);
 
-uint32_t xf_am_log2_u32(uint32_t n);
+/* 可移植实现，供没有对应指令的目标使用，也作为校验的参照 */
+uint32_t xf_am_log2_u32_sw(uint32_t n);
+uint32_t xf_am_clz_u32_sw(uint32_t n);
+uint32_t xf_am_ctz_u32_sw(uint32_t n);
+uint32_t xf_am_swap_u32_sw(uint32_t n);
+uint32_t xf_am_reverse_u32_sw(uint32_t n);
+uint32_t xf_am_flp2_u32_sw(uint32_t n);
+uint32_t xf_am_clp2_u32_sw(uint32_t n);
+
+/**
+ * @brief 前导 0 的个数. n 为 0 时返回 32.
+ */
+__STATIC_INLINE uint32_t xf_am_clz_u32(uint32_t n)
+{
+#if XF_AM_BUILTIN_CLZ
+    return (n != 0U) ? (uint32_t)__builtin_clz(n) : 32U;
+#else
+    return xf_am_clz_u32_sw(n);
+#endif
+}
+
+/**
+ * @brief 末尾 0 的个数. n 为 0 时返回 32.
+ */
+__STATIC_INLINE uint32_t xf_am_ctz_u32(uint32_t n)
+{
+#if XF_AM_BUILTIN_CLZ
+    return (n != 0U) ? (uint32_t)__builtin_ctz(n) : 32U;
+#else
+    return xf_am_ctz_u32_sw(n);
+#endif
+}
+
+/**
+ * @brief 向下取整的 log2. n 为 0 时返回 0.
+ */
+__STATIC_INLINE uint32_t xf_am_log2_u32(uint32_t n)
+{
+#if XF_AM_BUILTIN_CLZ
+    return (n != 0U) ? (31U - (uint32_t)__builtin_clz(n)) : 0U;
+#else
+    return xf_am_log2_u32_sw(n);
+#endif
+}
 
 /**
  * @brief 计算位元 1 的个数。(population count, 种群计数)
@@ -68,13 +158,48 @@ __STATIC_INLINE uint32_t xf_am_popcount_u32(uint32_t n)
 #endif
 }
 
-uint32_t xf_am_swap_u32(uint32_t n);
-uint32_t xf_am_reverse_u32(uint32_t n);
+/**
+ * @brief 字节序翻转.
+ */
+__STATIC_INLINE uint32_t xf_am_swap_u32(uint32_t n)
+{
+#if XF_AM_BUILTIN_BSWAP
+    return __builtin_bswap32(n);
+#else
+    return xf_am_swap_u32_sw(n);
+#endif
+}
 
-uint32_t xf_am_clz_u32(uint32_t n);
-uint32_t xf_am_ctz_u32(uint32_t n);
+/**
+ * @brief 位序翻转，第 0 位与第 31 位交换，以此类推.
+ */
+__STATIC_INLINE uint32_t xf_am_reverse_u32(uint32_t n)
+{
+#if XF_AM_BUILTIN_REVERSE == 1
+    return __builtin_bitreverse32(n);
+#elif (XF_AM_BUILTIN_REVERSE == 2) && defined(__aarch64__)
+    uint32_t r;
+    __asm__("rbit %w0, %w1" : "=r"(r) : "r"(n));
+    return r;
+#elif XF_AM_BUILTIN_REVERSE == 2
+    uint32_t r;
+    __asm__("rbit %0, %1" : "=r"(r) : "r"(n));
+    return r;
+#elif XF_AM_BUILTIN_BSWAP
+    n = __builtin_bswap32(n);
+    n = ((n & 0x0F0F0F0FU) << 4) | ((n & 0xF0F0F0F0U) >> 4);
+    n = ((n & 0x33333333U) << 2) | ((n & 0xCCCCCCCCU) >> 2);
+    n = ((n & 0x55555555U) << 1) | ((n & 0xAAAAAAAAU) >> 1);
+    return n;
+#else
+    return xf_am_reverse_u32_sw(n);
+#endif
+}
 
-#define xf_am_fls_u32(_n)               (32U - xf_am_clz_u32(x))
+/**
+ * @brief 最高位 1 的位置加 1 (find last set). n 为 0 时返回 0.
+ */
+#define xf_am_fls_u32(_n)               (32U - xf_am_clz_u32(_n))
 
 /**
  * @brief 向下取整到 2 的幂。(floor power of 2)
@@ -84,7 +209,14 @@ uint32_t xf_am_ctz_u32(uint32_t n);
  * @param n
  * @return uint32_t
  */
-uint32_t xf_am_flp2_u32(uint32_t n);
+__STATIC_INLINE uint32_t xf_am_flp2_u32(uint32_t n)
+{
+#if XF_AM_BUILTIN_CLZ
+    return (n != 0U) ? (0x80000000U >> __builtin_clz(n)) : 0U;
+#else
+    return xf_am_flp2_u32_sw(n);
+#endif
+}
 __STATIC_INLINE uint32_t xf_am_round_down_to_power_of_2_u32(uint32_t n)
 {
     return xf_am_flp2_u32(n);
@@ -93,19 +225,142 @@ __STATIC_INLINE uint32_t xf_am_round_down_to_power_of_2_u32(uint32_t n)
 /**
  * @brief 向上对齐到 2 的幂。(ceiling power of 2)
  *
- * 获取大于等于 n 且最接近 n 的 2 的整数幂。
+ * 获取大于等于 n 且最接近 n 的 2 的整数幂。n 为 0 或结果超出 32 位时返回 0.
  *
  * @param n
  * @return uint32_t
  */
-uint32_t xf_am_clp2_u32(uint32_t n);
+__STATIC_INLINE uint32_t xf_am_clp2_u32(uint32_t n)
+{
+#if XF_AM_BUILTIN_CLZ
+    if (n <= 1U) {
+        return n;
+    }
+    return (n > 0x80000000U) ? 0U : (1U << (32U - (uint32_t)__builtin_clz(n - 1U)));
+#else
+    return xf_am_clp2_u32_sw(n);
+#endif
+}
 __STATIC_INLINE uint32_t xf_am_round_up_to_power_of_2_u32(uint32_t n)
 {
     return xf_am_clp2_u32(n);
 }
 
 #if XF_COMMON_ENABLE_64BITS
-uint32_t xf_am_clz_u64(uint64_t x);
+
+/*
+    64 位版本。64 位目标直接使用 64 位内建函数；
+    32 位目标由两个 32 位版本拼成，避免调用 libgcc 的 __clzdi2 等函数。
+ */
+#if defined(UINTPTR_MAX) && (UINTPTR_MAX > 0xFFFFFFFFU)
+#   define XF_AM_NATIVE_U64             1
+#else
+#   define XF_AM_NATIVE_U64             0
+#endif
+
+#define XF_AM_U64_HI(_x)                ((uint32_t)((uint64_t)(_x) >> 32))
+#define XF_AM_U64_LO(_x)                ((uint32_t)(_x))
+
+uint32_t xf_am_clz_u64_sw(uint64_t x);
+
+/**
+ * @brief 前导 0 的个数. x 为 0 时返回 64.
+ */
+__STATIC_INLINE uint32_t xf_am_clz_u64(uint64_t x)
+{
+#if XF_AM_BUILTIN_CLZ && XF_AM_NATIVE_U64
+    return (x != 0U) ? (uint32_t)__builtin_clzll(x) : 64U;
+#else
+    return (XF_AM_U64_HI(x) != 0U) ? xf_am_clz_u32(XF_AM_U64_HI(x))
+           : (32U + xf_am_clz_u32(XF_AM_U64_LO(x)));
+#endif
+}
+
+/**
+ * @brief 末尾 0 的个数. x 为 0 时返回 64.
+ */
+__STATIC_INLINE uint32_t xf_am_ctz_u64(uint64_t x)
+{
+#if XF_AM_BUILTIN_CLZ && XF_AM_NATIVE_U64
+    return (x != 0U) ? (uint32_t)__builtin_ctzll(x) : 64U;
+#else
+    return (XF_AM_U64_LO(x) != 0U) ? xf_am_ctz_u32(XF_AM_U64_LO(x))
+           : (32U + xf_am_ctz_u32(XF_AM_U64_HI(x)));
+#endif
+}
+
+/**
+ * @brief 计算位元 1 的个数.
+ */
+__STATIC_INLINE uint32_t xf_am_popcount_u64(uint64_t x)
+{
+#if XF_AM_BUILTIN_POPCOUNT && XF_AM_NATIVE_U64
+    return (uint32_t)__builtin_popcountll(x);
+#else
+    return xf_am_popcount_u32(XF_AM_U64_LO(x)) + xf_am_popcount_u32(XF_AM_U64_HI(x));
+#endif
+}
+
+/**
+ * @brief 向下取整的 log2. x 为 0 时返回 0.
+ */
+__STATIC_INLINE uint32_t xf_am_log2_u64(uint64_t x)
+{
+    return (x != 0U) ? (63U - xf_am_clz_u64(x)) : 0U;
+}
+
+/**
+ * @brief 字节序翻转.
+ */
+__STATIC_INLINE uint64_t xf_am_swap_u64(uint64_t x)
+{
+#if XF_AM_BUILTIN_BSWAP
+    return __builtin_bswap64(x);
+#else
+    return ((uint64_t)xf_am_swap_u32(XF_AM_U64_LO(x)) << 32) | xf_am_swap_u32(XF_AM_U64_HI(x));
+#endif
+}
+
+/**
+ * @brief 位序翻转，第 0 位与第 63 位交换，以此类推.
+ */
+__STATIC_INLINE uint64_t xf_am_reverse_u64(uint64_t x)
+{
+#if XF_AM_BUILTIN_REVERSE == 1
+    return __builtin_bitreverse64(x);
+#elif (XF_AM_BUILTIN_REVERSE == 2) && defined(__aarch64__)
+    uint64_t r;
+    __asm__("rbit %0, %1" : "=r"(r) : "r"(x));
+    return r;
+#else
+    return ((uint64_t)xf_am_reverse_u32(XF_AM_U64_LO(x)) << 32) | xf_am_reverse_u32(XF_AM_U64_HI(x));
+#endif
+}
+
+/**
+ * @brief 向下取整到 2 的幂. x 为 0 时返回 0.
+ */
+__STATIC_INLINE uint64_t xf_am_flp2_u64(uint64_t x)
+{
+    return (x != 0U) ? ((uint64_t)1 << (63U - xf_am_clz_u64(x))) : 0U;
+}
+
+/**
+ * @brief 向上对齐到 2 的幂. x 为 0 或结果超出 64 位时返回 0.
+ */
+__STATIC_INLINE uint64_t xf_am_clp2_u64(uint64_t x)
+{
+    if (x <= 1U) {
+        return x;
+    }
+    return (x > 0x8000000000000000ULL) ? 0U : ((uint64_t)1 << (64U - xf_am_clz_u64(x - 1U)));
+}
+
+/**
+ * @brief 最高位 1 的位置加 1. x 为 0 时返回 0.
+ */
+#define xf_am_fls_u64(_x)               (64U - xf_am_clz_u64(_x))
+
 #endif /* XF_COMMON_ENABLE_64BITS */
 
 /* ==================== [Macros] ============================================ */
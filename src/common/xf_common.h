@@ -35,6 +35,22 @@ extern "C" {
 
 /* ==================== [Macros] ============================================ */
 
+/*
+    临界区，由移植层（xf_porting.h）定义，未定义时为空操作。
+    放在 common 中，各层（包括 dstruct）都可以直接使用。
+ */
+#if !defined(XF_CRIT_STAT)
+#   define XF_CRIT_STAT()               ((void)0)
+#endif
+
+#if !defined(XF_CRIT_ENTRY)
+#   define XF_CRIT_ENTRY()              ((void)0)
+#endif
+
+#if !defined(XF_CRIT_EXIT)
+#   define XF_CRIT_EXIT()               ((void)0)
+#endif
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
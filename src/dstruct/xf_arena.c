@@ -0,0 +1,153 @@
+/**
+ * @file xf_arena.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 区域（arena）分配器。
+ * @version 1.0
+ * @date 2025-07-10
+ *
+ * SPDX-FileCopyrightText: 2025 CompanyNameMagicTag
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_arena.h"
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+/* ==================== [Static Variables] ================================== */
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+xf_err_t xf_arena_init(xf_arena_t *p_arena, void *p_buf, size_t size)
+{
+    if ((p_arena == NULL) || (p_buf == NULL) || (size == 0)) {
+        return XF_ERR_INVALID_ARG;
+    }
+    p_arena->p_buf = (uint8_t *)p_buf;
+    p_arena->size = size;
+    p_arena->used = 0;
+    p_arena->used_max = 0;
+    p_arena->p_next = NULL;
+    p_arena->p_cur = p_arena;
+    return XF_OK;
+}
+
+xf_err_t xf_arena_chain(xf_arena_t *p_arena, xf_arena_t *p_overflow)
+{
+    xf_arena_t *p_tail;
+    if ((p_arena == NULL) || (p_overflow == NULL) || (p_overflow->p_next != NULL)) {
+        return XF_ERR_INVALID_ARG;
+    }
+    for (p_tail = p_arena; ; p_tail = p_tail->p_next) {
+        if (p_tail == p_overflow) {
+            return XF_ERR_INVALID_ARG;
+        }
+        if (p_tail->p_next == NULL) {
+            break;
+        }
+    }
+    p_overflow->used = 0;
+    p_tail->p_next = p_overflow;
+    return XF_OK;
+}
+
+void *xf_arena_alloc(xf_arena_t *p_arena, size_t size)
+{
+    return xf_arena_alloc_aligned(p_arena, size, XF_ARENA_ALIGN_DEFAULT);
+}
+
+void *xf_arena_alloc_aligned(xf_arena_t *p_arena, size_t size, size_t align)
+{
+    xf_arena_t *p_region;
+    if ((p_arena == NULL) || (size == 0)
+            || (align == 0) || ((align & (align - 1U)) != 0)) {
+        return NULL;
+    }
+    /* 从当前区域往后找，不回到前面的区域，保证标记之后的分配都在标记位置之后 */
+    for (p_region = p_arena->p_cur; p_region != NULL; p_region = p_region->p_next) {
+        uintptr_t base = (uintptr_t)p_region->p_buf;
+        size_t offset = (size_t)((((base + p_region->used) + (align - 1U)) & ~(uintptr_t)(align - 1U)) - base);
+        if ((offset <= p_region->size) && (size <= (p_region->size - offset))) {
+            p_region->used = offset + size;
+            if (p_region->used > p_region->used_max) {
+                p_region->used_max = p_region->used;
+            }
+            p_arena->p_cur = p_region;
+            return &p_region->p_buf[offset];
+        }
+    }
+    return NULL;
+}
+
+xf_arena_mark_t xf_arena_mark(const xf_arena_t *p_arena)
+{
+    xf_arena_mark_t mark = {NULL, 0};
+    if (p_arena != NULL) {
+        mark.p_region = p_arena->p_cur;
+        mark.used = p_arena->p_cur->used;
+    }
+    return mark;
+}
+
+xf_err_t xf_arena_reset_to(xf_arena_t *p_arena, const xf_arena_mark_t *p_mark)
+{
+    xf_arena_t *p_region;
+    /* xf_arena_mark(NULL) 返回的空标记不属于任何区域 */
+    if ((p_arena == NULL) || (p_mark == NULL) || (p_mark->p_region == NULL)) {
+        return XF_ERR_INVALID_ARG;
+    }
+    /* 通常没有溢出区，第一次比较就命中 */
+    for (p_region = p_arena; p_region != p_mark->p_region; p_region = p_region->p_next) {
+        if (p_region == NULL) {
+            return XF_ERR_INVALID_ARG;
+        }
+    }
+    if (p_mark->used > p_region->used) {
+        return XF_ERR_INVALID_ARG;
+    }
+    p_region->used = p_mark->used;
+    p_arena->p_cur = p_region;
+    for (p_region = p_region->p_next; p_region != NULL; p_region = p_region->p_next) {
+        p_region->used = 0;
+    }
+    return XF_OK;
+}
+
+xf_err_t xf_arena_reset(xf_arena_t *p_arena)
+{
+    xf_arena_mark_t mark;
+    if (p_arena == NULL) {
+        return XF_ERR_INVALID_ARG;
+    }
+    mark.p_region = p_arena;
+    mark.used = 0;
+    return xf_arena_reset_to(p_arena, &mark);
+}
+
+size_t xf_arena_get_used(const xf_arena_t *p_arena)
+{
+    size_t used = 0;
+    for (; p_arena != NULL; p_arena = p_arena->p_next) {
+        used += p_arena->used;
+    }
+    return used;
+}
+
+size_t xf_arena_get_used_max(const xf_arena_t *p_arena)
+{
+    size_t used_max = 0;
+    for (; p_arena != NULL; p_arena = p_arena->p_next) {
+        used_max += p_arena->used_max;
+    }
+    return used_max;
+}
+
+/* ==================== [Static Functions] ================================== */
@@ -0,0 +1,168 @@
+/**
+ * @file xf_arena.h
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 区域（arena）分配器。
+ * @version 1.0
+ * @date 2025-07-10
+ *
+ * SPDX-FileCopyrightText: 2025 CompanyNameMagicTag
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+/*
+    NOTE 区域分配器原理
+
+    1.  在使用者提供的缓冲区上顺序（bump）分配，不能单独释放，
+        只能用 xf_arena_reset / xf_arena_reset_to 一次性回退到某个标记，
+        回退是 O(1) 的（只改已用字节数）。
+    1.  本区放不下时，依次使用 xf_arena_chain 挂上的溢出区；
+        此后一直从溢出区分配，直到回退到本区的标记，保证标记后的分配都被回退。
+    1.  适合“处理一条消息时临时构造若干对象，处理完全部丢弃”的场景，
+        见 xf_ps_set_dispatch_arena() 与 xf_task_set_scratch_arena().
+    1.  本身不加锁，一个 arena 只应由一个上下文使用。
+ */
+
+#ifndef __XF_ARENA_H__
+#define __XF_ARENA_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "../common/xf_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/**
+ * @brief xf_arena_alloc() 的对齐字节数.
+ */
+#define XF_ARENA_ALIGN_DEFAULT          (sizeof(void *))
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief 区域.
+ */
+typedef struct xf_arena {
+    uint8_t                *p_buf;          /*!< 缓冲区 */
+    size_t                  size;           /*!< 缓冲区大小（字节） */
+    size_t                  used;           /*!< 已用字节数 */
+    size_t                  used_max;       /*!< 已用字节数的历史最大值 */
+    struct xf_arena        *p_next;         /*!< 溢出区 */
+    struct xf_arena        *p_cur;          /*!< 当前分配的区域，仅链表头有效 */
+} xf_arena_t;
+
+/**
+ * @brief 分配位置的标记，见 xf_arena_mark().
+ */
+typedef struct xf_arena_mark {
+    xf_arena_t             *p_region;       /*!< 标记时正在分配的区域 */
+    size_t                  used;           /*!< 标记时该区域的已用字节数 */
+} xf_arena_mark_t;
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief 初始化区域.
+ *
+ * @param p_arena   区域。
+ * @param p_buf     缓冲区。
+ * @param size      缓冲区大小（字节）。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    参数无效
+ */
+xf_err_t xf_arena_init(xf_arena_t *p_arena, void *p_buf, size_t size);
+
+/**
+ * @brief 在链表末尾挂上溢出区.
+ *
+ * @param p_arena       链表头。
+ * @param p_overflow    已初始化的溢出区，此后只能通过 p_arena 使用。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    参数无效，或 p_overflow 已在链表中
+ */
+xf_err_t xf_arena_chain(xf_arena_t *p_arena, xf_arena_t *p_overflow);
+
+/**
+ * @brief 按 XF_ARENA_ALIGN_DEFAULT 对齐分配.
+ *
+ * @return void*    内存地址，空间不足或 size 为 0 时返回 NULL.
+ */
+void *xf_arena_alloc(xf_arena_t *p_arena, size_t size);
+
+/**
+ * @brief 按指定对齐分配.
+ *
+ * @param align     对齐字节数，2 的幂。
+ * @return void*    内存地址，空间不足、size 为 0 或 align 无效时返回 NULL.
+ */
+void *xf_arena_alloc_aligned(xf_arena_t *p_arena, size_t size, size_t align);
+
+/**
+ * @brief 获取当前分配位置.
+ *
+ * @param p_arena   区域，为 NULL 时返回空标记。
+ */
+xf_arena_mark_t xf_arena_mark(const xf_arena_t *p_arena);
+
+/**
+ * @brief 回退到标记处，标记之后分配的内存全部失效.
+ *
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    参数无效（包括空标记），或标记不属于该区域
+ */
+xf_err_t xf_arena_reset_to(xf_arena_t *p_arena, const xf_arena_mark_t *p_mark);
+
+/**
+ * @brief 回退到初始状态，包括所有溢出区.
+ */
+xf_err_t xf_arena_reset(xf_arena_t *p_arena);
+
+/**
+ * @brief 获取已用字节数（含对齐填充及所有溢出区）.
+ */
+size_t xf_arena_get_used(const xf_arena_t *p_arena);
+
+/**
+ * @brief 获取各区域已用字节数历史最大值之和，不小于实际峰值，用于确定缓冲区大小.
+ */
+size_t xf_arena_get_used_max(const xf_arena_t *p_arena);
+
+/* ==================== [Macros] ============================================ */
+
+/**
+ * @brief 按类型分配.
+ */
+#define xf_arena_new(_p_arena, _type)   ((_type *)xf_arena_alloc((_p_arena), sizeof(_type)))
+
+/**
+ * @brief 作用域：XF_ARENA_SCOPE_BEGIN 与 XF_ARENA_SCOPE_END 之间分配的内存在 END 处全部回退.
+ *
+ * 两者必须在同一函数内成对使用，中间不能 return.
+ *
+ * @code{c}
+ * XF_ARENA_SCOPE_BEGIN(&arena);
+ * msg = xf_arena_new(&arena, my_msg_t);
+ * ...
+ * XF_ARENA_SCOPE_END(&arena);
+ * @endcode
+ */
+#define XF_ARENA_SCOPE_BEGIN(_p_arena) \
+    do { \
+        xf_arena_mark_t _xf_arena_scope_mark = xf_arena_mark(_p_arena)
+
+#define XF_ARENA_SCOPE_END(_p_arena) \
+        (void)xf_arena_reset_to((_p_arena), &_xf_arena_scope_mark); \
+    } while (0)
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* __XF_ARENA_H__ */
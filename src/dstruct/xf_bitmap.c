@@ -19,19 +19,471 @@
 #define FIND_SET    0
 #define FIND_ZERO   1
 
+/*
+    块内查找，参数不能为 0.
+    CTZ: 最低的 1 的位置; FLS: 最高的 1 的位置.
+    XF_COMMON_ENABLE_BUILTIN 时使用编译器内建函数（通常为单条指令），
+    否则使用 de Bruijn 乘法查表，64 位由两个 32 位拼成。
+ */
+#if XF_COMMON_ENABLE_BUILTIN
+#   define XF_BITMAP_CTZ32(_x)          ((uint32_t)__builtin_ctzl((unsigned long)(_x)))
+#   define XF_BITMAP_FLS32(_x)          ((uint32_t)(sizeof(unsigned long) * 8U - 1U) \
+                                            - (uint32_t)__builtin_clzl((unsigned long)(_x)))
+#   define XF_BITMAP_CTZ64(_x)          ((uint32_t)__builtin_ctzll((unsigned long long)(_x)))
+#   define XF_BITMAP_FLS64(_x)          (63U - (uint32_t)__builtin_clzll((unsigned long long)(_x)))
+#else
+#   define XF_BITMAP_CTZ32(_x)          xf_bitmap_ctz32((uint32_t)(_x))
+#   define XF_BITMAP_FLS32(_x)          xf_bitmap_fls32((uint32_t)(_x))
+#   define XF_BITMAP_CTZ64(_x)          xf_bitmap_ctz64((uint64_t)(_x))
+#   define XF_BITMAP_FLS64(_x)          xf_bitmap_fls64((uint64_t)(_x))
+#endif
+
+/*
+    XF_BITMAP_ENABLE_SIMD 时按编译目标选择向量指令集，
+    查找前先成块跳过全 0（ffs/fls）或全 1（ffz/flz）的区域；
+    XF_SIMD_WIDTH 为 0 表示不支持，逐块查找。
+ */
+#if XF_BITMAP_ENABLE_SIMD && defined(__AVX2__)
+#   include <immintrin.h>
+#   define XF_SIMD_WIDTH                32
+typedef __m256i xf_simd_t;
+#   define XF_SIMD_LOAD(p)              _mm256_loadu_si256((const __m256i *)(const void *)(p))
+#   define XF_SIMD_SET1(b)              _mm256_set1_epi8((char)(b))
+#   define XF_SIMD_EQUAL(a, b)          \
+        ((uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8((a), (b))) == 0xFFFFFFFFU)
+#elif XF_BITMAP_ENABLE_SIMD && defined(__SSE2__)
+#   include <emmintrin.h>
+#   define XF_SIMD_WIDTH                16
+typedef __m128i xf_simd_t;
+#   define XF_SIMD_LOAD(p)              _mm_loadu_si128((const __m128i *)(const void *)(p))
+#   define XF_SIMD_SET1(b)              _mm_set1_epi8((char)(b))
+#   define XF_SIMD_EQUAL(a, b)          \
+        ((uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8((a), (b))) == 0xFFFFU)
+#elif XF_BITMAP_ENABLE_SIMD && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#   include <arm_neon.h>
+#   define XF_SIMD_WIDTH                16
+typedef uint8x16_t xf_simd_t;
+#   define XF_SIMD_LOAD(p)              vld1q_u8((const uint8_t *)(p))
+#   define XF_SIMD_SET1(b)              vdupq_n_u8((uint8_t)(b))
+#   define XF_SIMD_EQUAL(a, b)          xf_simd_neon_equal((a), (b))
+#else
+#   define XF_SIMD_WIDTH                0
+#endif
+
+/*
+    原子操作（test_and_set / test_and_clear / ffz_claim）的比较交换。
+    XF_COMMON_ENABLE_BUILTIN 且编译器保证该宽度无锁时使用 __atomic 内建函数，
+    否则在临界区内比较交换（例如 Cortex-M0 没有独占访问指令）。
+ */
+#if XF_COMMON_ENABLE_BUILTIN && defined(__GCC_ATOMIC_INT_LOCK_FREE)
+#   define XF_BITMAP_ATOMIC8_LOCK_FREE  (__GCC_ATOMIC_CHAR_LOCK_FREE == 2)
+#   define XF_BITMAP_ATOMIC16_LOCK_FREE (__GCC_ATOMIC_SHORT_LOCK_FREE == 2)
+#   if defined(__SIZEOF_INT__) && (__SIZEOF_INT__ == 4)
+#       define XF_BITMAP_ATOMIC32_LOCK_FREE (__GCC_ATOMIC_INT_LOCK_FREE == 2)
+#   else
+#       define XF_BITMAP_ATOMIC32_LOCK_FREE (__GCC_ATOMIC_LONG_LOCK_FREE == 2)
+#   endif
+#   define XF_BITMAP_ATOMIC64_LOCK_FREE (__GCC_ATOMIC_LLONG_LOCK_FREE == 2)
+#else
+#   define XF_BITMAP_ATOMIC8_LOCK_FREE  0
+#   define XF_BITMAP_ATOMIC16_LOCK_FREE 0
+#   define XF_BITMAP_ATOMIC32_LOCK_FREE 0
+#   define XF_BITMAP_ATOMIC64_LOCK_FREE 0
+#endif
+
 /* ==================== [Typedefs] ========================================== */
 
 /* ==================== [Static Prototypes] ================================= */
 
+static int32_t xf_bitmap8_find_first(const xf_bitmap8_t *p_bm, uint32_t bit_size, int invert);
+static int32_t xf_bitmap8_find_last(const xf_bitmap8_t *p_bm, uint32_t bit_size, int invert);
+static int32_t xf_bitmap16_find_first(const xf_bitmap16_t *p_bm, uint32_t bit_size, int invert);
+static int32_t xf_bitmap16_find_last(const xf_bitmap16_t *p_bm, uint32_t bit_size, int invert);
 static int32_t xf_bitmap32_find_first(const xf_bitmap32_t *p_bm, uint32_t bit_size, int invert);
 static int32_t xf_bitmap32_find_last(const xf_bitmap32_t *p_bm, uint32_t bit_size, int invert);
+static int32_t xf_bitmap64_find_first(const xf_bitmap64_t *p_bm, uint32_t bit_size, int invert);
+static int32_t xf_bitmap64_find_last(const xf_bitmap64_t *p_bm, uint32_t bit_size, int invert);
+
+#if XF_SIMD_WIDTH
+static size_t xf_bitmap_skip_fwd(const void *p_mem, size_t size, uint8_t fill);
+static size_t xf_bitmap_skip_bwd(const void *p_mem, size_t size, uint8_t fill);
+#endif
+
+static bool_t xf_bitmap8_cas(volatile xf_bitmap8_t *p_blk, xf_bitmap8_t *p_old, xf_bitmap8_t new_val);
+static bool_t xf_bitmap16_cas(volatile xf_bitmap16_t *p_blk, xf_bitmap16_t *p_old, xf_bitmap16_t new_val);
+static bool_t xf_bitmap32_cas(volatile xf_bitmap32_t *p_blk, xf_bitmap32_t *p_old, xf_bitmap32_t new_val);
+static bool_t xf_bitmap64_cas(volatile xf_bitmap64_t *p_blk, xf_bitmap64_t *p_old, xf_bitmap64_t new_val);
+
+#if !XF_COMMON_ENABLE_BUILTIN
+static uint32_t xf_bitmap_ctz32(uint32_t x);
+static uint32_t xf_bitmap_fls32(uint32_t x);
+static uint32_t xf_bitmap_ctz64(uint64_t x);
+static uint32_t xf_bitmap_fls64(uint64_t x);
+#endif
 
 /* ==================== [Static Variables] ================================== */
 
+#if !XF_COMMON_ENABLE_BUILTIN
+/* (x & -x) * 0x077CB531 的高 5 位 -> 最低的 1 的位置 */
+static const uint8_t s_ctz32_debruijn[32] = {
+    0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+    31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9,
+};
+/* (最高的 1 及以下全部置 1) * 0x07C4ACDD 的高 5 位 -> 最高的 1 的位置 */
+static const uint8_t s_fls32_debruijn[32] = {
+    0, 9, 1, 10, 13, 21, 2, 29, 11, 14, 16, 18, 22, 25, 3, 30,
+    8, 12, 20, 28, 15, 17, 24, 7, 19, 27, 23, 6, 26, 5, 4, 31,
+};
+#endif
+
 /* ==================== [Macros] ============================================ */
 
+#if XF_SIMD_WIDTH
+/* 返回 [p_mem, p_mem + size) 开头（fwd）或末尾（bwd）连续等于 fill 的字节数，按向量宽度向下取整 */
+#   define XF_BITMAP_SKIP_FWD(_p_mem, _size, _fill)     xf_bitmap_skip_fwd((_p_mem), (_size), (_fill))
+#   define XF_BITMAP_SKIP_BWD(_p_mem, _size, _fill)     xf_bitmap_skip_bwd((_p_mem), (_size), (_fill))
+#else
+#   define XF_BITMAP_SKIP_FWD(_p_mem, _size, _fill)     ((void)(_p_mem), (void)(_size), (void)(_fill), (size_t)0)
+#   define XF_BITMAP_SKIP_BWD(_p_mem, _size, _fill)     ((void)(_p_mem), (void)(_size), (void)(_fill), (size_t)0)
+#endif
+
+/*
+    按块宽度 _n 生成 xf_bitmap<_n>_find_first / xf_bitmap<_n>_find_last.
+    invert 时按位取反后查找 1，即查找 0; 最后一个不完整块中超出 bit_size 的位被屏蔽。
+ */
+#define XF_BITMAP_DEFINE_FIND(_n, _ctz, _fls) \
+    static int32_t xf_bitmap##_n##_find_first(const xf_bitmap##_n##_t *p_bm, uint32_t bit_size, int invert) \
+    { \
+        uint32_t blk_num; \
+        uint32_t blk_idx; \
+        uint32_t valid_bit_num; \
+        xf_bitmap##_n##_t bm_blk; \
+        xf_bitmap##_n##_t inv_mask = invert ? (xf_bitmap##_n##_t)~(xf_bitmap##_n##_t)0 : 0; \
+        if ((!p_bm) || (!bit_size)) { \
+            return -1; \
+        } \
+        blk_num = bit_size / XF_BITMAP##_n##_BLK_BIT_SIZE; \
+        blk_idx = (uint32_t)(XF_BITMAP_SKIP_FWD(p_bm, blk_num * sizeof(xf_bitmap##_n##_t), (uint8_t)inv_mask) \
+                             / sizeof(xf_bitmap##_n##_t)); \
+        for (; blk_idx < blk_num; ++blk_idx) { \
+            bm_blk = (xf_bitmap##_n##_t)(p_bm[blk_idx] ^ inv_mask); \
+            if (bm_blk) { \
+                return (int32_t)(_ctz(bm_blk) + (blk_idx * XF_BITMAP##_n##_BLK_BIT_SIZE)); \
+            } \
+        } \
+        valid_bit_num = bit_size % XF_BITMAP##_n##_BLK_BIT_SIZE; \
+        if (valid_bit_num) { \
+            bm_blk = (xf_bitmap##_n##_t)(p_bm[blk_num] ^ inv_mask); \
+            bm_blk &= (xf_bitmap##_n##_t)(((xf_bitmap##_n##_t)1 << valid_bit_num) - 1U);  /*!< 屏蔽无效位 */ \
+            if (bm_blk) { \
+                return (int32_t)(_ctz(bm_blk) + (blk_num * XF_BITMAP##_n##_BLK_BIT_SIZE)); \
+            } \
+        } \
+        return -1; \
+    } \
+    \
+    static int32_t xf_bitmap##_n##_find_last(const xf_bitmap##_n##_t *p_bm, uint32_t bit_size, int invert) \
+    { \
+        uint32_t blk_idx; \
+        uint32_t valid_bit_num; \
+        xf_bitmap##_n##_t bm_blk; \
+        xf_bitmap##_n##_t inv_mask = invert ? (xf_bitmap##_n##_t)~(xf_bitmap##_n##_t)0 : 0; \
+        if ((!p_bm) || (!bit_size)) { \
+            return -1; \
+        } \
+        blk_idx = bit_size / XF_BITMAP##_n##_BLK_BIT_SIZE; \
+        valid_bit_num = bit_size % XF_BITMAP##_n##_BLK_BIT_SIZE; \
+        if (valid_bit_num) { \
+            bm_blk = (xf_bitmap##_n##_t)(p_bm[blk_idx] ^ inv_mask); \
+            bm_blk &= (xf_bitmap##_n##_t)(((xf_bitmap##_n##_t)1 << valid_bit_num) - 1U); \
+            if (bm_blk) { \
+                return (int32_t)(_fls(bm_blk) + (blk_idx * XF_BITMAP##_n##_BLK_BIT_SIZE)); \
+            } \
+        } \
+        blk_idx -= (uint32_t)(XF_BITMAP_SKIP_BWD(p_bm, blk_idx * sizeof(xf_bitmap##_n##_t), (uint8_t)inv_mask) \
+                              / sizeof(xf_bitmap##_n##_t)); \
+        while (blk_idx > 0) { \
+            --blk_idx; \
+            bm_blk = (xf_bitmap##_n##_t)(p_bm[blk_idx] ^ inv_mask); \
+            if (bm_blk) { \
+                return (int32_t)(_fls(bm_blk) + (blk_idx * XF_BITMAP##_n##_BLK_BIT_SIZE)); \
+            } \
+        } \
+        return -1; \
+    }
+
+/*
+    按块宽度 _n 生成批量操作: set_range, clear_range, popcount, and, or, andnot, iter_init, iter_next.
+    _popcnt 为单个块的 1 的个数, _ctz 同 XF_BITMAP_DEFINE_FIND.
+ */
+#define XF_BITMAP_BLK_ALL(_n)           ((xf_bitmap##_n##_t)~(xf_bitmap##_n##_t)0)
+
+#define XF_BITMAP_DEFINE_LOGIC(_n, _name, _expr) \
+    xf_err_t xf_bitmap##_n##_##_name(xf_bitmap##_n##_t *p_dst, \
+                                     const xf_bitmap##_n##_t *p_a, const xf_bitmap##_n##_t *p_b, uint32_t bit_size) \
+    { \
+        uint32_t blk_idx; \
+        uint32_t blk_num; \
+        if ((p_dst == NULL) || (p_a == NULL) || (p_b == NULL)) { \
+            return XF_ERR_INVALID_ARG; \
+        } \
+        blk_num = XF_BITMAP##_n##_GET_BLK_SIZE(bit_size); \
+        for (blk_idx = 0; blk_idx < blk_num; ++blk_idx) { \
+            p_dst[blk_idx] = (xf_bitmap##_n##_t)(_expr); \
+        } \
+        return XF_OK; \
+    }
+
+#define XF_BITMAP_DEFINE_BULK(_n, _ctz, _popcnt) \
+    static xf_err_t xf_bitmap##_n##_fill_range(xf_bitmap##_n##_t *p_bm, \
+                                               uint32_t bit_start, uint32_t bit_num, bool_t set) \
+    { \
+        uint32_t blk_idx; \
+        uint32_t blk_last; \
+        xf_bitmap##_n##_t mask_first; \
+        xf_bitmap##_n##_t mask_last; \
+        if ((p_bm == NULL) || ((bit_start + bit_num) < bit_start)) { \
+            return XF_ERR_INVALID_ARG; \
+        } \
+        if (bit_num == 0U) { \
+            return XF_OK; \
+        } \
+        blk_idx = bit_start / XF_BITMAP##_n##_BLK_BIT_SIZE; \
+        blk_last = (bit_start + bit_num - 1U) / XF_BITMAP##_n##_BLK_BIT_SIZE; \
+        mask_first = (xf_bitmap##_n##_t)(XF_BITMAP_BLK_ALL(_n) << (bit_start % XF_BITMAP##_n##_BLK_BIT_SIZE)); \
+        mask_last = (xf_bitmap##_n##_t)(XF_BITMAP_BLK_ALL(_n) \
+                    >> (XF_BITMAP##_n##_BLK_BIT_SIZE - 1U - ((bit_start + bit_num - 1U) % XF_BITMAP##_n##_BLK_BIT_SIZE))); \
+        if (blk_idx == blk_last) { \
+            mask_first &= mask_last; \
+        } \
+        p_bm[blk_idx] = set ? (xf_bitmap##_n##_t)(p_bm[blk_idx] | mask_first) \
+                        : (xf_bitmap##_n##_t)(p_bm[blk_idx] & ~mask_first); \
+        if (blk_idx == blk_last) { \
+            return XF_OK; \
+        } \
+        for (++blk_idx; blk_idx < blk_last; ++blk_idx) { \
+            p_bm[blk_idx] = set ? XF_BITMAP_BLK_ALL(_n) : 0U; \
+        } \
+        p_bm[blk_last] = set ? (xf_bitmap##_n##_t)(p_bm[blk_last] | mask_last) \
+                         : (xf_bitmap##_n##_t)(p_bm[blk_last] & ~mask_last); \
+        return XF_OK; \
+    } \
+    \
+    xf_err_t xf_bitmap##_n##_set_range(xf_bitmap##_n##_t *p_bm, uint32_t bit_start, uint32_t bit_num) \
+    { \
+        return xf_bitmap##_n##_fill_range(p_bm, bit_start, bit_num, TRUE); \
+    } \
+    \
+    xf_err_t xf_bitmap##_n##_clear_range(xf_bitmap##_n##_t *p_bm, uint32_t bit_start, uint32_t bit_num) \
+    { \
+        return xf_bitmap##_n##_fill_range(p_bm, bit_start, bit_num, FALSE); \
+    } \
+    \
+    uint32_t xf_bitmap##_n##_popcount(const xf_bitmap##_n##_t *p_bm, uint32_t bit_size) \
+    { \
+        uint32_t blk_idx; \
+        uint32_t blk_num; \
+        uint32_t valid_bit_num; \
+        uint32_t cnt = 0; \
+        if (p_bm == NULL) { \
+            return 0; \
+        } \
+        blk_num = bit_size / XF_BITMAP##_n##_BLK_BIT_SIZE; \
+        for (blk_idx = 0; blk_idx < blk_num; ++blk_idx) { \
+            cnt += _popcnt(p_bm[blk_idx]); \
+        } \
+        valid_bit_num = bit_size % XF_BITMAP##_n##_BLK_BIT_SIZE; \
+        if (valid_bit_num) { \
+            cnt += _popcnt(p_bm[blk_num] & (((xf_bitmap##_n##_t)1 << valid_bit_num) - 1U)); \
+        } \
+        return cnt; \
+    } \
+    \
+    XF_BITMAP_DEFINE_LOGIC(_n, and,     p_a[blk_idx] & p_b[blk_idx]) \
+    XF_BITMAP_DEFINE_LOGIC(_n, or,      p_a[blk_idx] | p_b[blk_idx]) \
+    XF_BITMAP_DEFINE_LOGIC(_n, andnot,  p_a[blk_idx] & ~p_b[blk_idx]) \
+    \
+    void xf_bitmap##_n##_iter_init(xf_bitmap_iter_t *p_it, const xf_bitmap##_n##_t *p_bm, \
+                                   uint32_t bit_start, uint32_t bit_end) \
+    { \
+        if (p_it == NULL) { \
+            return; \
+        } \
+        p_it->p_bm = p_bm; \
+        p_it->bit_end = bit_end; \
+        p_it->blk = 0; \
+        if ((p_bm == NULL) || (bit_start >= bit_end)) { \
+            /* 下一次 iter_next 越过 bit_end, 直接结束 */ \
+            p_it->blk_idx = bit_end / XF_BITMAP##_n##_BLK_BIT_SIZE; \
+            return; \
+        } \
+        p_it->blk_idx = bit_start / XF_BITMAP##_n##_BLK_BIT_SIZE; \
+        p_it->blk = (uint64_t)p_bm[p_it->blk_idx] & (~(uint64_t)0 << (bit_start % XF_BITMAP##_n##_BLK_BIT_SIZE)); \
+    } \
+    \
+    int32_t xf_bitmap##_n##_iter_next(xf_bitmap_iter_t *p_it) \
+    { \
+        uint32_t bit; \
+        if (p_it == NULL) { \
+            return -1; \
+        } \
+        while (p_it->blk == 0U) { \
+            if (((p_it->blk_idx + 1U) * XF_BITMAP##_n##_BLK_BIT_SIZE) >= p_it->bit_end) { \
+                return -1; \
+            } \
+            ++p_it->blk_idx; \
+            p_it->blk = ((const xf_bitmap##_n##_t *)p_it->p_bm)[p_it->blk_idx]; \
+        } \
+        bit = (p_it->blk_idx * XF_BITMAP##_n##_BLK_BIT_SIZE) + _ctz(p_it->blk); \
+        p_it->blk &= p_it->blk - 1U; \
+        if (bit >= p_it->bit_end) { \
+            p_it->blk = 0; \
+            return -1; \
+        } \
+        return (int32_t)bit; \
+    }
+
+/*
+    比较交换: *p_blk 等于 *p_old 时写入 new_val 并返回 TRUE,
+    否则把 *p_blk 的当前值读到 *p_old 并返回 FALSE.
+ */
+#define XF_BITMAP_DEFINE_CAS_BUILTIN(_n) \
+    static bool_t xf_bitmap##_n##_cas(volatile xf_bitmap##_n##_t *p_blk, \
+                                      xf_bitmap##_n##_t *p_old, xf_bitmap##_n##_t new_val) \
+    { \
+        return __atomic_compare_exchange_n(p_blk, p_old, new_val, 0, \
+                                           __ATOMIC_ACQ_REL, __ATOMIC_RELAXED) ? TRUE : FALSE; \
+    }
+
+#define XF_BITMAP_DEFINE_CAS_CRIT(_n) \
+    static bool_t xf_bitmap##_n##_cas(volatile xf_bitmap##_n##_t *p_blk, \
+                                      xf_bitmap##_n##_t *p_old, xf_bitmap##_n##_t new_val) \
+    { \
+        bool_t ok; \
+        XF_CRIT_STAT(); \
+        XF_CRIT_ENTRY(); \
+        ok = (*p_blk == *p_old) ? TRUE : FALSE; \
+        if (ok) { \
+            *p_blk = new_val; \
+        } else { \
+            *p_old = *p_blk; \
+        } \
+        XF_CRIT_EXIT(); \
+        return ok; \
+    }
+
+/*
+    按块宽度 _n 生成原子操作: test_and_set, test_and_clear, ffz_claim.
+    都是“读块 - 计算 - 比较交换”循环，块被其他上下文改动时重新计算。
+ */
+#define XF_BITMAP_DEFINE_ATOMIC(_n, _ctz) \
+    static bool_t xf_bitmap##_n##_update(xf_bitmap##_n##_t *p_bm, uint32_t bit, bool_t set) \
+    { \
+        volatile xf_bitmap##_n##_t *p_blk = &p_bm[bit / XF_BITMAP##_n##_BLK_BIT_SIZE]; \
+        xf_bitmap##_n##_t mask = (xf_bitmap##_n##_t)((xf_bitmap##_n##_t)1 << (bit % XF_BITMAP##_n##_BLK_BIT_SIZE)); \
+        xf_bitmap##_n##_t old = *p_blk; \
+        do { \
+            if (((old & mask) != 0U) == (set != FALSE)) { \
+                break; \
+            } \
+        } while (!xf_bitmap##_n##_cas(p_blk, &old, \
+                                      set ? (xf_bitmap##_n##_t)(old | mask) : (xf_bitmap##_n##_t)(old & ~mask))); \
+        return ((old & mask) != 0U) ? TRUE : FALSE; \
+    } \
+    \
+    bool_t xf_bitmap##_n##_test_and_set(xf_bitmap##_n##_t *p_bm, uint32_t bit) \
+    { \
+        return xf_bitmap##_n##_update(p_bm, bit, TRUE); \
+    } \
+    \
+    bool_t xf_bitmap##_n##_test_and_clear(xf_bitmap##_n##_t *p_bm, uint32_t bit) \
+    { \
+        return xf_bitmap##_n##_update(p_bm, bit, FALSE); \
+    } \
+    \
+    int32_t xf_bitmap##_n##_ffz_claim(xf_bitmap##_n##_t *p_bm, uint32_t bit_size) \
+    { \
+        uint32_t blk_idx; \
+        uint32_t blk_num; \
+        uint32_t bit; \
+        xf_bitmap##_n##_t tail; \
+        xf_bitmap##_n##_t old; \
+        xf_bitmap##_n##_t free_bits; \
+        if (p_bm == NULL) { \
+            return -1; \
+        } \
+        blk_num = XF_BITMAP##_n##_GET_BLK_SIZE(bit_size); \
+        for (blk_idx = 0; blk_idx < blk_num; ++blk_idx) { \
+            /* 最后一个块中超出 bit_size 的位视为已占用 */ \
+            tail = 0; \
+            if (((blk_idx + 1U) == blk_num) && ((bit_size % XF_BITMAP##_n##_BLK_BIT_SIZE) != 0U)) { \
+                tail = (xf_bitmap##_n##_t)(XF_BITMAP_BLK_ALL(_n) << (bit_size % XF_BITMAP##_n##_BLK_BIT_SIZE)); \
+            } \
+            old = ((volatile xf_bitmap##_n##_t *)p_bm)[blk_idx]; \
+            free_bits = (xf_bitmap##_n##_t)~(old | tail); \
+            while (free_bits != 0U) { \
+                bit = _ctz(free_bits); \
+                if (xf_bitmap##_n##_cas(&p_bm[blk_idx], &old, \
+                                        (xf_bitmap##_n##_t)(old | ((xf_bitmap##_n##_t)1 << bit)))) { \
+                    return (int32_t)((blk_idx * XF_BITMAP##_n##_BLK_BIT_SIZE) + bit); \
+                } \
+                free_bits = (xf_bitmap##_n##_t)~(old | tail); \
+            } \
+        } \
+        return -1; \
+    }
+
+/* 块内 1 的个数 */
+#define XF_BITMAP_POPCOUNT32(_x)        xf_am_popcount_u32((uint32_t)(_x))
+#if XF_COMMON_ENABLE_64BITS
+#   define XF_BITMAP_POPCOUNT64(_x)     xf_am_popcount_u64((uint64_t)(_x))
+#else
+#   define XF_BITMAP_POPCOUNT64(_x)     (xf_am_popcount_u32((uint32_t)(_x)) \
+                                         + xf_am_popcount_u32((uint32_t)((uint64_t)(_x) >> 32)))
+#endif
+
 /* ==================== [Global Functions] ================================== */
 
+int32_t xf_bitmap8_ffs(const xf_bitmap8_t *p_bm, uint32_t bit_size)
+{
+    return xf_bitmap8_find_first(p_bm, bit_size, FIND_SET);
+}
+
+int32_t xf_bitmap8_ffz(const xf_bitmap8_t *p_bm, uint32_t bit_size)
+{
+    return xf_bitmap8_find_first(p_bm, bit_size, FIND_ZERO);
+}
+
+int32_t xf_bitmap8_fls(const xf_bitmap8_t *p_bm, uint32_t bit_size)
+{
+    return xf_bitmap8_find_last(p_bm, bit_size, FIND_SET);
+}
+
+int32_t xf_bitmap8_flz(const xf_bitmap8_t *p_bm, uint32_t bit_size)
+{
+    return xf_bitmap8_find_last(p_bm, bit_size, FIND_ZERO);
+}
+
+int32_t xf_bitmap16_ffs(const xf_bitmap16_t *p_bm, uint32_t bit_size)
+{
+    return xf_bitmap16_find_first(p_bm, bit_size, FIND_SET);
+}
+
+int32_t xf_bitmap16_ffz(const xf_bitmap16_t *p_bm, uint32_t bit_size)
+{
+    return xf_bitmap16_find_first(p_bm, bit_size, FIND_ZERO);
+}
+
+int32_t xf_bitmap16_fls(const xf_bitmap16_t *p_bm, uint32_t bit_size)
+{
+    return xf_bitmap16_find_last(p_bm, bit_size, FIND_SET);
+}
+
+int32_t xf_bitmap16_flz(const xf_bitmap16_t *p_bm, uint32_t bit_size)
+{
+    return xf_bitmap16_find_last(p_bm, bit_size, FIND_ZERO);
+}
+
 int32_t xf_bitmap32_ffs(const xf_bitmap32_t *p_bm, uint32_t bit_size)
 {
     return xf_bitmap32_find_first(p_bm, bit_size, FIND_SET);
@@ -52,76 +504,151 @@ int32_t xf_bitmap32_flz(const xf_bitmap32_t *p_bm, uint32_t bit_size)
     return xf_bitmap32_find_last(p_bm, bit_size, FIND_ZERO);
 }
 
+int32_t xf_bitmap64_ffs(const xf_bitmap64_t *p_bm, uint32_t bit_size)
+{
+    return xf_bitmap64_find_first(p_bm, bit_size, FIND_SET);
+}
+
+int32_t xf_bitmap64_ffz(const xf_bitmap64_t *p_bm, uint32_t bit_size)
+{
+    return xf_bitmap64_find_first(p_bm, bit_size, FIND_ZERO);
+}
+
+int32_t xf_bitmap64_fls(const xf_bitmap64_t *p_bm, uint32_t bit_size)
+{
+    return xf_bitmap64_find_last(p_bm, bit_size, FIND_SET);
+}
+
+int32_t xf_bitmap64_flz(const xf_bitmap64_t *p_bm, uint32_t bit_size)
+{
+    return xf_bitmap64_find_last(p_bm, bit_size, FIND_ZERO);
+}
+
+uint32_t xf_bitmap32_blk_ctz(xf_bitmap32_t blk)
+{
+    return XF_BITMAP_CTZ32(blk);
+}
+
+uint32_t xf_bitmap32_blk_fls(xf_bitmap32_t blk)
+{
+    return XF_BITMAP_FLS32(blk);
+}
+
+uint32_t xf_bitmap64_blk_ctz(xf_bitmap64_t blk)
+{
+    return XF_BITMAP_CTZ64(blk);
+}
+
+uint32_t xf_bitmap64_blk_fls(xf_bitmap64_t blk)
+{
+    return XF_BITMAP_FLS64(blk);
+}
+
+XF_BITMAP_DEFINE_BULK(8,  XF_BITMAP_CTZ32, XF_BITMAP_POPCOUNT32)
+XF_BITMAP_DEFINE_BULK(16, XF_BITMAP_CTZ32, XF_BITMAP_POPCOUNT32)
+XF_BITMAP_DEFINE_BULK(32, XF_BITMAP_CTZ32, XF_BITMAP_POPCOUNT32)
+XF_BITMAP_DEFINE_BULK(64, XF_BITMAP_CTZ64, XF_BITMAP_POPCOUNT64)
+
+XF_BITMAP_DEFINE_ATOMIC(8,  XF_BITMAP_CTZ32)
+XF_BITMAP_DEFINE_ATOMIC(16, XF_BITMAP_CTZ32)
+XF_BITMAP_DEFINE_ATOMIC(32, XF_BITMAP_CTZ32)
+XF_BITMAP_DEFINE_ATOMIC(64, XF_BITMAP_CTZ64)
+
 /* ==================== [Static Functions] ================================== */
 
-static int32_t xf_bitmap32_find_first(const xf_bitmap32_t *p_bm, uint32_t bit_size, int invert)
+XF_BITMAP_DEFINE_FIND(8,  XF_BITMAP_CTZ32, XF_BITMAP_FLS32)
+XF_BITMAP_DEFINE_FIND(16, XF_BITMAP_CTZ32, XF_BITMAP_FLS32)
+XF_BITMAP_DEFINE_FIND(32, XF_BITMAP_CTZ32, XF_BITMAP_FLS32)
+XF_BITMAP_DEFINE_FIND(64, XF_BITMAP_CTZ64, XF_BITMAP_FLS64)
+
+#if XF_BITMAP_ATOMIC8_LOCK_FREE
+XF_BITMAP_DEFINE_CAS_BUILTIN(8)
+#else
+XF_BITMAP_DEFINE_CAS_CRIT(8)
+#endif
+#if XF_BITMAP_ATOMIC16_LOCK_FREE
+XF_BITMAP_DEFINE_CAS_BUILTIN(16)
+#else
+XF_BITMAP_DEFINE_CAS_CRIT(16)
+#endif
+#if XF_BITMAP_ATOMIC32_LOCK_FREE
+XF_BITMAP_DEFINE_CAS_BUILTIN(32)
+#else
+XF_BITMAP_DEFINE_CAS_CRIT(32)
+#endif
+#if XF_BITMAP_ATOMIC64_LOCK_FREE
+XF_BITMAP_DEFINE_CAS_BUILTIN(64)
+#else
+XF_BITMAP_DEFINE_CAS_CRIT(64)
+#endif
+
+#if XF_SIMD_WIDTH
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+static inline bool_t xf_simd_neon_equal(uint8x16_t a, uint8x16_t b)
 {
-    uint32_t blk_cnt;
-    uint32_t last_blk;
-    uint32_t blk_idx;
-    xf_bitmap32_t bm_blk;
-    uint32_t valid_bit_num;
-    if ((!p_bm) || (!bit_size)) {
-        return -1;
-    }
-    blk_cnt = xf_bitmap_div_round_up(bit_size, XF_BITMAP32_BLK_BIT_SIZE);
-    last_blk = blk_cnt - (!IS_ALIGNED(bit_size, XF_BITMAP32_BLK_BIT_SIZE) ? 1 : 0);
-    for (blk_idx = 0; blk_idx < last_blk; ++blk_idx) {
-        bm_blk = p_bm[blk_idx];
-        if (invert) {
-            bm_blk = ~bm_blk;
-        }
-        if (bm_blk) {
-            return (int32_t)(xf_am_ctz_u32(bm_blk) + (blk_idx * XF_BITMAP32_BLK_BIT_SIZE));
-        }
-    }
-    if (last_blk < blk_cnt) {
-        bm_blk = p_bm[last_blk];
-        if (invert) {
-            bm_blk = ~bm_blk;
-        }
-        valid_bit_num = bit_size % XF_BITMAP32_BLK_BIT_SIZE;
-        bm_blk &= BIT_MASK(valid_bit_num);  /*!< 屏蔽无效位 */
-        if (bm_blk) {
-            return (int32_t)(xf_am_ctz_u32(bm_blk) + (last_blk * XF_BITMAP32_BLK_BIT_SIZE));
-        }
-    }
-    return -1;
+    uint64x2_t eq = vreinterpretq_u64_u8(vceqq_u8(a, b));
+    return (vgetq_lane_u64(eq, 0) & vgetq_lane_u64(eq, 1)) == UINT64_MAX;
 }
+#endif
 
-static int32_t xf_bitmap32_find_last(const xf_bitmap32_t *p_bm, uint32_t bit_size, int invert)
+static size_t xf_bitmap_skip_fwd(const void *p_mem, size_t size, uint8_t fill)
 {
-    int32_t blk_idx;
-    uint32_t valid_bit_num;
-    xf_bitmap32_t bm_blk;
-    if ((!p_bm) || (!bit_size)) {
-        return -1;
+    const uint8_t *p8 = (const uint8_t *)p_mem;
+    xf_simd_t v_fill = XF_SIMD_SET1(fill);
+    size_t skip = 0;
+    while (((size - skip) >= XF_SIMD_WIDTH)
+            && XF_SIMD_EQUAL(XF_SIMD_LOAD(p8 + skip), v_fill)) {
+        skip += XF_SIMD_WIDTH;
     }
-    blk_idx = xf_div_round_down(bit_size, XF_BITMAP32_BLK_BIT_SIZE);
-    if (!IS_ALIGNED(bit_size, XF_BITMAP32_BLK_BIT_SIZE)) {
-        valid_bit_num = bit_size % XF_BITMAP32_BLK_BIT_SIZE;
-        bm_blk = p_bm[blk_idx];
-        if (invert) {
-            bm_blk = ~bm_blk;
-        }
-        bm_blk &= BIT_MASK(valid_bit_num);
-        if (bm_blk) {
-            return (int32_t)(xf_am_log2_u32(bm_blk) + (blk_idx * XF_BITMAP32_BLK_BIT_SIZE));
-        }
-    }
-    --blk_idx;
-    for (; blk_idx >= 0; --blk_idx) {
-        bm_blk = p_bm[blk_idx];
-        if (invert) {
-            bm_blk = ~bm_blk;
-        }
-        if (bm_blk) {
-            return (int32_t)(xf_am_log2_u32(bm_blk) + (blk_idx * XF_BITMAP32_BLK_BIT_SIZE));
-        }
+    return skip;
+}
+
+static size_t xf_bitmap_skip_bwd(const void *p_mem, size_t size, uint8_t fill)
+{
+    const uint8_t *p8 = (const uint8_t *)p_mem;
+    xf_simd_t v_fill = XF_SIMD_SET1(fill);
+    size_t remain = size;
+    while ((remain >= XF_SIMD_WIDTH)
+            && XF_SIMD_EQUAL(XF_SIMD_LOAD(p8 + remain - XF_SIMD_WIDTH), v_fill)) {
+        remain -= XF_SIMD_WIDTH;
     }
-    return -1;
+    return size - remain;
 }
 
+#endif /* XF_SIMD_WIDTH */
+
+#if !XF_COMMON_ENABLE_BUILTIN
+
+static uint32_t xf_bitmap_ctz32(uint32_t x)
+{
+    return s_ctz32_debruijn[((x & (0U - x)) * 0x077CB531U) >> 27];
+}
+
+static uint32_t xf_bitmap_fls32(uint32_t x)
+{
+    x |= x >> 1;
+    x |= x >> 2;
+    x |= x >> 4;
+    x |= x >> 8;
+    x |= x >> 16;
+    return s_fls32_debruijn[(x * 0x07C4ACDDU) >> 27];
+}
+
+static uint32_t xf_bitmap_ctz64(uint64_t x)
+{
+    uint32_t lo = (uint32_t)x;
+    return lo ? xf_bitmap_ctz32(lo) : (32U + xf_bitmap_ctz32((uint32_t)(x >> 32)));
+}
+
+static uint32_t xf_bitmap_fls64(uint64_t x)
+{
+    uint32_t hi = (uint32_t)(x >> 32);
+    return hi ? (32U + xf_bitmap_fls32(hi)) : xf_bitmap_fls32((uint32_t)x);
+}
+
+#endif /* !XF_COMMON_ENABLE_BUILTIN */
+
 #if 0
 // 测试用例：
 void TEST_CASE(void)
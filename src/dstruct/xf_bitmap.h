@@ -24,8 +24,13 @@ extern "C" {
 
 /* ==================== [Defines] =========================================== */
 
+/* 默认与平台字长一致，使 XF_BITMAP_* 及 xf_bitmap_ffs() 等按原生字处理 */
 #if !defined(XF_BITMAP_BLK_SIZE)
-#   define XF_BITMAP_BLK_SIZE 32
+#   if defined(UINTPTR_MAX) && (UINTPTR_MAX > 0xFFFFFFFFU)
+#       define XF_BITMAP_BLK_SIZE 64
+#   else
+#       define XF_BITMAP_BLK_SIZE 32
+#   endif
 #endif
 
 #if defined(XF_BITMAP_BLK_SIZE) \
@@ -43,6 +48,18 @@ typedef uint16_t    xf_bitmap16_t;
 typedef uint32_t    xf_bitmap32_t;
 typedef uint64_t    xf_bitmap64_t;
 
+/**
+ * @brief 置位遍历器，见 XF_BITMAP32_FOR_EACH_SET_BIT 等.
+ *
+ * 每个块只读取一次，块被读取后对它的修改不影响本次遍历。
+ */
+typedef struct xf_bitmap_iter {
+    const void             *p_bm;           /*!< 位图 */
+    uint32_t                bit_end;        /*!< 结束位序号（不含） */
+    uint32_t                blk_idx;        /*!< 当前块序号 */
+    uint64_t                blk;            /*!< 当前块中尚未返回的 1 */
+} xf_bitmap_iter_t;
+
 /* ==================== [Global Prototypes] ================================= */
 
 /*
@@ -54,22 +71,114 @@ typedef uint64_t    xf_bitmap64_t;
             也就是从高到低找第一个 0 出现的位置。
  */
 
-#if XF_TODO
-int32_t xf_bitmap8_fls(const xf_bitmap8_t *p_bm, uint32_t bit_size);
-int32_t xf_bitmap16_fls(const xf_bitmap16_t *p_bm, uint32_t bit_size);
-int32_t xf_bitmap64_fls(const xf_bitmap64_t *p_bm, uint32_t bit_size);
+/*
+    以下函数只查找前 bit_size 位，返回位序号，找不到或 bit_size 为 0 时返回 -1.
+    块内查找在 XF_COMMON_ENABLE_BUILTIN 时使用编译器内建函数，否则查表;
+    XF_BITMAP_ENABLE_SIMD 时先用向量指令成块跳过全 0 / 全 1 的区域。
+ */
 
 int32_t xf_bitmap8_ffs(const xf_bitmap8_t *p_bm, uint32_t bit_size);
+int32_t xf_bitmap8_fls(const xf_bitmap8_t *p_bm, uint32_t bit_size);
+int32_t xf_bitmap8_ffz(const xf_bitmap8_t *p_bm, uint32_t bit_size);
+int32_t xf_bitmap8_flz(const xf_bitmap8_t *p_bm, uint32_t bit_size);
+
 int32_t xf_bitmap16_ffs(const xf_bitmap16_t *p_bm, uint32_t bit_size);
-int32_t xf_bitmap32_ffs(const xf_bitmap32_t *p_bm, uint32_t bit_size);
-int32_t xf_bitmap64_ffs(const xf_bitmap64_t *p_bm, uint32_t bit_size);
-#endif
+int32_t xf_bitmap16_fls(const xf_bitmap16_t *p_bm, uint32_t bit_size);
+int32_t xf_bitmap16_ffz(const xf_bitmap16_t *p_bm, uint32_t bit_size);
+int32_t xf_bitmap16_flz(const xf_bitmap16_t *p_bm, uint32_t bit_size);
 
 int32_t xf_bitmap32_ffs(const xf_bitmap32_t *p_bm, uint32_t bit_size);
 int32_t xf_bitmap32_fls(const xf_bitmap32_t *p_bm, uint32_t bit_size);
 int32_t xf_bitmap32_ffz(const xf_bitmap32_t *p_bm, uint32_t bit_size);
 int32_t xf_bitmap32_flz(const xf_bitmap32_t *p_bm, uint32_t bit_size);
 
+int32_t xf_bitmap64_ffs(const xf_bitmap64_t *p_bm, uint32_t bit_size);
+int32_t xf_bitmap64_fls(const xf_bitmap64_t *p_bm, uint32_t bit_size);
+int32_t xf_bitmap64_ffz(const xf_bitmap64_t *p_bm, uint32_t bit_size);
+int32_t xf_bitmap64_flz(const xf_bitmap64_t *p_bm, uint32_t bit_size);
+
+/*
+    单个块内查找, blk 不能为 0.
+    blk_ctz: 最低的 1 的位置; blk_fls: 最高的 1 的位置.
+ */
+
+uint32_t xf_bitmap32_blk_ctz(xf_bitmap32_t blk);
+uint32_t xf_bitmap32_blk_fls(xf_bitmap32_t blk);
+uint32_t xf_bitmap64_blk_ctz(xf_bitmap64_t blk);
+uint32_t xf_bitmap64_blk_fls(xf_bitmap64_t blk);
+
+/*
+    批量操作，按块并行处理。
+    set_range / clear_range:    置 1 / 清 0 [bit_start, bit_start + bit_num) 内的位，
+                                参数无效时返回 XF_ERR_INVALID_ARG.
+    popcount:                   前 bit_size 位中 1 的个数。
+    and / or / andnot:          p_dst = p_a & p_b / p_a | p_b / p_a & ~p_b,
+                                按块处理前 bit_size 位所在的所有块, p_dst 可以与 p_a 或 p_b 相同。
+    iter_init / iter_next:      从低到高遍历 [bit_start, bit_end) 内的 1, 每个块只读取一次，
+                                iter_next 遍历完返回 -1. 通常使用 XF_BITMAP32_FOR_EACH_SET_BIT 等。
+ */
+
+xf_err_t xf_bitmap8_set_range(xf_bitmap8_t *p_bm, uint32_t bit_start, uint32_t bit_num);
+xf_err_t xf_bitmap8_clear_range(xf_bitmap8_t *p_bm, uint32_t bit_start, uint32_t bit_num);
+uint32_t xf_bitmap8_popcount(const xf_bitmap8_t *p_bm, uint32_t bit_size);
+xf_err_t xf_bitmap8_and(xf_bitmap8_t *p_dst, const xf_bitmap8_t *p_a, const xf_bitmap8_t *p_b, uint32_t bit_size);
+xf_err_t xf_bitmap8_or(xf_bitmap8_t *p_dst, const xf_bitmap8_t *p_a, const xf_bitmap8_t *p_b, uint32_t bit_size);
+xf_err_t xf_bitmap8_andnot(xf_bitmap8_t *p_dst, const xf_bitmap8_t *p_a, const xf_bitmap8_t *p_b, uint32_t bit_size);
+void xf_bitmap8_iter_init(xf_bitmap_iter_t *p_it, const xf_bitmap8_t *p_bm, uint32_t bit_start, uint32_t bit_end);
+int32_t xf_bitmap8_iter_next(xf_bitmap_iter_t *p_it);
+
+xf_err_t xf_bitmap16_set_range(xf_bitmap16_t *p_bm, uint32_t bit_start, uint32_t bit_num);
+xf_err_t xf_bitmap16_clear_range(xf_bitmap16_t *p_bm, uint32_t bit_start, uint32_t bit_num);
+uint32_t xf_bitmap16_popcount(const xf_bitmap16_t *p_bm, uint32_t bit_size);
+xf_err_t xf_bitmap16_and(xf_bitmap16_t *p_dst, const xf_bitmap16_t *p_a, const xf_bitmap16_t *p_b, uint32_t bit_size);
+xf_err_t xf_bitmap16_or(xf_bitmap16_t *p_dst, const xf_bitmap16_t *p_a, const xf_bitmap16_t *p_b, uint32_t bit_size);
+xf_err_t xf_bitmap16_andnot(xf_bitmap16_t *p_dst, const xf_bitmap16_t *p_a, const xf_bitmap16_t *p_b, uint32_t bit_size);
+void xf_bitmap16_iter_init(xf_bitmap_iter_t *p_it, const xf_bitmap16_t *p_bm, uint32_t bit_start, uint32_t bit_end);
+int32_t xf_bitmap16_iter_next(xf_bitmap_iter_t *p_it);
+
+xf_err_t xf_bitmap32_set_range(xf_bitmap32_t *p_bm, uint32_t bit_start, uint32_t bit_num);
+xf_err_t xf_bitmap32_clear_range(xf_bitmap32_t *p_bm, uint32_t bit_start, uint32_t bit_num);
+uint32_t xf_bitmap32_popcount(const xf_bitmap32_t *p_bm, uint32_t bit_size);
+xf_err_t xf_bitmap32_and(xf_bitmap32_t *p_dst, const xf_bitmap32_t *p_a, const xf_bitmap32_t *p_b, uint32_t bit_size);
+xf_err_t xf_bitmap32_or(xf_bitmap32_t *p_dst, const xf_bitmap32_t *p_a, const xf_bitmap32_t *p_b, uint32_t bit_size);
+xf_err_t xf_bitmap32_andnot(xf_bitmap32_t *p_dst, const xf_bitmap32_t *p_a, const xf_bitmap32_t *p_b, uint32_t bit_size);
+void xf_bitmap32_iter_init(xf_bitmap_iter_t *p_it, const xf_bitmap32_t *p_bm, uint32_t bit_start, uint32_t bit_end);
+int32_t xf_bitmap32_iter_next(xf_bitmap_iter_t *p_it);
+
+xf_err_t xf_bitmap64_set_range(xf_bitmap64_t *p_bm, uint32_t bit_start, uint32_t bit_num);
+xf_err_t xf_bitmap64_clear_range(xf_bitmap64_t *p_bm, uint32_t bit_start, uint32_t bit_num);
+uint32_t xf_bitmap64_popcount(const xf_bitmap64_t *p_bm, uint32_t bit_size);
+xf_err_t xf_bitmap64_and(xf_bitmap64_t *p_dst, const xf_bitmap64_t *p_a, const xf_bitmap64_t *p_b, uint32_t bit_size);
+xf_err_t xf_bitmap64_or(xf_bitmap64_t *p_dst, const xf_bitmap64_t *p_a, const xf_bitmap64_t *p_b, uint32_t bit_size);
+xf_err_t xf_bitmap64_andnot(xf_bitmap64_t *p_dst, const xf_bitmap64_t *p_a, const xf_bitmap64_t *p_b, uint32_t bit_size);
+void xf_bitmap64_iter_init(xf_bitmap_iter_t *p_it, const xf_bitmap64_t *p_bm, uint32_t bit_start, uint32_t bit_end);
+int32_t xf_bitmap64_iter_next(xf_bitmap_iter_t *p_it);
+
+/*
+    原子操作，多个上下文（包括中断）同时操作同一位图时不需要另加临界区。
+    编译器支持该宽度的无锁比较交换时不关中断，否则在 XF_CRIT_ENTRY 内完成。
+    test_and_set / test_and_clear:  置 1 / 清 0 一位，返回该位原来的值, p_bm 不能为 NULL.
+    ffz_claim:                      找前 bit_size 位中第一个 0 并置 1, 返回位序号，全 1 时返回 -1.
+                                    用于无锁分配序号。
+    与非原子操作（XF_BITMAP32_SET1 等）混用时，非原子操作仍需临界区。
+ */
+
+bool_t xf_bitmap8_test_and_set(xf_bitmap8_t *p_bm, uint32_t bit);
+bool_t xf_bitmap8_test_and_clear(xf_bitmap8_t *p_bm, uint32_t bit);
+int32_t xf_bitmap8_ffz_claim(xf_bitmap8_t *p_bm, uint32_t bit_size);
+
+bool_t xf_bitmap16_test_and_set(xf_bitmap16_t *p_bm, uint32_t bit);
+bool_t xf_bitmap16_test_and_clear(xf_bitmap16_t *p_bm, uint32_t bit);
+int32_t xf_bitmap16_ffz_claim(xf_bitmap16_t *p_bm, uint32_t bit_size);
+
+bool_t xf_bitmap32_test_and_set(xf_bitmap32_t *p_bm, uint32_t bit);
+bool_t xf_bitmap32_test_and_clear(xf_bitmap32_t *p_bm, uint32_t bit);
+int32_t xf_bitmap32_ffz_claim(xf_bitmap32_t *p_bm, uint32_t bit_size);
+
+bool_t xf_bitmap64_test_and_set(xf_bitmap64_t *p_bm, uint32_t bit);
+bool_t xf_bitmap64_test_and_clear(xf_bitmap64_t *p_bm, uint32_t bit);
+int32_t xf_bitmap64_ffz_claim(xf_bitmap64_t *p_bm, uint32_t bit_size);
+
 /* ==================== [Macros] ============================================ */
 
 #if !defined(xf_bitmap_div_round_up)
@@ -94,7 +203,7 @@ int32_t xf_bitmap32_flz(const xf_bitmap32_t *p_bm, uint32_t bit_size);
 #define XF_BITMAP8_SET_FLIP(_bitmap, _bit)              (XF_BITMAP8_GET_BLK(_bitmap, _bit) = XF_BITMAP8_GET_MDF_FLIP(_bitmap, _bit))
 
 #define XF_BITMAP16_BLK_BIT_SIZE                        (8 * sizeof(xf_bitmap16_t))
-#define XF_BITMAP16_GET_BLK_SIZE(_bit_size)             xf_bitmap_div_round_up((_bit_size), XF_BITMAP8_BLK_BIT_SIZE)
+#define XF_BITMAP16_GET_BLK_SIZE(_bit_size)             xf_bitmap_div_round_up((_bit_size), XF_BITMAP16_BLK_BIT_SIZE)
 #define XF_BITMAP16_DECLARE(_bitmap, _bit_size)         xf_bitmap16_t _bitmap[XF_BITMAP16_GET_BLK_SIZE(_bit_size)]
 #define XF_BITMAP16_GET_BLK_POS(_bit)                   ((_bit) / (sizeof(xf_bitmap16_t) * 8))
 #define XF_BITMAP16_GET_BIT_POS_IN_BLK(_bit)            ((_bit) % (sizeof(xf_bitmap16_t) * 8))
@@ -158,7 +267,7 @@ typedef XCAT3(xf_bitmap, XF_BITMAP_BLK_SIZE, _t)        xf_bitmap_t;
 #define XF_BITMAP_GET_MDF1(_bitmap, _bit)               XCAT3(XF_BITMAP, XF_BITMAP_BLK_SIZE, _GET_MDF1) ((_bitmap), (_bit))
 #define XF_BITMAP_GET_MDF0(_bitmap, _bit)               XCAT3(XF_BITMAP, XF_BITMAP_BLK_SIZE, _GET_MDF0) ((_bitmap), (_bit))
 #define XF_BITMAP_GET_MDF(_bitmap, _bit, _value)        XCAT3(XF_BITMAP, XF_BITMAP_BLK_SIZE, _GET_MDF) ((_bitmap), (_bit), (_value))
-#define XF_BITMAP_GET_MDF_FLIP(_bitmap, _bit)           XCAT3(XF_BITMAP, XF_BITMAP_BLK_SIZE, _MDF_FLIP) ((_bitmap), (_value))
+#define XF_BITMAP_GET_MDF_FLIP(_bitmap, _bit)           XCAT3(XF_BITMAP, XF_BITMAP_BLK_SIZE, _GET_MDF_FLIP) ((_bitmap), (_bit))
 #define XF_BITMAP_SET1(_bitmap, _bit)                   XCAT3(XF_BITMAP, XF_BITMAP_BLK_SIZE, _SET1) ((_bitmap), (_bit))
 #define XF_BITMAP_SET0(_bitmap, _bit)                   XCAT3(XF_BITMAP, XF_BITMAP_BLK_SIZE, _SET0) ((_bitmap), (_bit))
 #define XF_BITMAP_SET(_bitmap, _bit, _value)            XCAT3(XF_BITMAP, XF_BITMAP_BLK_SIZE, _SET) ((_bitmap), (_bit), (_value))
@@ -182,6 +291,82 @@ typedef XCAT3(xf_bitmap, XF_BITMAP_BLK_SIZE, _t)        xf_bitmap_t;
 #define XF_BITMAP_SET_FLIP                              XCAT3(XF_BITMAP, XF_BITMAP_BLK_SIZE, _SET_FLIP)
 #endif
 
+#define XF_BITMAP8_FOR_EACH_SET_BIT(_bit, _p_it, _p_bm, _bit_size) \
+    XF_BITMAP8_FOR_EACH_SET_BIT_IN(_bit, _p_it, _p_bm, 0U, _bit_size)
+#define XF_BITMAP8_FOR_EACH_SET_BIT_IN(_bit, _p_it, _p_bm, _bit_start, _bit_end) \
+    for (xf_bitmap8_iter_init((_p_it), (_p_bm), (_bit_start), (_bit_end)), (_bit) = xf_bitmap8_iter_next(_p_it); \
+            (_bit) >= 0; (_bit) = xf_bitmap8_iter_next(_p_it))
+
+#define XF_BITMAP16_FOR_EACH_SET_BIT(_bit, _p_it, _p_bm, _bit_size) \
+    XF_BITMAP16_FOR_EACH_SET_BIT_IN(_bit, _p_it, _p_bm, 0U, _bit_size)
+#define XF_BITMAP16_FOR_EACH_SET_BIT_IN(_bit, _p_it, _p_bm, _bit_start, _bit_end) \
+    for (xf_bitmap16_iter_init((_p_it), (_p_bm), (_bit_start), (_bit_end)), (_bit) = xf_bitmap16_iter_next(_p_it); \
+            (_bit) >= 0; (_bit) = xf_bitmap16_iter_next(_p_it))
+
+#define XF_BITMAP32_FOR_EACH_SET_BIT(_bit, _p_it, _p_bm, _bit_size) \
+    XF_BITMAP32_FOR_EACH_SET_BIT_IN(_bit, _p_it, _p_bm, 0U, _bit_size)
+#define XF_BITMAP32_FOR_EACH_SET_BIT_IN(_bit, _p_it, _p_bm, _bit_start, _bit_end) \
+    for (xf_bitmap32_iter_init((_p_it), (_p_bm), (_bit_start), (_bit_end)), (_bit) = xf_bitmap32_iter_next(_p_it); \
+            (_bit) >= 0; (_bit) = xf_bitmap32_iter_next(_p_it))
+
+#define XF_BITMAP64_FOR_EACH_SET_BIT(_bit, _p_it, _p_bm, _bit_size) \
+    XF_BITMAP64_FOR_EACH_SET_BIT_IN(_bit, _p_it, _p_bm, 0U, _bit_size)
+#define XF_BITMAP64_FOR_EACH_SET_BIT_IN(_bit, _p_it, _p_bm, _bit_start, _bit_end) \
+    for (xf_bitmap64_iter_init((_p_it), (_p_bm), (_bit_start), (_bit_end)), (_bit) = xf_bitmap64_iter_next(_p_it); \
+            (_bit) >= 0; (_bit) = xf_bitmap64_iter_next(_p_it))
+
+#define xf_bitmap8_blk_ctz(_blk)                        xf_bitmap32_blk_ctz((xf_bitmap32_t)(_blk))
+#define xf_bitmap8_blk_fls(_blk)                        xf_bitmap32_blk_fls((xf_bitmap32_t)(_blk))
+#define xf_bitmap16_blk_ctz(_blk)                       xf_bitmap32_blk_ctz((xf_bitmap32_t)(_blk))
+#define xf_bitmap16_blk_fls(_blk)                       xf_bitmap32_blk_fls((xf_bitmap32_t)(_blk))
+
+#define xf_bitmap_blk_ctz(_blk)                         XCAT3(xf_bitmap, XF_BITMAP_BLK_SIZE, _blk_ctz) ((_blk))
+#define xf_bitmap_blk_fls(_blk)                         XCAT3(xf_bitmap, XF_BITMAP_BLK_SIZE, _blk_fls) ((_blk))
+#define xf_bitmap_ffs(_p_bm, _bit_size)                 XCAT3(xf_bitmap, XF_BITMAP_BLK_SIZE, _ffs) ((_p_bm), (_bit_size))
+#define xf_bitmap_fls(_p_bm, _bit_size)                 XCAT3(xf_bitmap, XF_BITMAP_BLK_SIZE, _fls) ((_p_bm), (_bit_size))
+#define xf_bitmap_ffz(_p_bm, _bit_size)                 XCAT3(xf_bitmap, XF_BITMAP_BLK_SIZE, _ffz) ((_p_bm), (_bit_size))
+#define xf_bitmap_flz(_p_bm, _bit_size)                 XCAT3(xf_bitmap, XF_BITMAP_BLK_SIZE, _flz) ((_p_bm), (_bit_size))
+
+#define xf_bitmap_set_range(_p_bm, _bit_start, _bit_num) \
+    XCAT3(xf_bitmap, XF_BITMAP_BLK_SIZE, _set_range) ((_p_bm), (_bit_start), (_bit_num))
+#define xf_bitmap_clear_range(_p_bm, _bit_start, _bit_num) \
+    XCAT3(xf_bitmap, XF_BITMAP_BLK_SIZE, _clear_range) ((_p_bm), (_bit_start), (_bit_num))
+#define xf_bitmap_popcount(_p_bm, _bit_size) \
+    XCAT3(xf_bitmap, XF_BITMAP_BLK_SIZE, _popcount) ((_p_bm), (_bit_size))
+#define xf_bitmap_and(_p_dst, _p_a, _p_b, _bit_size) \
+    XCAT3(xf_bitmap, XF_BITMAP_BLK_SIZE, _and) ((_p_dst), (_p_a), (_p_b), (_bit_size))
+#define xf_bitmap_or(_p_dst, _p_a, _p_b, _bit_size) \
+    XCAT3(xf_bitmap, XF_BITMAP_BLK_SIZE, _or) ((_p_dst), (_p_a), (_p_b), (_bit_size))
+#define xf_bitmap_andnot(_p_dst, _p_a, _p_b, _bit_size) \
+    XCAT3(xf_bitmap, XF_BITMAP_BLK_SIZE, _andnot) ((_p_dst), (_p_a), (_p_b), (_bit_size))
+#define xf_bitmap_iter_init(_p_it, _p_bm, _bit_start, _bit_end) \
+    XCAT3(xf_bitmap, XF_BITMAP_BLK_SIZE, _iter_init) ((_p_it), (_p_bm), (_bit_start), (_bit_end))
+#define xf_bitmap_iter_next(_p_it) \
+    XCAT3(xf_bitmap, XF_BITMAP_BLK_SIZE, _iter_next) ((_p_it))
+#define xf_bitmap_test_and_set(_p_bm, _bit) \
+    XCAT3(xf_bitmap, XF_BITMAP_BLK_SIZE, _test_and_set) ((_p_bm), (_bit))
+#define xf_bitmap_test_and_clear(_p_bm, _bit) \
+    XCAT3(xf_bitmap, XF_BITMAP_BLK_SIZE, _test_and_clear) ((_p_bm), (_bit))
+#define xf_bitmap_ffz_claim(_p_bm, _bit_size) \
+    XCAT3(xf_bitmap, XF_BITMAP_BLK_SIZE, _ffz_claim) ((_p_bm), (_bit_size))
+
+/**
+ * @brief 从低到高遍历位图中的 1.
+ *
+ * @code{c}
+ * xf_bitmap_iter_t it;
+ * int32_t bit;
+ * XF_BITMAP_FOR_EACH_SET_BIT(bit, &it, bm, BIT_SIZE) {
+ *     ...
+ * }
+ * @endcode
+ */
+#define XF_BITMAP_FOR_EACH_SET_BIT(_bit, _p_it, _p_bm, _bit_size) \
+    XF_BITMAP_FOR_EACH_SET_BIT_IN(_bit, _p_it, _p_bm, 0U, _bit_size)
+#define XF_BITMAP_FOR_EACH_SET_BIT_IN(_bit, _p_it, _p_bm, _bit_start, _bit_end) \
+    for (xf_bitmap_iter_init((_p_it), (_p_bm), (_bit_start), (_bit_end)), (_bit) = xf_bitmap_iter_next(_p_it); \
+            (_bit) >= 0; (_bit) = xf_bitmap_iter_next(_p_it))
+
 #ifdef __cplusplus
 } /*extern "C"*/
 #endif
@@ -15,9 +15,13 @@
 
 /* ==================== [Includes] ========================================== */
 
+#include "xf_arena.h"
 #include "xf_bitmap.h"
+#include "xf_hbitmap.h"
 #include "xf_list.h"
 #include "xf_deque.h"
+#include "xf_mempool.h"
+#include "xf_tlsf.h"
 
 #ifdef __cplusplus
 extern "C" {
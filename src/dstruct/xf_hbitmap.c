@@ -0,0 +1,225 @@
+/**
+ * @file xf_hbitmap.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 分层位图。
+ * @version 1.0
+ * @date 2025-07-11
+ *
+ * SPDX-FileCopyrightText: 2025 CompanyNameMagicTag
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_hbitmap.h"
+#include "../std/xf_string.h"
+
+/* ==================== [Defines] =========================================== */
+
+#define BLK_BITS        ((uint32_t)XF_BITMAP_BLK_BIT_SIZE)
+#define BLK_ONE         ((xf_bitmap_t)1)
+#define BLK_ALL         ((xf_bitmap_t)~(xf_bitmap_t)0)
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+/* ==================== [Static Variables] ================================== */
+
+/* ==================== [Macros] ============================================ */
+
+/* 不低于 / 不高于第 _n 位的掩码, _n < BLK_BITS */
+#define BLK_MASK_FROM(_n)       (BLK_ALL << (_n))
+#define BLK_MASK_UPTO(_n)       (BLK_ALL >> (BLK_BITS - 1U - (_n)))
+
+/* ==================== [Global Functions] ================================== */
+
+xf_err_t xf_hbitmap_init(xf_hbitmap_t *p_hbm,
+                         xf_bitmap_t *p_leaf, xf_bitmap_t *p_mid, uint32_t bit_size)
+{
+    uint32_t leaf_num;
+    uint32_t mid_num;
+    if ((p_hbm == NULL) || (p_leaf == NULL) || (p_mid == NULL)
+            || (bit_size == 0) || (bit_size > XF_HBITMAP_BIT_SIZE_MAX)) {
+        return XF_ERR_INVALID_ARG;
+    }
+    leaf_num = XF_HBITMAP_LEAF_NUM(bit_size);
+    mid_num = XF_HBITMAP_MID_NUM(bit_size);
+    xf_memset(p_leaf, 0, leaf_num * sizeof(xf_bitmap_t));
+    xf_memset(p_mid, 0, 2U * mid_num * sizeof(xf_bitmap_t));
+    p_hbm->p_leaf = p_leaf;
+    p_hbm->p_mid_set = p_mid;
+    p_hbm->p_mid_full = p_mid + mid_num;
+    p_hbm->top_set = 0;
+    p_hbm->top_full = 0;
+    p_hbm->bit_size = bit_size;
+    return XF_OK;
+}
+
+xf_err_t xf_hbitmap_set1(xf_hbitmap_t *p_hbm, uint32_t bit)
+{
+    uint32_t leaf;
+    uint32_t mid;
+    if ((p_hbm == NULL) || (bit >= p_hbm->bit_size)) {
+        return XF_ERR_INVALID_ARG;
+    }
+    leaf = bit / BLK_BITS;
+    mid = leaf / BLK_BITS;
+    p_hbm->p_leaf[leaf] |= BLK_ONE << (bit % BLK_BITS);
+    p_hbm->p_mid_set[mid] |= BLK_ONE << (leaf % BLK_BITS);
+    p_hbm->top_set |= BLK_ONE << mid;
+    if (p_hbm->p_leaf[leaf] == BLK_ALL) {
+        p_hbm->p_mid_full[mid] |= BLK_ONE << (leaf % BLK_BITS);
+        if (p_hbm->p_mid_full[mid] == BLK_ALL) {
+            p_hbm->top_full |= BLK_ONE << mid;
+        }
+    }
+    return XF_OK;
+}
+
+xf_err_t xf_hbitmap_set0(xf_hbitmap_t *p_hbm, uint32_t bit)
+{
+    uint32_t leaf;
+    uint32_t mid;
+    if ((p_hbm == NULL) || (bit >= p_hbm->bit_size)) {
+        return XF_ERR_INVALID_ARG;
+    }
+    leaf = bit / BLK_BITS;
+    mid = leaf / BLK_BITS;
+    p_hbm->p_leaf[leaf] &= ~(BLK_ONE << (bit % BLK_BITS));
+    p_hbm->p_mid_full[mid] &= ~(BLK_ONE << (leaf % BLK_BITS));
+    p_hbm->top_full &= ~(BLK_ONE << mid);
+    if (p_hbm->p_leaf[leaf] == 0) {
+        p_hbm->p_mid_set[mid] &= ~(BLK_ONE << (leaf % BLK_BITS));
+        if (p_hbm->p_mid_set[mid] == 0) {
+            p_hbm->top_set &= ~(BLK_ONE << mid);
+        }
+    }
+    return XF_OK;
+}
+
+bool_t xf_hbitmap_get(const xf_hbitmap_t *p_hbm, uint32_t bit)
+{
+    if ((p_hbm == NULL) || (bit >= p_hbm->bit_size)) {
+        return FALSE;
+    }
+    return ((p_hbm->p_leaf[bit / BLK_BITS] >> (bit % BLK_BITS)) & BLK_ONE) ? TRUE : FALSE;
+}
+
+int32_t xf_hbitmap_ffs(const xf_hbitmap_t *p_hbm)
+{
+    uint32_t mid;
+    uint32_t leaf;
+    if ((p_hbm == NULL) || (p_hbm->top_set == 0)) {
+        return -1;
+    }
+    mid = xf_bitmap_blk_ctz(p_hbm->top_set);
+    leaf = (mid * BLK_BITS) + xf_bitmap_blk_ctz(p_hbm->p_mid_set[mid]);
+    return (int32_t)((leaf * BLK_BITS) + xf_bitmap_blk_ctz(p_hbm->p_leaf[leaf]));
+}
+
+int32_t xf_hbitmap_fls(const xf_hbitmap_t *p_hbm)
+{
+    uint32_t mid;
+    uint32_t leaf;
+    if ((p_hbm == NULL) || (p_hbm->top_set == 0)) {
+        return -1;
+    }
+    mid = xf_bitmap_blk_fls(p_hbm->top_set);
+    leaf = (mid * BLK_BITS) + xf_bitmap_blk_fls(p_hbm->p_mid_set[mid]);
+    return (int32_t)((leaf * BLK_BITS) + xf_bitmap_blk_fls(p_hbm->p_leaf[leaf]));
+}
+
+int32_t xf_hbitmap_ffz(const xf_hbitmap_t *p_hbm)
+{
+    uint32_t mid;
+    uint32_t leaf;
+    uint32_t bit;
+    xf_bitmap_t blk;
+    if (p_hbm == NULL) {
+        return -1;
+    }
+    blk = (xf_bitmap_t)~p_hbm->top_full;
+    if (blk == 0) {
+        return -1;
+    }
+    /* 不存在的块及超出 bit_size 的位都是 0, 找到后再判断是否越界 */
+    mid = xf_bitmap_blk_ctz(blk);
+    if (mid >= XF_HBITMAP_MID_NUM(p_hbm->bit_size)) {
+        return -1;
+    }
+    leaf = (mid * BLK_BITS) + xf_bitmap_blk_ctz((xf_bitmap_t)~p_hbm->p_mid_full[mid]);
+    if (leaf >= XF_HBITMAP_LEAF_NUM(p_hbm->bit_size)) {
+        return -1;
+    }
+    bit = (leaf * BLK_BITS) + xf_bitmap_blk_ctz((xf_bitmap_t)~p_hbm->p_leaf[leaf]);
+    return (bit < p_hbm->bit_size) ? (int32_t)bit : -1;
+}
+
+int32_t xf_hbitmap_find_next_set(const xf_hbitmap_t *p_hbm, uint32_t bit)
+{
+    uint32_t mid;
+    uint32_t leaf;
+    xf_bitmap_t blk;
+    if ((p_hbm == NULL) || (bit >= p_hbm->bit_size)) {
+        return -1;
+    }
+    /* 本叶子块内 */
+    leaf = bit / BLK_BITS;
+    blk = p_hbm->p_leaf[leaf] & BLK_MASK_FROM(bit % BLK_BITS);
+    if (blk != 0) {
+        return (int32_t)((leaf * BLK_BITS) + xf_bitmap_blk_ctz(blk));
+    }
+    /* 同一第 1 层块内后面的叶子块 */
+    mid = leaf / BLK_BITS;
+    blk = ((leaf % BLK_BITS) + 1U < BLK_BITS)
+          ? (p_hbm->p_mid_set[mid] & BLK_MASK_FROM((leaf % BLK_BITS) + 1U)) : 0;
+    if (blk == 0) {
+        /* 后面的第 1 层块 */
+        blk = (mid + 1U < BLK_BITS) ? (p_hbm->top_set & BLK_MASK_FROM(mid + 1U)) : 0;
+        if (blk == 0) {
+            return -1;
+        }
+        mid = xf_bitmap_blk_ctz(blk);
+        blk = p_hbm->p_mid_set[mid];
+    }
+    leaf = (mid * BLK_BITS) + xf_bitmap_blk_ctz(blk);
+    return (int32_t)((leaf * BLK_BITS) + xf_bitmap_blk_ctz(p_hbm->p_leaf[leaf]));
+}
+
+int32_t xf_hbitmap_find_prev_set(const xf_hbitmap_t *p_hbm, uint32_t bit)
+{
+    uint32_t mid;
+    uint32_t leaf;
+    xf_bitmap_t blk;
+    if (p_hbm == NULL) {
+        return -1;
+    }
+    if (bit >= p_hbm->bit_size) {
+        bit = p_hbm->bit_size - 1U;
+    }
+    /* 本叶子块内 */
+    leaf = bit / BLK_BITS;
+    blk = p_hbm->p_leaf[leaf] & BLK_MASK_UPTO(bit % BLK_BITS);
+    if (blk != 0) {
+        return (int32_t)((leaf * BLK_BITS) + xf_bitmap_blk_fls(blk));
+    }
+    /* 同一第 1 层块内前面的叶子块 */
+    mid = leaf / BLK_BITS;
+    blk = ((leaf % BLK_BITS) > 0U)
+          ? (p_hbm->p_mid_set[mid] & BLK_MASK_UPTO((leaf % BLK_BITS) - 1U)) : 0;
+    if (blk == 0) {
+        /* 前面的第 1 层块 */
+        blk = (mid > 0U) ? (p_hbm->top_set & BLK_MASK_UPTO(mid - 1U)) : 0;
+        if (blk == 0) {
+            return -1;
+        }
+        mid = xf_bitmap_blk_fls(blk);
+        blk = p_hbm->p_mid_set[mid];
+    }
+    leaf = (mid * BLK_BITS) + xf_bitmap_blk_fls(blk);
+    return (int32_t)((leaf * BLK_BITS) + xf_bitmap_blk_fls(p_hbm->p_leaf[leaf]));
+}
+
+/* ==================== [Static Functions] ================================== */
@@ -0,0 +1,173 @@
+/**
+ * @file xf_hbitmap.h
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 分层位图。
+ * @version 1.0
+ * @date 2025-07-11
+ *
+ * SPDX-FileCopyrightText: 2025 CompanyNameMagicTag
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+/*
+    NOTE 分层位图原理
+
+    1.  第 0 层（叶子）每位对应一个对象，第 1 层每位对应一个叶子块，
+        第 2 层（顶层，只有一个块）每位对应一个第 1 层块。块为 xf_bitmap_t.
+    1.  上两层各有两份: set 表示下层块非全 0, full 表示下层块全 1.
+        ffs / fls 沿 set 的 1 往下找, ffz 沿 full 的 0 往下找，
+        每层只做一次块内查找，与位数无关，最多访问 3 个块。
+    1.  块为 64 位时最多 64^3 = 256K 位（4K 位以内第 1 层只有一个块），
+        块为 32 位时最多 32K 位。
+    1.  超出 bit_size 的位以及不存在的下层块在上层都记为“非全 1”，
+        ffz 找到后再与 bit_size 比较，因此存储区全 0 就是合法的空位图，
+        可以用 XF_HBITMAP_DEFINE_STATIC 静态定义。
+    1.  本身不加锁，多个上下文共用时由使用者加临界区。
+ */
+
+#ifndef __XF_HBITMAP_H__
+#define __XF_HBITMAP_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "../common/xf_common.h"
+#include "xf_bitmap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/**
+ * @brief 分层位图的最大位数.
+ */
+#define XF_HBITMAP_BIT_SIZE_MAX \
+    ((uint32_t)XF_BITMAP_BLK_BIT_SIZE * XF_BITMAP_BLK_BIT_SIZE * XF_BITMAP_BLK_BIT_SIZE)
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief 分层位图.
+ */
+typedef struct xf_hbitmap {
+    xf_bitmap_t            *p_leaf;         /*!< 第 0 层 */
+    xf_bitmap_t            *p_mid_set;      /*!< 第 1 层，叶子块非全 0 */
+    xf_bitmap_t            *p_mid_full;     /*!< 第 1 层，叶子块全 1 */
+    xf_bitmap_t             top_set;        /*!< 第 2 层，第 1 层 set 块非全 0 */
+    xf_bitmap_t             top_full;       /*!< 第 2 层，第 1 层 full 块全 1 */
+    uint32_t                bit_size;       /*!< 位数 */
+} xf_hbitmap_t;
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief 初始化分层位图，所有位清零.
+ *
+ * @param p_hbm     分层位图。
+ * @param p_leaf    第 0 层存储区，至少 XF_HBITMAP_LEAF_NUM(bit_size) 个块。
+ * @param p_mid     第 1 层存储区，至少 2 * XF_HBITMAP_MID_NUM(bit_size) 个块。
+ * @param bit_size  位数，不超过 XF_HBITMAP_BIT_SIZE_MAX.
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    参数无效
+ */
+xf_err_t xf_hbitmap_init(xf_hbitmap_t *p_hbm,
+                         xf_bitmap_t *p_leaf, xf_bitmap_t *p_mid, uint32_t bit_size);
+
+/**
+ * @brief 置 1, O(1).
+ *
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    参数无效或位序号越界
+ */
+xf_err_t xf_hbitmap_set1(xf_hbitmap_t *p_hbm, uint32_t bit);
+
+/**
+ * @brief 清 0, O(1).
+ *
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    参数无效或位序号越界
+ */
+xf_err_t xf_hbitmap_set0(xf_hbitmap_t *p_hbm, uint32_t bit);
+
+/**
+ * @brief 读取一位. 参数无效或越界时返回 FALSE.
+ */
+bool_t xf_hbitmap_get(const xf_hbitmap_t *p_hbm, uint32_t bit);
+
+/**
+ * @brief 从低到高找第一个 1, O(1).
+ *
+ * @return int32_t  位序号，找不到时返回 -1.
+ */
+int32_t xf_hbitmap_ffs(const xf_hbitmap_t *p_hbm);
+
+/**
+ * @brief 从高到低找第一个 1, O(1).
+ *
+ * @return int32_t  位序号，找不到时返回 -1.
+ */
+int32_t xf_hbitmap_fls(const xf_hbitmap_t *p_hbm);
+
+/**
+ * @brief 从低到高找第一个 0, O(1).
+ *
+ * @return int32_t  位序号，全 1 时返回 -1.
+ */
+int32_t xf_hbitmap_ffz(const xf_hbitmap_t *p_hbm);
+
+/**
+ * @brief 找序号不小于 bit 的第一个 1, O(1). 用于从低到高遍历。
+ *
+ * @return int32_t  位序号，找不到时返回 -1.
+ */
+int32_t xf_hbitmap_find_next_set(const xf_hbitmap_t *p_hbm, uint32_t bit);
+
+/**
+ * @brief 找序号不大于 bit 的最后一个 1, O(1). 用于从高到低遍历。
+ *
+ * @return int32_t  位序号，找不到时返回 -1.
+ */
+int32_t xf_hbitmap_find_prev_set(const xf_hbitmap_t *p_hbm, uint32_t bit);
+
+/* ==================== [Macros] ============================================ */
+
+/**
+ * @brief 第 0 层块数.
+ */
+#define XF_HBITMAP_LEAF_NUM(_bit_size)  XF_BITMAP_GET_BLK_SIZE(_bit_size)
+
+/**
+ * @brief 第 1 层块数（set 与 full 各一份）.
+ */
+#define XF_HBITMAP_MID_NUM(_bit_size)   XF_BITMAP_GET_BLK_SIZE(XF_HBITMAP_LEAF_NUM(_bit_size))
+
+/**
+ * @brief 分层位图静态初始化，与 xf_hbitmap_init() 等效，但要求存储区已清零且不检查参数.
+ */
+#define XF_HBITMAP_INIT(_p_leaf, _p_mid, _bit_size) \
+    { (_p_leaf), (_p_mid), (_p_mid) + XF_HBITMAP_MID_NUM(_bit_size), 0, 0, (uint32_t)(_bit_size) }
+
+/**
+ * @brief 定义静态分层位图 _name 及其存储区.
+ *
+ * @code{c}
+ * XF_HBITMAP_DEFINE_STATIC(s_obj_hbm, 1000);
+ * idx = xf_hbitmap_ffz(&s_obj_hbm);
+ * @endcode
+ */
+#define XF_HBITMAP_DEFINE_STATIC(_name, _bit_size) \
+    STATIC_ASSERT(((_bit_size) > 0) && ((_bit_size) <= XF_HBITMAP_BIT_SIZE_MAX)); \
+    static xf_bitmap_t _name##_leaf[XF_HBITMAP_LEAF_NUM(_bit_size)]; \
+    static xf_bitmap_t _name##_mid[2 * XF_HBITMAP_MID_NUM(_bit_size)]; \
+    static xf_hbitmap_t _name = XF_HBITMAP_INIT(_name##_leaf, _name##_mid, _bit_size)
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* __XF_HBITMAP_H__ */
@@ -0,0 +1,181 @@
+/**
+ * @file xf_mempool.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 定长块内存池。
+ * @version 1.0
+ * @date 2025-07-08
+ *
+ * SPDX-FileCopyrightText: 2025 CompanyNameMagicTag
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_mempool.h"
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+/* ==================== [Static Variables] ================================== */
+
+/* ==================== [Macros] ============================================ */
+
+/* 空闲块的前 sizeof(void *) 字节存放下一个空闲块的地址 */
+#define XF_MEMPOOL_NEXT(_p_blk)         (*(void **)(_p_blk))
+
+/* ==================== [Global Functions] ================================== */
+
+xf_err_t xf_mempool_init(xf_mempool_t *p_mp, void *p_mem, size_t blk_size, size_t blk_num)
+{
+    if ((p_mp == NULL) || (p_mem == NULL)
+            || (blk_size < sizeof(void *)) || ((blk_size % sizeof(void *)) != 0)
+            || (blk_size > (xf_mempool_size_t)~(xf_mempool_size_t)0)
+            || (blk_num == 0) || (blk_num > (xf_mempool_size_t)~(xf_mempool_size_t)0)
+            || (((uintptr_t)p_mem % sizeof(void *)) != 0)) {
+        return XF_ERR_INVALID_ARG;
+    }
+    p_mp->p_mem = (uint8_t *)p_mem;
+    p_mp->blk_size = (xf_mempool_size_t)blk_size;
+    p_mp->blk_num = (xf_mempool_size_t)blk_num;
+#if XF_MEMPOOL_ENABLE_STATS
+    p_mp->used_max = 0;
+    p_mp->fail_cnt = 0;
+#endif
+    return xf_mempool_reset(p_mp);
+}
+
+xf_err_t xf_mempool_reset(xf_mempool_t *p_mp)
+{
+    if (p_mp == NULL) {
+        return XF_ERR_INVALID_ARG;
+    }
+    p_mp->p_free = NULL;
+    p_mp->blk_unused = 0;
+    p_mp->used = 0;
+    return XF_OK;
+}
+
+void *xf_mempool_alloc(xf_mempool_t *p_mp)
+{
+    void *p_blk;
+    if (p_mp == NULL) {
+        return NULL;
+    }
+    if (p_mp->p_free != NULL) {
+        p_blk = p_mp->p_free;
+        p_mp->p_free = XF_MEMPOOL_NEXT(p_blk);
+    } else if (p_mp->blk_unused < p_mp->blk_num) {
+        p_blk = &p_mp->p_mem[(size_t)p_mp->blk_unused * p_mp->blk_size];
+        p_mp->blk_unused++;
+    } else {
+#if XF_MEMPOOL_ENABLE_STATS
+        p_mp->fail_cnt++;
+#endif
+        return NULL;
+    }
+    p_mp->used++;
+#if XF_MEMPOOL_ENABLE_STATS
+    if (p_mp->used > p_mp->used_max) {
+        p_mp->used_max = p_mp->used;
+    }
+#endif
+    return p_blk;
+}
+
+xf_err_t xf_mempool_free(xf_mempool_t *p_mp, void *p_blk)
+{
+    int32_t idx = xf_mempool_blk_to_idx(p_mp, p_blk);
+    if ((idx < 0) || (idx >= (int32_t)p_mp->blk_unused) || (p_mp->used == 0)) {
+        return XF_ERR_INVALID_ARG;
+    }
+    XF_MEMPOOL_NEXT(p_blk) = p_mp->p_free;
+    p_mp->p_free = p_blk;
+    p_mp->used--;
+    return XF_OK;
+}
+
+void *xf_mempool_alloc_safe(xf_mempool_t *p_mp)
+{
+    void *p_blk;
+    XF_CRIT_STAT();
+    XF_CRIT_ENTRY();
+    p_blk = xf_mempool_alloc(p_mp);
+    XF_CRIT_EXIT();
+    return p_blk;
+}
+
+xf_err_t xf_mempool_free_safe(xf_mempool_t *p_mp, void *p_blk)
+{
+    xf_err_t xf_ret;
+    XF_CRIT_STAT();
+    XF_CRIT_ENTRY();
+    xf_ret = xf_mempool_free(p_mp, p_blk);
+    XF_CRIT_EXIT();
+    return xf_ret;
+}
+
+int32_t xf_mempool_blk_to_idx(const xf_mempool_t *p_mp, const void *p_blk)
+{
+    size_t offset;
+    if ((p_mp == NULL) || (p_blk == NULL)
+            || ((const uint8_t *)p_blk < p_mp->p_mem)) {
+        return -1;
+    }
+    offset = (size_t)((const uint8_t *)p_blk - p_mp->p_mem);
+    if ((offset >= (size_t)p_mp->blk_size * p_mp->blk_num)
+            || ((offset % p_mp->blk_size) != 0)) {
+        return -1;
+    }
+    return (int32_t)(offset / p_mp->blk_size);
+}
+
+void *xf_mempool_idx_to_blk(const xf_mempool_t *p_mp, size_t idx)
+{
+    if ((p_mp == NULL) || (idx >= p_mp->blk_num)) {
+        return NULL;
+    }
+    return &p_mp->p_mem[idx * p_mp->blk_size];
+}
+
+xf_mempool_size_t xf_mempool_get_free_num(const xf_mempool_t *p_mp)
+{
+    if (p_mp == NULL) {
+        return 0;
+    }
+    return (xf_mempool_size_t)(p_mp->blk_num - p_mp->used);
+}
+
+#if XF_MEMPOOL_ENABLE_STATS
+xf_err_t xf_mempool_get_stats(const xf_mempool_t *p_mp, xf_mempool_stats_t *p_stats)
+{
+    XF_CRIT_STAT();
+    if ((p_mp == NULL) || (p_stats == NULL)) {
+        return XF_ERR_INVALID_ARG;
+    }
+    XF_CRIT_ENTRY();
+    p_stats->used = p_mp->used;
+    p_stats->used_max = p_mp->used_max;
+    p_stats->fail_cnt = p_mp->fail_cnt;
+    XF_CRIT_EXIT();
+    return XF_OK;
+}
+
+xf_err_t xf_mempool_reset_stats(xf_mempool_t *p_mp)
+{
+    XF_CRIT_STAT();
+    if (p_mp == NULL) {
+        return XF_ERR_INVALID_ARG;
+    }
+    XF_CRIT_ENTRY();
+    p_mp->used_max = p_mp->used;
+    p_mp->fail_cnt = 0;
+    XF_CRIT_EXIT();
+    return XF_OK;
+}
+#endif
+
+/* ==================== [Static Functions] ================================== */
@@ -0,0 +1,192 @@
+/**
+ * @file xf_mempool.h
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 定长块内存池。
+ * @version 1.0
+ * @date 2025-07-08
+ *
+ * SPDX-FileCopyrightText: 2025 CompanyNameMagicTag
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+/*
+    NOTE 定长块内存池原理
+
+    1.  存储区由使用者提供，划分为 blk_num 个 blk_size 字节的块。
+    1.  空闲块通过块内前 sizeof(void *) 字节串成单链表（侵入式），
+        分配、释放都只操作链表头，均为 O(1)，不需要额外的位图或标记。
+    1.  从未分配过的块不进链表，而是由 blk_unused 按顺序切出，
+        因此内存池不需要逐块初始化，可以用 XF_MEMPOOL_INIT 静态初始化，
+        刚初始化的内存池按地址升序分配。
+    1.  块被释放后前 sizeof(void *) 字节会被改写，其余内容保持不变。
+        使用者若以块内某个成员判断块是否在用，该成员不能位于块的开头。
+ */
+
+#ifndef __XF_MEMPOOL_H__
+#define __XF_MEMPOOL_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "../common/xf_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef uint16_t xf_mempool_size_t;
+
+/**
+ * @brief 定长块内存池。
+ *
+ * 本身不加锁，多个上下文（包括中断）共用时使用 xf_mempool_alloc_safe()
+ * 和 xf_mempool_free_safe().
+ */
+typedef struct xf_mempool {
+    uint8_t                *p_mem;          /*!< 存储区 */
+    void                   *p_free;         /*!< 空闲链表头 */
+    xf_mempool_size_t       blk_size;       /*!< 块大小（字节） */
+    xf_mempool_size_t       blk_num;        /*!< 块个数 */
+    xf_mempool_size_t       blk_unused;     /*!< 此序号及之后的块从未分配过 */
+    xf_mempool_size_t       used;           /*!< 已分配的块数 */
+#if XF_MEMPOOL_ENABLE_STATS
+    xf_mempool_size_t       used_max;       /*!< 已分配块数的历史最大值 */
+    uint32_t                fail_cnt;       /*!< 因无空闲块而分配失败的次数 */
+#endif
+} xf_mempool_t;
+
+#if XF_MEMPOOL_ENABLE_STATS
+/**
+ * @brief 内存池统计信息，见 xf_mempool_get_stats().
+ */
+typedef struct xf_mempool_stats {
+    xf_mempool_size_t       used;           /*!< 已分配的块数 */
+    xf_mempool_size_t       used_max;       /*!< 已分配块数的历史最大值 */
+    uint32_t                fail_cnt;       /*!< 因无空闲块而分配失败的次数 */
+} xf_mempool_stats_t;
+#endif
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief 初始化内存池.
+ *
+ * @param p_mp      内存池。
+ * @param p_mem     存储区，至少 blk_size * blk_num 字节，按指针对齐。
+ * @param blk_size  块大小（字节），不小于 sizeof(void *) 且是其整数倍，
+ *                  见 XF_MEMPOOL_BLK_SIZE.
+ * @param blk_num   块个数。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    参数无效
+ */
+xf_err_t xf_mempool_init(xf_mempool_t *p_mp, void *p_mem, size_t blk_size, size_t blk_num);
+
+/**
+ * @brief 释放所有块. 统计信息中的历史值保留。
+ */
+xf_err_t xf_mempool_reset(xf_mempool_t *p_mp);
+
+/**
+ * @brief 分配一块, O(1). 块的内容未初始化。
+ *
+ * @return void*    块地址，无空闲块时返回 NULL.
+ */
+void *xf_mempool_alloc(xf_mempool_t *p_mp);
+
+/**
+ * @brief 释放一块, O(1). 不检测重复释放。
+ *
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    不是本内存池分配出的块
+ */
+xf_err_t xf_mempool_free(xf_mempool_t *p_mp, void *p_blk);
+
+/**
+ * @brief 在临界区（XF_CRIT_ENTRY）内分配，可在中断中调用.
+ */
+void *xf_mempool_alloc_safe(xf_mempool_t *p_mp);
+
+/**
+ * @brief 在临界区（XF_CRIT_ENTRY）内释放，可在中断中调用.
+ */
+xf_err_t xf_mempool_free_safe(xf_mempool_t *p_mp, void *p_blk);
+
+/**
+ * @brief 块地址转序号.
+ *
+ * @return int32_t  序号，不是本内存池的块时返回 -1.
+ */
+int32_t xf_mempool_blk_to_idx(const xf_mempool_t *p_mp, const void *p_blk);
+
+/**
+ * @brief 序号转块地址. 不检查块是否已分配。
+ *
+ * @return void*    块地址，序号越界时返回 NULL.
+ */
+void *xf_mempool_idx_to_blk(const xf_mempool_t *p_mp, size_t idx);
+
+/**
+ * @brief 获取空闲块数.
+ */
+xf_mempool_size_t xf_mempool_get_free_num(const xf_mempool_t *p_mp);
+
+#if XF_MEMPOOL_ENABLE_STATS
+/**
+ * @brief 获取统计信息.
+ */
+xf_err_t xf_mempool_get_stats(const xf_mempool_t *p_mp, xf_mempool_stats_t *p_stats);
+
+/**
+ * @brief 清零历史最大值及失败次数，历史最大值从当前已分配块数重新开始.
+ */
+xf_err_t xf_mempool_reset_stats(xf_mempool_t *p_mp);
+#endif
+
+/* ==================== [Macros] ============================================ */
+
+/**
+ * @brief 把对象大小向上取整为合法的块大小.
+ */
+#define XF_MEMPOOL_BLK_SIZE(_size) \
+    ((((_size) < sizeof(void *)) ? sizeof(void *) : \
+      (((_size) + sizeof(void *) - 1U) / sizeof(void *) * sizeof(void *))))
+
+/**
+ * @brief 内存池静态初始化.
+ *
+ * 与 xf_mempool_init() 等效，但不检查参数。
+ * _blk_size 通常为 sizeof(元素类型)，元素中含有指针时总是合法的。
+ *
+ * @code{c}
+ * static my_obj_t s_obj_pool[8];
+ * static xf_mempool_t s_obj_mp = XF_MEMPOOL_INIT(s_obj_pool, sizeof(my_obj_t), 8);
+ * @endcode
+ */
+#if XF_MEMPOOL_ENABLE_STATS
+#   define XF_MEMPOOL_INIT(_p_mem, _blk_size, _blk_num) \
+        { (uint8_t *)(_p_mem), NULL, (xf_mempool_size_t)(_blk_size), (xf_mempool_size_t)(_blk_num), 0, 0, 0, 0 }
+#else
+#   define XF_MEMPOOL_INIT(_p_mem, _blk_size, _blk_num) \
+        { (uint8_t *)(_p_mem), NULL, (xf_mempool_size_t)(_blk_size), (xf_mempool_size_t)(_blk_num), 0, 0 }
+#endif
+
+/**
+ * @brief 定义静态内存池 _name 及其存储区.
+ *
+ * 存储区按 uintptr_t 对齐，块中有对齐要求更高的成员时请自行定义存储区。
+ */
+#define XF_MEMPOOL_DEFINE_STATIC(_name, _blk_size, _blk_num) \
+    static uintptr_t _name##_mem[XF_MEMPOOL_BLK_SIZE(_blk_size) / sizeof(uintptr_t) * (_blk_num)]; \
+    static xf_mempool_t _name = XF_MEMPOOL_INIT(_name##_mem, XF_MEMPOOL_BLK_SIZE(_blk_size), _blk_num)
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* __XF_MEMPOOL_H__ */
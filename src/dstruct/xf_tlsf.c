@@ -0,0 +1,494 @@
+/**
+ * @file xf_tlsf.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief TLSF（两级分离适配）变长内存分配器。
+ * @version 1.0
+ * @date 2025-07-09
+ *
+ * SPDX-FileCopyrightText: 2025 CompanyNameMagicTag
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_tlsf.h"
+#include "../algo/xf_arithmetic.h"
+#include "../std/xf_string.h"
+
+/* ==================== [Defines] =========================================== */
+
+/* 块容量及用户地址按字长对齐，容量的低 2 位用作标志 */
+#define XF_TLSF_ALIGN_SIZE              (sizeof(void *))
+#define XF_TLSF_ALIGN_LOG2              ((sizeof(void *) == 8U) ? 3U : 2U)
+
+#define XF_TLSF_SL_COUNT                (1U << XF_TLSF_SL_INDEX_COUNT_LOG2)
+/* 小于 XF_TLSF_SMALL_BLK_SIZE 的块都在一级索引 0 中，按字长线性划分 */
+#define XF_TLSF_FL_SHIFT                (XF_TLSF_SL_INDEX_COUNT_LOG2 + XF_TLSF_ALIGN_LOG2)
+#define XF_TLSF_FL_COUNT                (XF_TLSF_FL_INDEX_MAX - XF_TLSF_FL_SHIFT + 1U)
+#define XF_TLSF_SMALL_BLK_SIZE          ((size_t)1 << XF_TLSF_FL_SHIFT)
+
+#define XF_TLSF_BLK_FREE                ((size_t)1U << 0)   /*!< 本块空闲 */
+#define XF_TLSF_BLK_PREV_FREE           ((size_t)1U << 1)   /*!< 物理上的前一块空闲 */
+#define XF_TLSF_BLK_FLAGS               (XF_TLSF_BLK_FREE | XF_TLSF_BLK_PREV_FREE)
+
+/* 已分配块的开销只有 size 一个字 */
+#define XF_TLSF_BLK_OVERHEAD            (sizeof(size_t))
+/* 用户地址相对块地址的偏移 */
+#define XF_TLSF_BLK_START_OFFSET        (xf_offsetof(xf_tlsf_blk_t, size) + sizeof(size_t))
+/* 空闲时要放下两个链表指针及后块的 prev_phys */
+#define XF_TLSF_BLK_SIZE_MIN            (sizeof(xf_tlsf_blk_t) - sizeof(xf_tlsf_blk_t *))
+/* 保证一级索引不越界 */
+#define XF_TLSF_BLK_SIZE_MAX            (((size_t)1 << XF_TLSF_FL_INDEX_MAX) - XF_TLSF_ALIGN_SIZE)
+
+STATIC_ASSERT(sizeof(size_t) == sizeof(void *));
+/* 位图为 uint32_t */
+STATIC_ASSERT((XF_TLSF_SL_INDEX_COUNT_LOG2 >= 1) && (XF_TLSF_SL_INDEX_COUNT_LOG2 <= 5));
+STATIC_ASSERT((XF_TLSF_FL_INDEX_MAX > (XF_TLSF_SL_INDEX_COUNT_LOG2 + 3)) && (XF_TLSF_FL_INDEX_MAX <= 30));
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief 块头.
+ *
+ * 块地址指向 prev_phys, 但 prev_phys 位于前一块的最后一个字，只在前块空闲时有效；
+ * 用户地址从 next_free 开始，已分配块的 next_free / prev_free 属于用户数据。
+ */
+typedef struct xf_tlsf_blk {
+    struct xf_tlsf_blk     *prev_phys;      /*!< 物理上的前一块，仅前块空闲时有效 */
+    size_t                  size;           /*!< 容量（字节），低 2 位为标志 */
+    struct xf_tlsf_blk     *next_free;      /*!< 空闲链表的下一块，仅空闲时有效 */
+    struct xf_tlsf_blk     *prev_free;      /*!< 空闲链表的上一块，仅空闲时有效 */
+} xf_tlsf_blk_t;
+
+struct xf_tlsf {
+    uint32_t                fl_bm;                                      /*!< 一级位图 */
+    uint32_t                sl_bm[XF_TLSF_FL_COUNT];                    /*!< 二级位图 */
+    xf_tlsf_blk_t          *blks[XF_TLSF_FL_COUNT][XF_TLSF_SL_COUNT];   /*!< 空闲链表头 */
+    xf_tlsf_blk_t          *p_first;        /*!< 第一块 */
+    xf_tlsf_blk_t          *p_last;         /*!< 末尾容量为 0 的哨兵块，始终视为已分配 */
+    size_t                  size_used;
+    size_t                  size_used_max;
+    uint32_t                blk_used;
+    uint32_t                fail_cnt;
+};
+
+/* ==================== [Static Prototypes] ================================= */
+
+static uint32_t xf_tlsf_fls(size_t size);
+static void xf_tlsf_mapping_insert(size_t size, uint32_t *p_fl, uint32_t *p_sl);
+static void xf_tlsf_mapping_search(size_t size, uint32_t *p_fl, uint32_t *p_sl);
+static xf_tlsf_blk_t *xf_tlsf_find_suitable(xf_tlsf_t *p_tlsf, uint32_t *p_fl, uint32_t *p_sl);
+static void xf_tlsf_remove_free(xf_tlsf_t *p_tlsf, xf_tlsf_blk_t *blk, uint32_t fl, uint32_t sl);
+static void xf_tlsf_insert_free(xf_tlsf_t *p_tlsf, xf_tlsf_blk_t *blk, uint32_t fl, uint32_t sl);
+static void xf_tlsf_remove(xf_tlsf_t *p_tlsf, xf_tlsf_blk_t *blk);
+static void xf_tlsf_insert(xf_tlsf_t *p_tlsf, xf_tlsf_blk_t *blk);
+static xf_tlsf_blk_t *xf_tlsf_link_next(xf_tlsf_blk_t *blk);
+static xf_tlsf_blk_t *xf_tlsf_ptr_to_blk_checked(const xf_tlsf_t *p_tlsf, const void *ptr);
+static xf_err_t xf_tlsf_check_bins(const xf_tlsf_t *p_tlsf, uint32_t blk_free);
+
+/* ==================== [Static Variables] ================================== */
+
+/* ==================== [Macros] ============================================ */
+
+#define XF_TLSF_BLK_SIZE(_blk)          ((_blk)->size & ~XF_TLSF_BLK_FLAGS)
+#define XF_TLSF_BLK_IS_FREE(_blk)       (((_blk)->size & XF_TLSF_BLK_FREE) != 0U)
+#define XF_TLSF_BLK_IS_PREV_FREE(_blk)  (((_blk)->size & XF_TLSF_BLK_PREV_FREE) != 0U)
+#define XF_TLSF_BLK_TO_PTR(_blk)        ((void *)((uint8_t *)(_blk) + XF_TLSF_BLK_START_OFFSET))
+#define XF_TLSF_PTR_TO_BLK(_ptr)        ((xf_tlsf_blk_t *)((uint8_t *)(_ptr) - XF_TLSF_BLK_START_OFFSET))
+/* 后块的 prev_phys 与本块最后一个字重叠 */
+#define XF_TLSF_BLK_NEXT(_blk)          ((xf_tlsf_blk_t *)((uint8_t *)XF_TLSF_BLK_TO_PTR(_blk) \
+                                            + XF_TLSF_BLK_SIZE(_blk) - XF_TLSF_BLK_OVERHEAD))
+
+#define XF_TLSF_ALIGN_UP(_x)            (((_x) + (XF_TLSF_ALIGN_SIZE - 1U)) & ~(XF_TLSF_ALIGN_SIZE - 1U))
+#define XF_TLSF_ALIGN_DOWN(_x)          ((_x) & ~(XF_TLSF_ALIGN_SIZE - 1U))
+
+/* ==================== [Global Functions] ================================== */
+
+xf_tlsf_t *xf_tlsf_create(void *p_mem, size_t size)
+{
+    xf_tlsf_t *p_tlsf;
+    xf_tlsf_blk_t *blk;
+    uintptr_t start;
+    uintptr_t end;
+    size_t blk_size;
+    if ((p_mem == NULL) || (size == 0)) {
+        return NULL;
+    }
+    start = XF_TLSF_ALIGN_UP((uintptr_t)p_mem);
+    end = XF_TLSF_ALIGN_DOWN((uintptr_t)p_mem + size);
+    /* 控制结构 + 第一块的块头 + 最小块 + 哨兵块的 size */
+    if ((end <= start)
+            || ((end - start) < (XF_TLSF_ALIGN_UP(sizeof(xf_tlsf_t))
+                                 + XF_TLSF_BLK_START_OFFSET + XF_TLSF_BLK_SIZE_MIN + XF_TLSF_BLK_OVERHEAD))) {
+        return NULL;
+    }
+    p_tlsf = (xf_tlsf_t *)start;
+    xf_memset(p_tlsf, 0, sizeof(xf_tlsf_t));
+    blk = (xf_tlsf_blk_t *)(start + XF_TLSF_ALIGN_UP(sizeof(xf_tlsf_t)));
+    blk_size = (size_t)(end - (uintptr_t)blk) - XF_TLSF_BLK_START_OFFSET - XF_TLSF_BLK_OVERHEAD;
+    if (blk_size > XF_TLSF_BLK_SIZE_MAX) {
+        blk_size = XF_TLSF_BLK_SIZE_MAX;
+    }
+    blk->size = blk_size | XF_TLSF_BLK_FREE;
+    p_tlsf->p_first = blk;
+    p_tlsf->p_last = xf_tlsf_link_next(blk);
+    p_tlsf->p_last->size = 0 | XF_TLSF_BLK_PREV_FREE;
+    xf_tlsf_insert(p_tlsf, blk);
+    return p_tlsf;
+}
+
+void *xf_tlsf_malloc(xf_tlsf_t *p_tlsf, size_t size)
+{
+    xf_tlsf_blk_t *blk;
+    xf_tlsf_blk_t *rest;
+    uint32_t fl;
+    uint32_t sl;
+    size_t adj;
+    if ((p_tlsf == NULL) || (size == 0)) {
+        return NULL;
+    }
+    if (size > XF_TLSF_BLK_SIZE_MAX) {
+        goto l_fail;
+    }
+    adj = XF_TLSF_ALIGN_UP(size);
+    if (adj < XF_TLSF_BLK_SIZE_MIN) {
+        adj = XF_TLSF_BLK_SIZE_MIN;
+    }
+    xf_tlsf_mapping_search(adj, &fl, &sl);
+    if (fl >= XF_TLSF_FL_COUNT) {
+        goto l_fail;
+    }
+    blk = xf_tlsf_find_suitable(p_tlsf, &fl, &sl);
+    if (blk == NULL) {
+        goto l_fail;
+    }
+    xf_tlsf_remove_free(p_tlsf, blk, fl, sl);
+    /* 多余部分足够成为一个空闲块时拆出 */
+    if (XF_TLSF_BLK_SIZE(blk) >= (adj + sizeof(xf_tlsf_blk_t))) {
+        rest = (xf_tlsf_blk_t *)((uint8_t *)XF_TLSF_BLK_TO_PTR(blk) + adj - XF_TLSF_BLK_OVERHEAD);
+        rest->size = (XF_TLSF_BLK_SIZE(blk) - adj - XF_TLSF_BLK_OVERHEAD) | XF_TLSF_BLK_FREE;
+        blk->size = adj | (blk->size & XF_TLSF_BLK_FLAGS);
+        (void)xf_tlsf_link_next(rest);
+        xf_tlsf_insert(p_tlsf, rest);
+    } else {
+        XF_TLSF_BLK_NEXT(blk)->size &= ~XF_TLSF_BLK_PREV_FREE;
+    }
+    blk->size &= ~XF_TLSF_BLK_FREE;
+    p_tlsf->size_used += XF_TLSF_BLK_SIZE(blk);
+    if (p_tlsf->size_used > p_tlsf->size_used_max) {
+        p_tlsf->size_used_max = p_tlsf->size_used;
+    }
+    p_tlsf->blk_used++;
+    return XF_TLSF_BLK_TO_PTR(blk);
+l_fail:
+    p_tlsf->fail_cnt++;
+    return NULL;
+}
+
+xf_err_t xf_tlsf_free(xf_tlsf_t *p_tlsf, void *ptr)
+{
+    xf_tlsf_blk_t *blk;
+    xf_tlsf_blk_t *next;
+    if (ptr == NULL) {
+        return XF_OK;
+    }
+    blk = xf_tlsf_ptr_to_blk_checked(p_tlsf, ptr);
+    if (blk == NULL) {
+        return XF_ERR_INVALID_ARG;
+    }
+    if (XF_TLSF_BLK_IS_FREE(blk)) {
+        return XF_ERR_INVALID_STATE;
+    }
+    p_tlsf->size_used -= XF_TLSF_BLK_SIZE(blk);
+    p_tlsf->blk_used--;
+    blk->size |= XF_TLSF_BLK_FREE;
+    next = xf_tlsf_link_next(blk);
+    next->size |= XF_TLSF_BLK_PREV_FREE;
+    /* 与前后空闲块合并，被合并块的块头成为合并后块的数据 */
+    if (XF_TLSF_BLK_IS_PREV_FREE(blk)) {
+        xf_tlsf_blk_t *prev = blk->prev_phys;
+        xf_tlsf_remove(p_tlsf, prev);
+        prev->size += XF_TLSF_BLK_SIZE(blk) + XF_TLSF_BLK_OVERHEAD;
+        blk = prev;
+        next->prev_phys = blk;
+    }
+    if (XF_TLSF_BLK_IS_FREE(next)) {
+        xf_tlsf_remove(p_tlsf, next);
+        blk->size += XF_TLSF_BLK_SIZE(next) + XF_TLSF_BLK_OVERHEAD;
+        (void)xf_tlsf_link_next(blk);
+    }
+    xf_tlsf_insert(p_tlsf, blk);
+    return XF_OK;
+}
+
+void *xf_tlsf_malloc_safe(xf_tlsf_t *p_tlsf, size_t size)
+{
+    void *ptr;
+    XF_CRIT_STAT();
+    XF_CRIT_ENTRY();
+    ptr = xf_tlsf_malloc(p_tlsf, size);
+    XF_CRIT_EXIT();
+    return ptr;
+}
+
+xf_err_t xf_tlsf_free_safe(xf_tlsf_t *p_tlsf, void *ptr)
+{
+    xf_err_t xf_ret;
+    XF_CRIT_STAT();
+    XF_CRIT_ENTRY();
+    xf_ret = xf_tlsf_free(p_tlsf, ptr);
+    XF_CRIT_EXIT();
+    return xf_ret;
+}
+
+size_t xf_tlsf_block_size(const void *ptr)
+{
+    if (ptr == NULL) {
+        return 0;
+    }
+    return XF_TLSF_BLK_SIZE(XF_TLSF_PTR_TO_BLK(ptr));
+}
+
+xf_err_t xf_tlsf_get_stats(const xf_tlsf_t *p_tlsf, xf_tlsf_stats_t *p_stats)
+{
+    const xf_tlsf_blk_t *blk;
+    if ((p_tlsf == NULL) || (p_stats == NULL)) {
+        return XF_ERR_INVALID_ARG;
+    }
+    xf_memset(p_stats, 0, sizeof(xf_tlsf_stats_t));
+    for (blk = p_tlsf->p_first; blk != p_tlsf->p_last; blk = XF_TLSF_BLK_NEXT(blk)) {
+        if (XF_TLSF_BLK_IS_FREE(blk)) {
+            p_stats->size_free += XF_TLSF_BLK_SIZE(blk);
+            if (XF_TLSF_BLK_SIZE(blk) > p_stats->size_free_max) {
+                p_stats->size_free_max = XF_TLSF_BLK_SIZE(blk);
+            }
+            p_stats->blk_free++;
+        }
+    }
+    p_stats->size_used = p_tlsf->size_used;
+    p_stats->size_used_max = p_tlsf->size_used_max;
+    p_stats->blk_used = p_tlsf->blk_used;
+    p_stats->fail_cnt = p_tlsf->fail_cnt;
+    return XF_OK;
+}
+
+xf_err_t xf_tlsf_walk(const xf_tlsf_t *p_tlsf, xf_tlsf_walk_cb_t cb_func, void *user_data)
+{
+    xf_tlsf_blk_t *blk;
+    if ((p_tlsf == NULL) || (cb_func == NULL)) {
+        return XF_ERR_INVALID_ARG;
+    }
+    for (blk = p_tlsf->p_first; blk != p_tlsf->p_last; blk = XF_TLSF_BLK_NEXT(blk)) {
+        cb_func(XF_TLSF_BLK_TO_PTR(blk), XF_TLSF_BLK_SIZE(blk),
+                XF_TLSF_BLK_IS_FREE(blk) ? FALSE : TRUE, user_data);
+    }
+    return XF_OK;
+}
+
+xf_err_t xf_tlsf_check(const xf_tlsf_t *p_tlsf)
+{
+    const xf_tlsf_blk_t *blk;
+    const xf_tlsf_blk_t *prev = NULL;
+    const xf_tlsf_blk_t *next;
+    size_t size_used = 0;
+    uint32_t blk_used = 0;
+    uint32_t blk_free = 0;
+    if (p_tlsf == NULL) {
+        return XF_ERR_INVALID_ARG;
+    }
+    /* 物理块链 */
+    for (blk = p_tlsf->p_first; blk != p_tlsf->p_last; blk = next) {
+        size_t size = XF_TLSF_BLK_SIZE(blk);
+        bool_t prev_free = ((prev != NULL) && XF_TLSF_BLK_IS_FREE(prev)) ? TRUE : FALSE;
+        if ((size < XF_TLSF_BLK_SIZE_MIN) || (size > XF_TLSF_BLK_SIZE_MAX)
+                || ((size & (XF_TLSF_ALIGN_SIZE - 1U)) != 0)) {
+            return XF_ERR_INVALID_CHECK;
+        }
+        next = XF_TLSF_BLK_NEXT(blk);
+        if ((next <= blk) || (next > p_tlsf->p_last)) {
+            return XF_ERR_INVALID_CHECK;
+        }
+        if ((XF_TLSF_BLK_IS_PREV_FREE(blk) ? TRUE : FALSE) != prev_free) {
+            return XF_ERR_INVALID_CHECK;
+        }
+        if (prev_free && ((blk->prev_phys != prev) || XF_TLSF_BLK_IS_FREE(blk))) {
+            /* 相邻空闲块应当已合并 */
+            return XF_ERR_INVALID_CHECK;
+        }
+        if (XF_TLSF_BLK_IS_FREE(blk)) {
+            blk_free++;
+        } else {
+            blk_used++;
+            size_used += size;
+        }
+        prev = blk;
+    }
+    /* 哨兵块 */
+    if ((XF_TLSF_BLK_SIZE(blk) != 0) || XF_TLSF_BLK_IS_FREE(blk)
+            || ((XF_TLSF_BLK_IS_PREV_FREE(blk) ? TRUE : FALSE)
+                != (((prev != NULL) && XF_TLSF_BLK_IS_FREE(prev)) ? TRUE : FALSE))) {
+        return XF_ERR_INVALID_CHECK;
+    }
+    if ((blk_used != p_tlsf->blk_used) || (size_used != p_tlsf->size_used)) {
+        return XF_ERR_INVALID_CHECK;
+    }
+    return xf_tlsf_check_bins(p_tlsf, blk_free);
+}
+
+/* ==================== [Static Functions] ================================== */
+
+/* 最高位 1 的位置，size 不为 0 且小于 2^31 */
+static uint32_t xf_tlsf_fls(size_t size)
+{
+    return 31U - xf_am_clz_u32((uint32_t)size);
+}
+
+/* 容量所在的桶 */
+static void xf_tlsf_mapping_insert(size_t size, uint32_t *p_fl, uint32_t *p_sl)
+{
+    uint32_t fl;
+    if (size < XF_TLSF_SMALL_BLK_SIZE) {
+        *p_fl = 0;
+        *p_sl = (uint32_t)(size / (XF_TLSF_SMALL_BLK_SIZE / XF_TLSF_SL_COUNT));
+        return;
+    }
+    fl = xf_tlsf_fls(size);
+    *p_sl = (uint32_t)(size >> (fl - XF_TLSF_SL_INDEX_COUNT_LOG2)) ^ XF_TLSF_SL_COUNT;
+    *p_fl = fl - XF_TLSF_FL_SHIFT + 1U;
+}
+
+/* 向上取整到下一个桶的下界，该桶及之后的桶中任意块都放得下 size */
+static void xf_tlsf_mapping_search(size_t size, uint32_t *p_fl, uint32_t *p_sl)
+{
+    if (size >= XF_TLSF_SMALL_BLK_SIZE) {
+        size += ((size_t)1 << (xf_tlsf_fls(size) - XF_TLSF_SL_INDEX_COUNT_LOG2)) - 1U;
+    }
+    xf_tlsf_mapping_insert(size, p_fl, p_sl);
+}
+
+static xf_tlsf_blk_t *xf_tlsf_find_suitable(xf_tlsf_t *p_tlsf, uint32_t *p_fl, uint32_t *p_sl)
+{
+    uint32_t fl = *p_fl;
+    uint32_t sl_map = p_tlsf->sl_bm[fl] & (~0U << *p_sl);
+    if (sl_map == 0) {
+        uint32_t fl_map = ((fl + 1U) < 32U) ? (p_tlsf->fl_bm & (~0U << (fl + 1U))) : 0U;
+        if (fl_map == 0) {
+            return NULL;
+        }
+        fl = xf_am_ctz_u32(fl_map);
+        sl_map = p_tlsf->sl_bm[fl];
+    }
+    *p_fl = fl;
+    *p_sl = xf_am_ctz_u32(sl_map);
+    return p_tlsf->blks[fl][*p_sl];
+}
+
+static void xf_tlsf_remove_free(xf_tlsf_t *p_tlsf, xf_tlsf_blk_t *blk, uint32_t fl, uint32_t sl)
+{
+    xf_tlsf_blk_t *prev = blk->prev_free;
+    xf_tlsf_blk_t *next = blk->next_free;
+    if (next != NULL) {
+        next->prev_free = prev;
+    }
+    if (prev != NULL) {
+        prev->next_free = next;
+        return;
+    }
+    p_tlsf->blks[fl][sl] = next;
+    if (next == NULL) {
+        p_tlsf->sl_bm[fl] &= ~(1U << sl);
+        if (p_tlsf->sl_bm[fl] == 0) {
+            p_tlsf->fl_bm &= ~(1U << fl);
+        }
+    }
+}
+
+static void xf_tlsf_insert_free(xf_tlsf_t *p_tlsf, xf_tlsf_blk_t *blk, uint32_t fl, uint32_t sl)
+{
+    xf_tlsf_blk_t *head = p_tlsf->blks[fl][sl];
+    blk->next_free = head;
+    blk->prev_free = NULL;
+    if (head != NULL) {
+        head->prev_free = blk;
+    }
+    p_tlsf->blks[fl][sl] = blk;
+    p_tlsf->fl_bm |= (1U << fl);
+    p_tlsf->sl_bm[fl] |= (1U << sl);
+}
+
+static void xf_tlsf_remove(xf_tlsf_t *p_tlsf, xf_tlsf_blk_t *blk)
+{
+    uint32_t fl;
+    uint32_t sl;
+    xf_tlsf_mapping_insert(XF_TLSF_BLK_SIZE(blk), &fl, &sl);
+    xf_tlsf_remove_free(p_tlsf, blk, fl, sl);
+}
+
+static void xf_tlsf_insert(xf_tlsf_t *p_tlsf, xf_tlsf_blk_t *blk)
+{
+    uint32_t fl;
+    uint32_t sl;
+    xf_tlsf_mapping_insert(XF_TLSF_BLK_SIZE(blk), &fl, &sl);
+    xf_tlsf_insert_free(p_tlsf, blk, fl, sl);
+}
+
+/* 让后块的 prev_phys 指向本块，返回后块 */
+static xf_tlsf_blk_t *xf_tlsf_link_next(xf_tlsf_blk_t *blk)
+{
+    xf_tlsf_blk_t *next = XF_TLSF_BLK_NEXT(blk);
+    next->prev_phys = blk;
+    return next;
+}
+
+static xf_tlsf_blk_t *xf_tlsf_ptr_to_blk_checked(const xf_tlsf_t *p_tlsf, const void *ptr)
+{
+    if ((p_tlsf == NULL)
+            || ((const uint8_t *)ptr < (const uint8_t *)XF_TLSF_BLK_TO_PTR(p_tlsf->p_first))
+            || ((const uint8_t *)ptr >= (const uint8_t *)p_tlsf->p_last)
+            || (((uintptr_t)ptr & (XF_TLSF_ALIGN_SIZE - 1U)) != 0)) {
+        return NULL;
+    }
+    return XF_TLSF_PTR_TO_BLK(ptr);
+}
+
+/* 检查空闲链表与位图，blk_free 为物理遍历得到的空闲块数 */
+static xf_err_t xf_tlsf_check_bins(const xf_tlsf_t *p_tlsf, uint32_t blk_free)
+{
+    const xf_tlsf_blk_t *blk;
+    uint32_t fl;
+    uint32_t sl;
+    uint32_t fl_chk;
+    uint32_t sl_chk;
+    uint32_t cnt = 0;
+    if ((p_tlsf->fl_bm >> (XF_TLSF_FL_COUNT - 1U)) > 1U) {
+        return XF_ERR_INVALID_CHECK;
+    }
+    for (fl = 0; fl < XF_TLSF_FL_COUNT; fl++) {
+        if (((p_tlsf->sl_bm[fl] != 0) ? 1U : 0U) != ((p_tlsf->fl_bm >> fl) & 1U)) {
+            return XF_ERR_INVALID_CHECK;
+        }
+        for (sl = 0; sl < XF_TLSF_SL_COUNT; sl++) {
+            const xf_tlsf_blk_t *prev = NULL;
+            if (((p_tlsf->blks[fl][sl] != NULL) ? 1U : 0U) != ((p_tlsf->sl_bm[fl] >> sl) & 1U)) {
+                return XF_ERR_INVALID_CHECK;
+            }
+            for (blk = p_tlsf->blks[fl][sl]; blk != NULL; blk = blk->next_free) {
+                /* 链表成环或与物理块数不符 */
+                if (++cnt > blk_free) {
+                    return XF_ERR_INVALID_CHECK;
+                }
+                if ((blk < p_tlsf->p_first) || (blk >= p_tlsf->p_last)
+                        || !XF_TLSF_BLK_IS_FREE(blk) || (blk->prev_free != prev)) {
+                    return XF_ERR_INVALID_CHECK;
+                }
+                xf_tlsf_mapping_insert(XF_TLSF_BLK_SIZE(blk), &fl_chk, &sl_chk);
+                if ((fl_chk != fl) || (sl_chk != sl)) {
+                    return XF_ERR_INVALID_CHECK;
+                }
+                prev = blk;
+            }
+        }
+    }
+    return (cnt == blk_free) ? XF_OK : XF_ERR_INVALID_CHECK;
+}
@@ -0,0 +1,149 @@
+/**
+ * @file xf_tlsf.h
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief TLSF（两级分离适配）变长内存分配器。
+ * @version 1.0
+ * @date 2025-07-09
+ *
+ * SPDX-FileCopyrightText: 2025 CompanyNameMagicTag
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+/*
+    NOTE TLSF 原理
+
+    1.  空闲块按大小分到两级桶中：
+        一级索引为大小的最高位（2 的幂区间），
+        二级索引把每个 2 的幂区间再等分为 2^XF_TLSF_SL_INDEX_COUNT_LOG2 份。
+        每个桶是一条空闲块双向链表，两级各有一个位图记录哪些桶非空。
+    1.  分配时把请求大小向上取整到桶的下界，保证桶内任意块都够用，
+        再用 ctz 在位图中找到第一个非空桶，取链表头，多余部分拆出放回；
+        释放时与物理相邻的空闲块合并后放回。
+        两者都只有常数次位运算和链表操作，与堆中块的个数无关，耗时有上限。
+    1.  块头只有 size 一个字长（低 2 位为本块空闲、前块空闲标志），
+        前块空闲时其地址存放在前块的最后一个字中，用于 O(1) 合并。
+ */
+
+#ifndef __XF_TLSF_H__
+#define __XF_TLSF_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "../common/xf_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief TLSF 堆，位于 xf_tlsf_create() 所给区域的开头。
+ */
+typedef struct xf_tlsf xf_tlsf_t;
+
+/**
+ * @brief 堆统计信息，见 xf_tlsf_get_stats().
+ *
+ * 大小均为块的可用容量（字节），不含块头。
+ */
+typedef struct xf_tlsf_stats {
+    size_t                  size_used;      /*!< 已分配块的容量之和 */
+    size_t                  size_used_max;  /*!< size_used 的历史最大值 */
+    size_t                  size_free;      /*!< 空闲块的容量之和 */
+    size_t                  size_free_max;  /*!< 最大空闲块的容量，不代表一定能分配这么大 */
+    uint32_t                blk_used;       /*!< 已分配块数 */
+    uint32_t                blk_free;       /*!< 空闲块数，与 blk_used 比较可估计碎片程度 */
+    uint32_t                fail_cnt;       /*!< 分配失败的次数 */
+} xf_tlsf_stats_t;
+
+/**
+ * @brief xf_tlsf_walk() 的回调.
+ *
+ * @param ptr       块的用户地址。
+ * @param size      块的容量（字节）。
+ * @param used      TRUE: 已分配; FALSE: 空闲.
+ * @param user_data 用户数据。
+ */
+typedef void (*xf_tlsf_walk_cb_t)(void *ptr, size_t size, bool_t used, void *user_data);
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief 在给定区域上创建堆.
+ *
+ * 堆的控制结构放在区域开头，其余部分作为一个空闲块。
+ * 单个块的容量小于 2^XF_TLSF_FL_INDEX_MAX 字节，区域超出部分不使用。
+ *
+ * @param p_mem     区域起始地址。
+ * @param size      区域大小（字节）。
+ * @return xf_tlsf_t*   堆，区域太小或参数无效时返回 NULL.
+ */
+xf_tlsf_t *xf_tlsf_create(void *p_mem, size_t size);
+
+/**
+ * @brief 分配, O(1). 返回的地址按 sizeof(void *) 对齐。
+ *
+ * @return void*    内存地址，size 为 0 或空间不足时返回 NULL.
+ */
+void *xf_tlsf_malloc(xf_tlsf_t *p_tlsf, size_t size);
+
+/**
+ * @brief 释放, O(1).
+ *
+ * @param ptr   xf_tlsf_malloc() 返回的地址，可为 NULL.
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    地址不在堆中
+ *      - XF_ERR_INVALID_STATE  重复释放
+ */
+xf_err_t xf_tlsf_free(xf_tlsf_t *p_tlsf, void *ptr);
+
+/**
+ * @brief 在临界区（XF_CRIT_ENTRY）内分配，可在中断中调用.
+ */
+void *xf_tlsf_malloc_safe(xf_tlsf_t *p_tlsf, size_t size);
+
+/**
+ * @brief 在临界区（XF_CRIT_ENTRY）内释放，可在中断中调用.
+ */
+xf_err_t xf_tlsf_free_safe(xf_tlsf_t *p_tlsf, void *ptr);
+
+/**
+ * @brief 获取已分配块的实际容量（不小于申请的大小）.
+ */
+size_t xf_tlsf_block_size(const void *ptr);
+
+/**
+ * @brief 获取统计信息. 需要遍历所有块, O(n)。
+ */
+xf_err_t xf_tlsf_get_stats(const xf_tlsf_t *p_tlsf, xf_tlsf_stats_t *p_stats);
+
+/**
+ * @brief 按地址顺序遍历所有块. 遍历期间不能分配或释放。
+ */
+xf_err_t xf_tlsf_walk(const xf_tlsf_t *p_tlsf, xf_tlsf_walk_cb_t cb_func, void *user_data);
+
+/**
+ * @brief 检查堆的完整性, O(n).
+ *
+ * 检查物理块链、空闲标志、相邻空闲块是否已合并、
+ * 空闲块是否在正确的桶中，以及位图与桶是否一致。
+ *
+ * @return xf_err_t
+ *      - XF_OK                 完好
+ *      - XF_ERR_INVALID_ARG    参数无效
+ *      - XF_ERR_INVALID_CHECK  堆已损坏（越界写入等）
+ */
+xf_err_t xf_tlsf_check(const xf_tlsf_t *p_tlsf);
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* __XF_TLSF_H__ */
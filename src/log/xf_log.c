@@ -13,11 +13,16 @@
 /* ==================== [Includes] ========================================== */
 
 #include "xf_log.h"
+#include "../std/xf_printf.h"
+
+#if XF_LOG_ENABLE_RUNTIME_LEVEL
+#include "../std/xf_string.h"
+#include "../system/safe/xf_safe.h"
+#endif
 
 #if !XF_LOG_ENABLE_CUSTOM_PORTING
 
 #include <stdio.h>
-#include <stdarg.h>
 
 #endif /* !XF_LOG_ENABLE_CUSTOM_PORTING */
 
@@ -25,6 +30,15 @@
 
 /* ==================== [Typedefs] ========================================== */
 
+#if XF_LOG_ENABLE_RUNTIME_LEVEL
+STATIC_ASSERT((XF_LOG_TAG_CACHE_SIZE & (XF_LOG_TAG_CACHE_SIZE - 1)) == 0);
+
+typedef struct _xf_log_tag_level_t {
+    const char *tag;                    /*!< 标签字符串， NULL 表示空项 */
+    uint8_t level;
+} xf_log_tag_level_t;
+#endif
+
 /* ==================== [Static Prototypes] ================================= */
 
 static const char s_lvl_to_prompt[] = {
@@ -38,6 +52,13 @@ static const char s_lvl_to_prompt[] = {
 
 /* ==================== [Static Variables] ================================== */
 
+#if XF_LOG_ENABLE_RUNTIME_LEVEL
+static xf_log_tag_level_t s_tag_level[XF_LOG_TAG_LEVEL_NUM] = {0};
+static uint8_t s_default_level = XF_LOG_VERBOSE;
+
+xf_log_tag_cache_t xf_log_tag_cache_i[XF_LOG_TAG_CACHE_SIZE] = {0};
+#endif
+
 /* ==================== [Macros] ============================================ */
 
 /* ==================== [Global Functions] ================================== */
@@ -50,8 +71,134 @@ char xf_log_level_to_prompt(uint8_t level)
     return s_lvl_to_prompt[level];
 }
 
+size_t xf_log_format_line_i(char *line, char level, const char *tag,
+                            const char *format, va_list args)
+{
+    /* 末尾保留 "\r\n" */
+    const int size = XF_LOG_LINE_SIZE - 2;
+    int len;
+    int ret;
+    len = xf_snprintf(line, (size_t)size + 1U, "%c (%lu)-%s: ",
+                      xf_log_level_to_prompt(level),
+                      (unsigned long int)xf_tick_to_ms(xf_tick_get_count()), tag);
+    if (len < size) {
+        ret = xf_vsnprintf(&line[len], (size_t)(size - len + 1), format, args);
+        len += ret;
+    }
+    if (len > size) {
+        len = size;
+    }
+    line[len++] = '\r';
+    line[len++] = '\n';
+    line[len] = '\0';
+    return (size_t)len;
+}
+
+#if XF_LOG_ENABLE_RUNTIME_LEVEL
+
+xf_err_t xf_log_set_level(const char *tag, uint8_t level)
+{
+    xf_log_tag_level_t *p_free = NULL;
+    uint8_t i;
+    XF_CRIT_STAT();
+    if (level > XF_LOG_VERBOSE) {
+        return XF_ERR_INVALID_ARG;
+    }
+    XF_CRIT_ENTRY();
+    if (tag == NULL) {
+        s_default_level = level;
+    } else {
+        for (i = 0; i < XF_LOG_TAG_LEVEL_NUM; ++i) {
+            if (s_tag_level[i].tag == NULL) {
+                if (p_free == NULL) {
+                    p_free = &s_tag_level[i];
+                }
+                continue;
+            }
+            if (xf_strcmp(s_tag_level[i].tag, tag) == 0) {
+                break;
+            }
+        }
+        if (i < XF_LOG_TAG_LEVEL_NUM) {
+            s_tag_level[i].level = level;
+        } else if (p_free != NULL) {
+            p_free->tag = tag;
+            p_free->level = level;
+        } else {
+            XF_CRIT_EXIT();
+            return XF_ERR_RESOURCE;
+        }
+    }
+    /* 等级改变后缓存全部失效 */
+    for (i = 0; i < XF_LOG_TAG_CACHE_SIZE; ++i) {
+        xf_log_tag_cache_i[i].tag = NULL;
+    }
+    XF_CRIT_EXIT();
+    return XF_OK;
+}
+
+uint8_t xf_log_get_level(const char *tag)
+{
+    uint8_t i;
+    if (tag != NULL) {
+        for (i = 0; i < XF_LOG_TAG_LEVEL_NUM; ++i) {
+            if ((s_tag_level[i].tag != NULL)
+                    && (xf_strcmp(s_tag_level[i].tag, tag) == 0)) {
+                return s_tag_level[i].level;
+            }
+        }
+    }
+    return s_default_level;
+}
+
+uint8_t xf_log_tag_level_lookup_i(const char *tag)
+{
+    xf_log_tag_cache_t *p_cache;
+    uint8_t level;
+    XF_CRIT_STAT();
+    if (tag == NULL) {
+        return s_default_level;
+    }
+    level = xf_log_get_level(tag);
+    p_cache = &xf_log_tag_cache_i[XF_LOG_TAG_CACHE_IDX(tag)];
+    XF_CRIT_ENTRY();
+    p_cache->level = level;
+    p_cache->tag = tag;
+    XF_CRIT_EXIT();
+    return level;
+}
+
+#endif /* XF_LOG_ENABLE_RUNTIME_LEVEL */
+
+#if XF_LOG_ENABLE_RATELIMIT
+
+bool_t xf_log_ratelimit_i(xf_log_ratelimit_t *p_rl, uint16_t *p_suppressed)
+{
+    uint32_t tick_now = (uint32_t)xf_tick_get_count();
+    *p_suppressed = 0;
+    if ((uint32_t)(tick_now - p_rl->tick_begin)
+            >= (uint32_t)xf_ms_to_tick(XF_LOG_RATELIMIT_INTERVAL_MS)) {
+        /* 新时间窗 */
+        *p_suppressed = p_rl->suppressed;
+        p_rl->tick_begin = tick_now;
+        p_rl->cnt = 0;
+        p_rl->suppressed = 0;
+    }
+    if (p_rl->cnt < XF_LOG_RATELIMIT_BURST) {
+        p_rl->cnt++;
+        return TRUE;
+    }
+    if (p_rl->suppressed < UINT16_MAX) {
+        p_rl->suppressed++;
+    }
+    return FALSE;
+}
+
+#endif /* XF_LOG_ENABLE_RATELIMIT */
+
 #if !XF_LOG_ENABLE_CUSTOM_PORTING
 
+/* 直接输出到 stdout, 不经过行缓冲区，长度不受 XF_LOG_LINE_SIZE 限制 */
 __IMPL void xf_log_printf(const char *format, ...)
 {
     va_list args;
@@ -60,17 +207,17 @@ __IMPL void xf_log_printf(const char *format, ...)
     va_end(args);
 }
 
+#if !XF_LOG_ENABLE_ASYNC
 __IMPL void xf_log_level(char level, const char *tag, const char *format, ...)
 {
+    char line[XF_LOG_LINE_SIZE + 1];
     va_list args;
-    xf_log_printf("%c (%lu)-%s: ",
-                  xf_log_level_to_prompt(level),
-                  (unsigned long int)xf_tick_to_ms(xf_tick_get_count()), tag);
     va_start(args, format);
-    vprintf(format, args);
+    (void)xf_log_format_line_i(line, level, tag, format, args);
     va_end(args);
-    xf_log_printf("\r\n");
+    fputs(line, stdout);
 }
+#endif /* !XF_LOG_ENABLE_ASYNC */
 
 #endif /* XF_LOG_ENABLE_CUSTOM_PORTING */
 
@@ -18,6 +18,8 @@
 #include "../common/xf_common.h"
 #include "../system/tick/xf_tick.h"
 
+#include <stdarg.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -31,8 +33,45 @@ extern "C" {
 #define XF_LOG_DEBUG            (4)
 #define XF_LOG_VERBOSE          (5)
 
+#if XF_LOG_ENABLE_DEFERRED
+/* 延迟日志单条记录的最大参数个数 */
+#define XF_LOG_DEFERRED_ARG_NUM_MAX     8
+/* 记录头中的同步字节，主机端据此定位记录起点 */
+#define XF_LOG_DEFERRED_MAGIC           0x4CU
+#endif
+
+#if XF_LOG_ENABLE_ASYNC
+/* 异步日志缓冲区满时的策略，见 XF_LOG_ASYNC_OVERFLOW_POLICY */
+#define XF_LOG_ASYNC_DROP_NEWEST        0   /*!< 丢弃当前日志 */
+#define XF_LOG_ASYNC_DROP_OLDEST        1   /*!< 丢弃最旧的日志直到放得下 */
+#define XF_LOG_ASYNC_BLOCK              2   /*!< 调用者同步输出最旧的日志直到放得下 */
+#endif
+
 /* ==================== [Typedefs] ========================================== */
 
+#if XF_LOG_ENABLE_RUNTIME_LEVEL
+/**
+ * @brief 标签等级缓存项，以标签指针为键.
+ *
+ * @note 仅供 xf_log_tag_is_enabled() 使用。
+ */
+typedef struct _xf_log_tag_cache_t {
+    const char *tag;                    /*!< 标签指针， NULL 表示空项 */
+    uint8_t level;                      /*!< 该标签当前允许输出的最高等级 */
+} xf_log_tag_cache_t;
+#endif
+
+#if XF_LOG_ENABLE_RATELIMIT
+/**
+ * @brief 限频日志调用点状态，由 XF_LOGx_RL 在调用点静态定义.
+ */
+typedef struct _xf_log_ratelimit_t {
+    uint32_t tick_begin;                /*!< 当前时间窗起点（ tick 低 32 位） */
+    uint16_t cnt;                       /*!< 当前时间窗内已输出条数 */
+    uint16_t suppressed;                /*!< 当前时间窗内被抑制的条数 */
+} xf_log_ratelimit_t;
+#endif
+
 /* ==================== [Global Prototypes] ================================= */
 
 /**
@@ -49,6 +88,140 @@ extern "C" {
  */
 char xf_log_level_to_prompt(uint8_t level);
 
+/**
+ * @brief 按 xf_log_level 的格式生成一行日志: "<等级> (<ms>)-<标签>: <内容>\r\n".
+ *
+ * 超出 XF_LOG_LINE_SIZE 的内容被截断，但总以 "\r\n" 结尾。
+ *
+ * @note 供 xf_log_level 的各个实现使用。
+ *
+ * @param[out] line 输出缓冲区，至少 XF_LOG_LINE_SIZE + 1 字节。
+ * @param level     日志等级。
+ * @param tag       日志标签。
+ * @param format    格式化字符串，由 xf_vsnprintf 处理。
+ * @param args      参数。
+ * @return size_t   行长度（含 "\r\n"，不含 '\0'）。
+ */
+size_t xf_log_format_line_i(char *line, char level, const char *tag,
+                            const char *format, va_list args);
+
+#if XF_LOG_ENABLE_RUNTIME_LEVEL
+/**
+ * @brief 设置标签的运行时日志等级.
+ *
+ * 标签按字符串内容匹配，因此同名的不同指针（如 TAG 与字面量）共享等级。
+ * 设置后标签缓存全部失效，之后每个标签首次输出时重新查找一次。
+ *
+ * @param tag       日志标签，必须是静态存储的字符串。 NULL 表示默认等级，
+ *                  作用于所有未单独设置的标签。
+ * @param level     日志等级， XF_LOG_NONE ~ XF_LOG_VERBOSE.
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_RESOURCE       单独设置的标签已达 XF_LOG_TAG_LEVEL_NUM 个
+ *      - XF_OK                 成功
+ */
+xf_err_t xf_log_set_level(const char *tag, uint8_t level);
+
+/**
+ * @brief 获取标签的运行时日志等级.
+ *
+ * @param tag       日志标签， NULL 表示默认等级。
+ * @return uint8_t  日志等级。
+ */
+uint8_t xf_log_get_level(const char *tag);
+
+/**
+ * @brief 缓存未命中时查找标签等级并写入缓存.
+ *
+ * @note 仅供 xf_log_tag_is_enabled() 使用。
+ *
+ * @param tag       日志标签。
+ * @return uint8_t  日志等级。
+ */
+uint8_t xf_log_tag_level_lookup_i(const char *tag);
+
+extern xf_log_tag_cache_t xf_log_tag_cache_i[XF_LOG_TAG_CACHE_SIZE];
+#endif
+
+#if XF_LOG_ENABLE_RATELIMIT
+/**
+ * @brief 限频检查.
+ *
+ * @note 仅供 XF_LOGx_RL 使用。
+ *
+ * @param p_rl              调用点状态。
+ * @param[out] p_suppressed 允许输出时，返回上一时间窗内被抑制的条数，需先输出汇总。
+ * @return bool_t           是否允许输出。
+ */
+bool_t xf_log_ratelimit_i(xf_log_ratelimit_t *p_rl, uint16_t *p_suppressed);
+#endif
+
+#if XF_LOG_ENABLE_DEFERRED
+/**
+ * @brief 记录一条延迟日志，不做任何格式化.
+ *
+ * 记录由 (4 + arg_num) 个 uintptr_t 组成：
+ * format 地址、 tag 地址、 tick 、
+ * (MAGIC << 24) | (arg_num << 8) | level, 之后是各个参数。
+ * 缓冲区剩余空间不足时丢弃整条记录。
+ *
+ * @note 通常不直接调用，开启 XF_LOG_ENABLE_DEFERRED 后由 XF_LOGx 调用。
+ *
+ * @param level         日志等级。
+ * @param tag           日志标签，必须位于只读数据段。
+ * @param format        格式化字符串，必须位于只读数据段。
+ * @param arg_num       参数个数，不超过 XF_LOG_DEFERRED_ARG_NUM_MAX.
+ * @param ...           参数，均为 uintptr_t.
+ */
+void xf_log_deferred(char level, const char *tag, const char *format, uint8_t arg_num, ...);
+
+/**
+ * @brief 从延迟日志缓冲区中取出原始数据，以便发送到主机.
+ *
+ * @param[out] p_buf    输出缓冲区。
+ * @param size          输出缓冲区大小（字节），按 sizeof(uintptr_t) 向下取整。
+ * @return size_t       实际取出的字节数。
+ */
+size_t xf_log_deferred_read(void *p_buf, size_t size);
+
+/**
+ * @brief 获取因缓冲区满而丢弃的延迟日志条数.
+ *
+ * @return uint32_t     丢弃条数。
+ */
+uint32_t xf_log_deferred_get_dropped(void);
+#endif
+
+#if XF_LOG_ENABLE_ASYNC
+/**
+ * @brief 创建异步日志输出任务.
+ *
+ * 任务每个 tick 把缓冲区中的日志通过 xf_log_printf 输出一次。
+ * 也可以不创建任务，改为在空闲时调用 xf_log_async_flush().
+ *
+ * @note 必须在 xf_task_sched_init() 之后调用。
+ *
+ * @return xf_err_t
+ *      - XF_ERR_RESOURCE       任务池已满
+ *      - XF_OK                 成功
+ */
+xf_err_t xf_log_async_start(void);
+
+/**
+ * @brief 输出异步日志缓冲区中的全部日志.
+ *
+ * @return uint32_t     本次输出的日志条数。
+ */
+uint32_t xf_log_async_flush(void);
+
+/**
+ * @brief 获取因缓冲区满而丢弃的异步日志条数.
+ *
+ * @return uint32_t     丢弃条数。
+ */
+uint32_t xf_log_async_get_dropped(void);
+#endif
+
 /* ==================== [Macros] ============================================ */
 
 __EXT_IMPL void xf_log_printf(const char *format, ...);
@@ -60,6 +233,90 @@ __EXT_IMPL void xf_log_level(char level, const char *tag, const char *format, ..
 #define XF_MLOG_DEFINE_THIS_FILE()          static const char *const MTAG = (__FILENAME__)
 #define XF_MLOG_DEFINE()                    XF_MLOG_DEFINE_THIS_FILE()
 
+#if XF_LOG_ENABLE_RUNTIME_LEVEL
+#   define XF_LOG_TAG_CACHE_IDX(tag)    \
+        ((((uintptr_t)(tag)) ^ (((uintptr_t)(tag)) >> 4)) & (XF_LOG_TAG_CACHE_SIZE - 1U))
+
+/**
+ * @brief 检查标签在运行时是否允许输出该等级的日志.
+ *
+ * 命中缓存时只有一次指针比较和一次等级比较，在格式化之前调用。
+ * 空闲或失效的缓存项 tag 为 NULL, 因此 NULL 标签不查缓存，直接使用默认等级。
+ *
+ * @param level     日志等级。
+ * @param tag       日志标签。
+ * @return bool_t   是否允许输出。
+ */
+__STATIC_INLINE bool_t xf_log_tag_is_enabled(uint8_t level, const char *tag)
+{
+    const xf_log_tag_cache_t *p_cache = &xf_log_tag_cache_i[XF_LOG_TAG_CACHE_IDX(tag)];
+    if ((tag != NULL) && (p_cache->tag == tag)) {
+        return (level <= p_cache->level);
+    }
+    return (level <= xf_log_tag_level_lookup_i(tag));
+}
+#endif
+
+#if XF_LOG_ENABLE_DEFERRED
+/*
+    延迟模式下参数在调用处逐个转为 uintptr_t, 因此只支持整数、字符及指针参数，
+    %s 只能指向只读数据段中的字符串（主机端从 ELF 中解析）。
+ */
+#   define XF_LOG_DFR_ARG_NUM(...)      XF_LOG_DFR_ARG_NUM_(_, ##__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#   define XF_LOG_DFR_ARG_NUM_(_0, _1, _2, _3, _4, _5, _6, _7, _8, _n, ...) _n
+#   define XF_LOG_DFR_ARGS_0(...)
+#   define XF_LOG_DFR_ARGS_1(_a)        , (uintptr_t)(_a)
+#   define XF_LOG_DFR_ARGS_2(_a, ...)   , (uintptr_t)(_a) XF_LOG_DFR_ARGS_1(__VA_ARGS__)
+#   define XF_LOG_DFR_ARGS_3(_a, ...)   , (uintptr_t)(_a) XF_LOG_DFR_ARGS_2(__VA_ARGS__)
+#   define XF_LOG_DFR_ARGS_4(_a, ...)   , (uintptr_t)(_a) XF_LOG_DFR_ARGS_3(__VA_ARGS__)
+#   define XF_LOG_DFR_ARGS_5(_a, ...)   , (uintptr_t)(_a) XF_LOG_DFR_ARGS_4(__VA_ARGS__)
+#   define XF_LOG_DFR_ARGS_6(_a, ...)   , (uintptr_t)(_a) XF_LOG_DFR_ARGS_5(__VA_ARGS__)
+#   define XF_LOG_DFR_ARGS_7(_a, ...)   , (uintptr_t)(_a) XF_LOG_DFR_ARGS_6(__VA_ARGS__)
+#   define XF_LOG_DFR_ARGS_8(_a, ...)   , (uintptr_t)(_a) XF_LOG_DFR_ARGS_7(__VA_ARGS__)
+#   define XF_LOG_OUTPUT_I(level, tag, format, ...) \
+                                        xf_log_deferred((level), (tag), (format), \
+                                                        (uint8_t)XF_LOG_DFR_ARG_NUM(__VA_ARGS__) \
+                                                        XCAT2(XF_LOG_DFR_ARGS_, XF_LOG_DFR_ARG_NUM(__VA_ARGS__))(__VA_ARGS__))
+#else
+#   define XF_LOG_OUTPUT_I(level, tag, format, ...) \
+                                        xf_log_level((level), (tag), (format), ##__VA_ARGS__)
+#endif
+
+#if XF_LOG_ENABLE_RUNTIME_LEVEL
+#   define XF_LOG_LEVEL_I(level, tag, format, ...) \
+        do { \
+            if (xf_log_tag_is_enabled((level), (tag))) { \
+                XF_LOG_OUTPUT_I((level), (tag), (format), ##__VA_ARGS__); \
+            } \
+        } while (0)
+#else
+#   define XF_LOG_LEVEL_I(level, tag, format, ...) \
+                                        XF_LOG_OUTPUT_I((level), (tag), (format), ##__VA_ARGS__)
+#endif
+
+#if XF_LOG_ENABLE_RATELIMIT
+/**
+ * @brief 限频输出。每个调用点每 XF_LOG_RATELIMIT_INTERVAL_MS 最多输出
+ * XF_LOG_RATELIMIT_BURST 条，其余被抑制；新时间窗的第一条日志前输出被抑制的条数。
+ *
+ * 调用点状态为静态变量，快速路径上只有一次 tick 比较和计数。
+ */
+#   define XF_LOG_RL_I(_log, tag, format, ...) \
+        do { \
+            static xf_log_ratelimit_t _xf_rl = {0}; \
+            uint16_t _xf_suppressed; \
+            if (xf_log_ratelimit_i(&_xf_rl, &_xf_suppressed)) { \
+                if (_xf_suppressed != 0) { \
+                    _log(tag, "suppressed %u similar messages", (unsigned int)_xf_suppressed); \
+                } \
+                _log(tag, format, ##__VA_ARGS__); \
+            } \
+        } while (0)
+#else
+#   define XF_LOG_RL_I(_log, tag, format, ...) \
+                                        _log(tag, format, ##__VA_ARGS__)
+#endif
+
 #if XF_LOG_ENABLE_ERROR_LEVEL
 /**
  * @brief 错误等级日志。始终显示文件名、行号等信息。
@@ -69,11 +326,15 @@ __EXT_IMPL void xf_log_level(char level, const char *tag, const char *format, ..
  * @param ... 可变参数。
  * @return size_t 本次日志字节数。
  */
-#   define XF_LOGE(tag, format, ...)    xf_log_level(XF_LOG_ERROR,  tag,  format, ##__VA_ARGS__)
-#   define XF_MLOGE(format, ...)        xf_log_level(XF_LOG_ERROR,  MTAG, format, ##__VA_ARGS__)
+#   define XF_LOGE(tag, format, ...)    XF_LOG_LEVEL_I(XF_LOG_ERROR,  tag,  format, ##__VA_ARGS__)
+#   define XF_MLOGE(format, ...)        XF_LOG_LEVEL_I(XF_LOG_ERROR,  MTAG, format, ##__VA_ARGS__)
+#   define XF_LOGE_RL(tag, format, ...) XF_LOG_RL_I(XF_LOGE, tag,  format, ##__VA_ARGS__)
+#   define XF_MLOGE_RL(format, ...)     XF_LOG_RL_I(XF_LOGE, MTAG, format, ##__VA_ARGS__)
 #else
 #   define XF_LOGE(tag, format, ...)    UNUSED(tag)
 #   define XF_MLOGE(format, ...)        UNUSED(MTAG)
+#   define XF_LOGE_RL(tag, format, ...) UNUSED(tag)
+#   define XF_MLOGE_RL(format, ...)     UNUSED(MTAG)
 #endif
 
 #if XF_LOG_ENABLE_WARN_LEVEL
@@ -85,11 +346,15 @@ __EXT_IMPL void xf_log_level(char level, const char *tag, const char *format, ..
  * @param ... 可变参数。
  * @return size_t 本次日志字节数。
  */
-#   define XF_LOGW(tag, format, ...)    xf_log_level(XF_LOG_WARN,  tag,  format, ##__VA_ARGS__)
-#   define XF_MLOGW(format, ...)        xf_log_level(XF_LOG_WARN,  MTAG, format, ##__VA_ARGS__)
+#   define XF_LOGW(tag, format, ...)    XF_LOG_LEVEL_I(XF_LOG_WARN,  tag,  format, ##__VA_ARGS__)
+#   define XF_MLOGW(format, ...)        XF_LOG_LEVEL_I(XF_LOG_WARN,  MTAG, format, ##__VA_ARGS__)
+#   define XF_LOGW_RL(tag, format, ...) XF_LOG_RL_I(XF_LOGW, tag,  format, ##__VA_ARGS__)
+#   define XF_MLOGW_RL(format, ...)     XF_LOG_RL_I(XF_LOGW, MTAG, format, ##__VA_ARGS__)
 #else
 #   define XF_LOGW(tag, format, ...)    UNUSED(tag)
 #   define XF_MLOGW(format, ...)        UNUSED(MTAG)
+#   define XF_LOGW_RL(tag, format, ...) UNUSED(tag)
+#   define XF_MLOGW_RL(format, ...)     UNUSED(MTAG)
 #endif
 
 #if XF_LOG_ENABLE_INFO_LEVEL
@@ -101,11 +366,15 @@ __EXT_IMPL void xf_log_level(char level, const char *tag, const char *format, ..
  * @param ... 可变参数。
  * @return size_t 本次日志字节数。
  */
-#   define XF_LOGI(tag, format, ...)    xf_log_level(XF_LOG_INFO,  tag,  format, ##__VA_ARGS__)
-#   define XF_MLOGI(format, ...)        xf_log_level(XF_LOG_INFO,  MTAG, format, ##__VA_ARGS__)
+#   define XF_LOGI(tag, format, ...)    XF_LOG_LEVEL_I(XF_LOG_INFO,  tag,  format, ##__VA_ARGS__)
+#   define XF_MLOGI(format, ...)        XF_LOG_LEVEL_I(XF_LOG_INFO,  MTAG, format, ##__VA_ARGS__)
+#   define XF_LOGI_RL(tag, format, ...) XF_LOG_RL_I(XF_LOGI, tag,  format, ##__VA_ARGS__)
+#   define XF_MLOGI_RL(format, ...)     XF_LOG_RL_I(XF_LOGI, MTAG, format, ##__VA_ARGS__)
 #else
 #   define XF_LOGI(tag, format, ...)    UNUSED(tag)
 #   define XF_MLOGI(format, ...)        UNUSED(MTAG)
+#   define XF_LOGI_RL(tag, format, ...) UNUSED(tag)
+#   define XF_MLOGI_RL(format, ...)     UNUSED(MTAG)
 #endif
 
 #if XF_LOG_ENABLE_DEBUG_LEVEL
@@ -117,11 +386,15 @@ __EXT_IMPL void xf_log_level(char level, const char *tag, const char *format, ..
  * @param ... 可变参数。
  * @return size_t 本次日志字节数。
  */
-#   define XF_LOGD(tag, format, ...)    xf_log_level(XF_LOG_DEBUG,  tag,  format, ##__VA_ARGS__)
-#   define XF_MLOGD(format, ...)        xf_log_level(XF_LOG_DEBUG,  MTAG, format, ##__VA_ARGS__)
+#   define XF_LOGD(tag, format, ...)    XF_LOG_LEVEL_I(XF_LOG_DEBUG,  tag,  format, ##__VA_ARGS__)
+#   define XF_MLOGD(format, ...)        XF_LOG_LEVEL_I(XF_LOG_DEBUG,  MTAG, format, ##__VA_ARGS__)
+#   define XF_LOGD_RL(tag, format, ...) XF_LOG_RL_I(XF_LOGD, tag,  format, ##__VA_ARGS__)
+#   define XF_MLOGD_RL(format, ...)     XF_LOG_RL_I(XF_LOGD, MTAG, format, ##__VA_ARGS__)
 #else
 #   define XF_LOGD(tag, format, ...)    UNUSED(tag)
 #   define XF_MLOGD(format, ...)        UNUSED(MTAG)
+#   define XF_LOGD_RL(tag, format, ...) UNUSED(tag)
+#   define XF_MLOGD_RL(format, ...)     UNUSED(MTAG)
 #endif
 
 #if XF_LOG_ENABLE_VERBOSE_LEVEL
@@ -133,11 +406,15 @@ __EXT_IMPL void xf_log_level(char level, const char *tag, const char *format, ..
  * @param ... 可变参数。
  * @return size_t 本次日志字节数。
  */
-#   define XF_LOGV(tag, format, ...)    xf_log_level(XF_LOG_VERBOSE, tag,  format, ##__VA_ARGS__)
-#   define XF_MLOGV(format, ...)        xf_log_level(XF_LOG_VERBOSE, MTAG, format, ##__VA_ARGS__)
+#   define XF_LOGV(tag, format, ...)    XF_LOG_LEVEL_I(XF_LOG_VERBOSE, tag,  format, ##__VA_ARGS__)
+#   define XF_MLOGV(format, ...)        XF_LOG_LEVEL_I(XF_LOG_VERBOSE, MTAG, format, ##__VA_ARGS__)
+#   define XF_LOGV_RL(tag, format, ...) XF_LOG_RL_I(XF_LOGV, tag,  format, ##__VA_ARGS__)
+#   define XF_MLOGV_RL(format, ...)     XF_LOG_RL_I(XF_LOGV, MTAG, format, ##__VA_ARGS__)
 #else
 #   define XF_LOGV(tag, format, ...)    UNUSED(tag)
 #   define XF_MLOGV(format, ...)        UNUSED(MTAG)
+#   define XF_LOGV_RL(tag, format, ...) UNUSED(tag)
+#   define XF_MLOGV_RL(format, ...)     UNUSED(MTAG)
 #endif
 
 #ifdef __cplusplus
@@ -0,0 +1,215 @@
+/**
+ * @file xf_log_async.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 异步日志输出。
+ * @version 1.0
+ * @date 2025-07-04
+ *
+ * SPDX-FileCopyrightText: 2025 CompanyNameMagicTag
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+/*
+    NOTE 异步日志原理
+
+    1.  xf_log_level 先在栈上格式化出整行（最长 XF_LOG_LINE_SIZE），
+        再以 [长度][文本] 的形式写入字节环形缓冲区后立即返回。
+        格式化在临界区外进行，临界区内只有一次不超过一行的拷贝，耗时有上限。
+    1.  后台任务（xf_log_async_start）或空闲时调用的 xf_log_async_flush
+        逐条取出日志，在临界区外通过 xf_log_printf 输出。
+    1.  缓冲区满时按 XF_LOG_ASYNC_OVERFLOW_POLICY 处理，丢弃的条数可以查询。
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_log.h"
+#include "../std/xf_string.h"
+#include "../system/safe/xf_safe.h"
+#include "../system/task/xf_task.h"
+
+#if XF_LOG_ENABLE_ASYNC
+
+/* ==================== [Defines] =========================================== */
+
+#define XF_LOG_ASYNC_BUF_MASK           (XF_LOG_ASYNC_BUF_SIZE - 1U)
+
+/* 记录头：1 字节长度 */
+#define XF_LOG_ASYNC_HEAD_SIZE          1U
+
+STATIC_ASSERT((XF_LOG_ASYNC_BUF_SIZE & (XF_LOG_ASYNC_BUF_SIZE - 1)) == 0);
+/* 记录长度用 1 字节表示 */
+STATIC_ASSERT((XF_LOG_LINE_SIZE >= 16) && (XF_LOG_LINE_SIZE <= 255));
+STATIC_ASSERT(XF_LOG_ASYNC_BUF_SIZE >= (XF_LOG_LINE_SIZE + XF_LOG_ASYNC_HEAD_SIZE));
+STATIC_ASSERT((XF_LOG_ASYNC_OVERFLOW_POLICY >= XF_LOG_ASYNC_DROP_NEWEST)
+              && (XF_LOG_ASYNC_OVERFLOW_POLICY <= XF_LOG_ASYNC_BLOCK));
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static bool_t xf_log_async_put(const char *line, uint8_t len);
+static uint8_t xf_log_async_pop(char *line);
+static void xf_log_async_copy_in(uint32_t pos, const char *src, uint32_t len);
+static void xf_log_async_copy_out(uint32_t pos, char *dst, uint32_t len);
+static XF_TASK_FUNC(xf_log_async_task);
+
+/* ==================== [Static Variables] ================================== */
+
+static char s_async_buf[XF_LOG_ASYNC_BUF_SIZE];
+
+/* 读写位置（字节），自由增长，使用时取模 */
+static volatile uint32_t s_async_head = 0;
+static volatile uint32_t s_async_tail = 0;
+
+static volatile uint32_t s_async_dropped = 0;
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+__IMPL void xf_log_level(char level, const char *tag, const char *format, ...)
+{
+    char line[XF_LOG_LINE_SIZE + 1];
+    va_list args;
+    size_t len;
+    va_start(args, format);
+    len = xf_log_format_line_i(line, level, tag, format, args);
+    va_end(args);
+#if XF_LOG_ASYNC_OVERFLOW_POLICY == XF_LOG_ASYNC_BLOCK
+    while (!xf_log_async_put(line, (uint8_t)len)) {
+        /* 由调用者同步输出最旧的日志，直到放得下 */
+        char old[XF_LOG_LINE_SIZE + 1];
+        uint8_t old_len = xf_log_async_pop(old);
+        old[old_len] = '\0';
+        xf_log_printf("%s", old);
+    }
+#else
+    (void)xf_log_async_put(line, (uint8_t)len);
+#endif
+}
+
+xf_err_t xf_log_async_start(void)
+{
+    if (xf_task_create(xf_log_async_task, NULL) == NULL) {
+        return XF_ERR_RESOURCE;
+    }
+    return XF_OK;
+}
+
+uint32_t xf_log_async_flush(void)
+{
+    char line[XF_LOG_LINE_SIZE + 1];
+    uint8_t len;
+    uint32_t cnt = 0;
+    while ((len = xf_log_async_pop(line)) != 0) {
+        line[len] = '\0';
+        xf_log_printf("%s", line);
+        cnt++;
+    }
+    return cnt;
+}
+
+uint32_t xf_log_async_get_dropped(void)
+{
+    return s_async_dropped;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+/**
+ * @brief 写入一条日志.
+ *
+ * @return bool_t
+ *      - TRUE      已写入（丢弃旧日志策略下总是成功）
+ *      - FALSE     空间不足。丢弃新日志策略下计入丢弃数；阻塞策略下由调用者腾出空间
+ */
+static bool_t xf_log_async_put(const char *line, uint8_t len)
+{
+    uint32_t need = XF_LOG_ASYNC_HEAD_SIZE + len;
+    uint32_t head;
+    XF_CRIT_STAT();
+    XF_CRIT_ENTRY();
+    head = s_async_head;
+#if XF_LOG_ASYNC_OVERFLOW_POLICY == XF_LOG_ASYNC_DROP_OLDEST
+    while ((XF_LOG_ASYNC_BUF_SIZE - (head - s_async_tail)) < need) {
+        s_async_tail += XF_LOG_ASYNC_HEAD_SIZE
+                        + (uint8_t)s_async_buf[s_async_tail & XF_LOG_ASYNC_BUF_MASK];
+        s_async_dropped++;
+    }
+#else
+    if ((XF_LOG_ASYNC_BUF_SIZE - (head - s_async_tail)) < need) {
+#   if XF_LOG_ASYNC_OVERFLOW_POLICY == XF_LOG_ASYNC_DROP_NEWEST
+        s_async_dropped++;
+#   endif
+        XF_CRIT_EXIT();
+        return FALSE;
+    }
+#endif
+    s_async_buf[head & XF_LOG_ASYNC_BUF_MASK] = (char)len;
+    xf_log_async_copy_in(head + XF_LOG_ASYNC_HEAD_SIZE, line, len);
+    s_async_head = head + need;
+    XF_CRIT_EXIT();
+    return TRUE;
+}
+
+/**
+ * @brief 取出一条日志.
+ *
+ * @param[out] line 至少 XF_LOG_LINE_SIZE 字节，不添加 '\0'.
+ * @return uint8_t  日志长度， 0 表示缓冲区为空。
+ */
+static uint8_t xf_log_async_pop(char *line)
+{
+    uint32_t tail;
+    uint8_t len;
+    XF_CRIT_STAT();
+    XF_CRIT_ENTRY();
+    tail = s_async_tail;
+    if (tail == s_async_head) {
+        XF_CRIT_EXIT();
+        return 0;
+    }
+    len = (uint8_t)s_async_buf[tail & XF_LOG_ASYNC_BUF_MASK];
+    xf_log_async_copy_out(tail + XF_LOG_ASYNC_HEAD_SIZE, line, len);
+    s_async_tail = tail + XF_LOG_ASYNC_HEAD_SIZE + len;
+    XF_CRIT_EXIT();
+    return len;
+}
+
+static void xf_log_async_copy_in(uint32_t pos, const char *src, uint32_t len)
+{
+    uint32_t idx = pos & XF_LOG_ASYNC_BUF_MASK;
+    uint32_t first = XF_LOG_ASYNC_BUF_SIZE - idx;
+    if (first >= len) {
+        xf_memcpy(&s_async_buf[idx], src, len);
+        return;
+    }
+    xf_memcpy(&s_async_buf[idx], src, first);
+    xf_memcpy(&s_async_buf[0], &src[first], len - first);
+}
+
+static void xf_log_async_copy_out(uint32_t pos, char *dst, uint32_t len)
+{
+    uint32_t idx = pos & XF_LOG_ASYNC_BUF_MASK;
+    uint32_t first = XF_LOG_ASYNC_BUF_SIZE - idx;
+    if (first >= len) {
+        xf_memcpy(dst, &s_async_buf[idx], len);
+        return;
+    }
+    xf_memcpy(dst, &s_async_buf[idx], first);
+    xf_memcpy(&dst[first], &s_async_buf[0], len - first);
+}
+
+static XF_TASK_FUNC(xf_log_async_task)
+{
+    UNUSED(arg);
+    xf_task_begin(me);
+    while (1) {
+        (void)xf_log_async_flush();
+        xf_task_delay(me, 1);
+    }
+    xf_task_end(me);
+}
+
+#endif /* XF_LOG_ENABLE_ASYNC */
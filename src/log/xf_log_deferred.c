@@ -0,0 +1,126 @@
+/**
+ * @file xf_log_deferred.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 延迟（二进制）日志。
+ * @version 1.0
+ * @date 2025-07-03
+ *
+ * SPDX-FileCopyrightText: 2025 CompanyNameMagicTag
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+/*
+    NOTE 延迟日志原理
+
+    1.  XF_LOGx 不格式化，只把格式字符串地址、标签地址、 tick
+        以及转为 uintptr_t 的参数写入字缓冲区，耗时与参数个数成正比。
+    1.  应用通过 xf_log_deferred_read() 取出原始数据发送到主机
+        （或由调试器直接导出）。
+    1.  主机端 tools/xf_log_decode.py 根据固件 ELF 解析格式字符串与 %s 字符串，
+        还原为与 xf_log_level 相同格式的文本。
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_log.h"
+#include "../system/safe/xf_safe.h"
+
+#if XF_LOG_ENABLE_DEFERRED
+
+#include <stdarg.h>
+
+/* ==================== [Defines] =========================================== */
+
+/* 缓冲区大小（字） */
+#define XF_LOG_DFR_WORD_NUM             (XF_LOG_DEFERRED_BUF_SIZE / sizeof(uintptr_t))
+#define XF_LOG_DFR_WORD_MASK            (XF_LOG_DFR_WORD_NUM - 1U)
+
+/* 记录头: format, tag, tick, info */
+#define XF_LOG_DFR_HEAD_WORD_NUM        4U
+
+STATIC_ASSERT((XF_LOG_DEFERRED_BUF_SIZE & (XF_LOG_DEFERRED_BUF_SIZE - 1)) == 0);
+STATIC_ASSERT(XF_LOG_DFR_WORD_NUM >= (XF_LOG_DFR_HEAD_WORD_NUM + XF_LOG_DEFERRED_ARG_NUM_MAX));
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+/* ==================== [Static Variables] ================================== */
+
+static uintptr_t s_dfr_buf[XF_LOG_DFR_WORD_NUM];
+
+/* 读写位置（字），自由增长，使用时取模 */
+static volatile uint32_t s_dfr_head = 0;
+static volatile uint32_t s_dfr_tail = 0;
+
+static volatile uint32_t s_dfr_dropped = 0;
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void xf_log_deferred(char level, const char *tag, const char *format, uint8_t arg_num, ...)
+{
+    va_list args;
+    uint32_t head;
+    uint8_t i;
+    XF_CRIT_STAT();
+    if (arg_num > XF_LOG_DEFERRED_ARG_NUM_MAX) {
+        arg_num = XF_LOG_DEFERRED_ARG_NUM_MAX;
+    }
+    XF_CRIT_ENTRY();
+    head = s_dfr_head;
+    if ((XF_LOG_DFR_WORD_NUM - (head - s_dfr_tail))
+            < (XF_LOG_DFR_HEAD_WORD_NUM + arg_num)) {
+        s_dfr_dropped++;
+        XF_CRIT_EXIT();
+        return;
+    }
+    s_dfr_buf[(head++) & XF_LOG_DFR_WORD_MASK] = (uintptr_t)format;
+    s_dfr_buf[(head++) & XF_LOG_DFR_WORD_MASK] = (uintptr_t)tag;
+    s_dfr_buf[(head++) & XF_LOG_DFR_WORD_MASK] = (uintptr_t)xf_tick_get_count();
+    s_dfr_buf[(head++) & XF_LOG_DFR_WORD_MASK] = ((uintptr_t)XF_LOG_DEFERRED_MAGIC << 24)
+            | ((uintptr_t)arg_num << 8)
+            | (uintptr_t)(uint8_t)level;
+    va_start(args, arg_num);
+    for (i = 0; i < arg_num; ++i) {
+        s_dfr_buf[(head++) & XF_LOG_DFR_WORD_MASK] = va_arg(args, uintptr_t);
+    }
+    va_end(args);
+    s_dfr_head = head;
+    XF_CRIT_EXIT();
+}
+
+size_t xf_log_deferred_read(void *p_buf, size_t size)
+{
+    uintptr_t *p_word = (uintptr_t *)p_buf;
+    uint32_t tail;
+    uint32_t word_num;
+    uint32_t i;
+    XF_CRIT_STAT();
+    if (p_buf == NULL) {
+        return 0;
+    }
+    XF_CRIT_ENTRY();
+    tail = s_dfr_tail;
+    word_num = s_dfr_head - tail;
+    if (word_num > (size / sizeof(uintptr_t))) {
+        word_num = (uint32_t)(size / sizeof(uintptr_t));
+    }
+    for (i = 0; i < word_num; ++i) {
+        p_word[i] = s_dfr_buf[(tail++) & XF_LOG_DFR_WORD_MASK];
+    }
+    s_dfr_tail = tail;
+    XF_CRIT_EXIT();
+    return word_num * sizeof(uintptr_t);
+}
+
+uint32_t xf_log_deferred_get_dropped(void)
+{
+    return s_dfr_dropped;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+#endif /* XF_LOG_ENABLE_DEFERRED */
@@ -0,0 +1,808 @@
+/**
+ * @file xf_printf.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 无堆分配的格式化输出。
+ * @version 1.0
+ * @date 2025-07-06
+ *
+ * SPDX-FileCopyrightText: 2025 CompanyNameMagicTag
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_printf.h"
+
+/* ==================== [Defines] =========================================== */
+
+#define FLAG_LEFT           (1U << 0)   /*!< '-' */
+#define FLAG_ZERO           (1U << 1)   /*!< '0' */
+#define FLAG_PLUS           (1U << 2)   /*!< '+' */
+#define FLAG_SPACE          (1U << 3)   /*!< ' ' */
+#define FLAG_ALT            (1U << 4)   /*!< '#' */
+#define FLAG_UPPER          (1U << 5)
+#define FLAG_PREC           (1U << 6)   /*!< 指定了精度 */
+#define FLAG_PTR            (1U << 7)   /*!< %p, 0 也输出 "0x" 前缀 */
+
+/* 64 位八进制最长 22 位 */
+#define NUM_BUF_SIZE        24
+
+#if XF_PRINTF_ENABLE_FLOAT
+/* 分解后尾数 m 的位数 */
+#define FLOAT_MANT_BITS     64
+/* 大数字数，32 位一字：整数部分小于 2^1024, 小数部分分母最大 2^1137（2^-1074 = 2^63 * 2^-1137） */
+#define FLOAT_BIG_WORDS     36
+/* 整数部分的 10^9 进制位数，最多 309 位十进制数 */
+#define FLOAT_DEC_LIMBS     35
+#define FLOAT_DEC_LIMB      1000000000U
+#endif
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef struct _xf_printf_out_t {
+    char *buf;
+    size_t size;
+    size_t pos;                         /*!< 已输出（含被截断）的字符数 */
+} xf_printf_out_t;
+
+typedef enum _xf_printf_len_t {
+    LEN_INT = 0,
+    LEN_CHAR,
+    LEN_SHORT,
+    LEN_LONG,
+    LEN_LLONG,
+    LEN_SIZE,
+    LEN_MAX,
+    LEN_PTRDIFF,
+    LEN_LDOUBLE,
+} xf_printf_len_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static void out_char(xf_printf_out_t *o, char c);
+static void out_pad(xf_printf_out_t *o, char c, int n);
+static void out_str(xf_printf_out_t *o, const char *s, size_t len);
+static size_t utoa_dec(char *end, unsigned long long v);
+static size_t utoa_pow2(char *end, unsigned long long v, uint8_t shift, bool_t upper);
+static void out_num(xf_printf_out_t *o, unsigned long long v, bool_t neg,
+                    uint8_t base, uint32_t flags, int width, int prec);
+#if XF_PRINTF_ENABLE_FLOAT
+static void out_float(xf_printf_out_t *o, double v, uint32_t flags, int width, int prec);
+static int float_decompose(double v, unsigned long long *p_m);
+static void big_set(uint32_t *big, int nw, unsigned long long m, int bit_pos);
+static int big_frac_init(uint32_t *big, unsigned long long fbits, int k);
+static void big_frac_digits(uint32_t *big, int nw, int n, char *p_digits);
+static uint32_t big_div_1e9(uint32_t *big, int *p_nw);
+static bool_t big_is_zero(const uint32_t *big, int nw);
+#endif
+
+/* ==================== [Static Variables] ================================== */
+
+/* 两位十进制数字表，每次除以 100 输出两位 */
+static const char s_dec_pairs[200] = {
+    '0', '0', '0', '1', '0', '2', '0', '3', '0', '4', '0', '5', '0', '6', '0', '7', '0', '8', '0', '9',
+    '1', '0', '1', '1', '1', '2', '1', '3', '1', '4', '1', '5', '1', '6', '1', '7', '1', '8', '1', '9',
+    '2', '0', '2', '1', '2', '2', '2', '3', '2', '4', '2', '5', '2', '6', '2', '7', '2', '8', '2', '9',
+    '3', '0', '3', '1', '3', '2', '3', '3', '3', '4', '3', '5', '3', '6', '3', '7', '3', '8', '3', '9',
+    '4', '0', '4', '1', '4', '2', '4', '3', '4', '4', '4', '5', '4', '6', '4', '7', '4', '8', '4', '9',
+    '5', '0', '5', '1', '5', '2', '5', '3', '5', '4', '5', '5', '5', '6', '5', '7', '5', '8', '5', '9',
+    '6', '0', '6', '1', '6', '2', '6', '3', '6', '4', '6', '5', '6', '6', '6', '7', '6', '8', '6', '9',
+    '7', '0', '7', '1', '7', '2', '7', '3', '7', '4', '7', '5', '7', '6', '7', '7', '7', '8', '7', '9',
+    '8', '0', '8', '1', '8', '2', '8', '3', '8', '4', '8', '5', '8', '6', '8', '7', '8', '8', '8', '9',
+    '9', '0', '9', '1', '9', '2', '9', '3', '9', '4', '9', '5', '9', '6', '9', '7', '9', '8', '9', '9',
+};
+
+static const char s_hex_lower[] = "0123456789abcdef";
+static const char s_hex_upper[] = "0123456789ABCDEF";
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+int xf_vsnprintf(char *buf, size_t size, const char *format, va_list args)
+{
+    xf_printf_out_t o;
+    const char *p = format;
+    uint32_t flags;
+    int width;
+    int prec;
+    xf_printf_len_t len;
+    unsigned long long uv;
+    long long sv;
+
+    o.buf = buf;
+    o.size = (buf == NULL) ? 0 : size;
+    o.pos = 0;
+
+    while (*p != '\0') {
+        if (*p != '%') {
+            /* 连续的普通字符一次输出 */
+            const char *start = p;
+            while ((*p != '\0') && (*p != '%')) {
+                p++;
+            }
+            out_str(&o, start, (size_t)(p - start));
+            continue;
+        }
+        p++;
+
+        flags = 0;
+        for (;;) {
+            if (*p == '-') {
+                flags |= FLAG_LEFT;
+            } else if (*p == '0') {
+                flags |= FLAG_ZERO;
+            } else if (*p == '+') {
+                flags |= FLAG_PLUS;
+            } else if (*p == ' ') {
+                flags |= FLAG_SPACE;
+            } else if (*p == '#') {
+                flags |= FLAG_ALT;
+            } else {
+                break;
+            }
+            p++;
+        }
+
+        width = 0;
+        if (*p == '*') {
+            width = va_arg(args, int);
+            if (width < 0) {
+                flags |= FLAG_LEFT;
+                width = -width;
+            }
+            p++;
+        } else {
+            while ((*p >= '0') && (*p <= '9')) {
+                width = width * 10 + (*p - '0');
+                p++;
+            }
+        }
+
+        prec = 0;
+        if (*p == '.') {
+            flags |= FLAG_PREC;
+            p++;
+            if (*p == '*') {
+                prec = va_arg(args, int);
+                if (prec < 0) {
+                    flags &= ~FLAG_PREC;
+                    prec = 0;
+                }
+                p++;
+            } else {
+                while ((*p >= '0') && (*p <= '9')) {
+                    prec = prec * 10 + (*p - '0');
+                    p++;
+                }
+            }
+        }
+
+        len = LEN_INT;
+        switch (*p) {
+        case 'h':
+            p++;
+            len = LEN_SHORT;
+            if (*p == 'h') {
+                p++;
+                len = LEN_CHAR;
+            }
+            break;
+        case 'l':
+            p++;
+            len = LEN_LONG;
+            if (*p == 'l') {
+                p++;
+                len = LEN_LLONG;
+            }
+            break;
+        case 'z':
+            p++;
+            len = LEN_SIZE;
+            break;
+        case 'j':
+            p++;
+            len = LEN_MAX;
+            break;
+        case 't':
+            p++;
+            len = LEN_PTRDIFF;
+            break;
+        case 'L':
+            p++;
+            len = LEN_LDOUBLE;
+            break;
+        default:
+            break;
+        }
+
+        switch (*p) {
+        case 'd':
+        case 'i':
+            switch (len) {
+            case LEN_CHAR:      sv = (signed char)va_arg(args, int);    break;
+            case LEN_SHORT:     sv = (short)va_arg(args, int);          break;
+            case LEN_LONG:      sv = va_arg(args, long);                break;
+            case LEN_LLONG:     sv = va_arg(args, long long);           break;
+            case LEN_SIZE:      sv = (long long)va_arg(args, size_t);   break;
+            case LEN_MAX:       sv = va_arg(args, intmax_t);            break;
+            case LEN_PTRDIFF:   sv = va_arg(args, ptrdiff_t);           break;
+            default:            sv = va_arg(args, int);                 break;
+            }
+            uv = (sv < 0) ? (0ULL - (unsigned long long)sv) : (unsigned long long)sv;
+            out_num(&o, uv, (sv < 0), 10, flags, width, prec);
+            break;
+        case 'u':
+        case 'x':
+        case 'X':
+        case 'o':
+            switch (len) {
+            case LEN_CHAR:      uv = (unsigned char)va_arg(args, unsigned int);     break;
+            case LEN_SHORT:     uv = (unsigned short)va_arg(args, unsigned int);    break;
+            case LEN_LONG:      uv = va_arg(args, unsigned long);                   break;
+            case LEN_LLONG:     uv = va_arg(args, unsigned long long);              break;
+            case LEN_SIZE:      uv = va_arg(args, size_t);                          break;
+            case LEN_MAX:       uv = va_arg(args, uintmax_t);                       break;
+            case LEN_PTRDIFF:   uv = (unsigned long long)va_arg(args, ptrdiff_t);   break;
+            default:            uv = va_arg(args, unsigned int);                    break;
+            }
+            if (*p == 'X') {
+                flags |= FLAG_UPPER;
+            }
+            /* 无符号转换忽略 '+' 与 ' ' */
+            flags &= ~(FLAG_PLUS | FLAG_SPACE);
+            out_num(&o, uv, FALSE, (*p == 'u') ? 10 : ((*p == 'o') ? 8 : 16), flags, width, prec);
+            break;
+        case 'p':
+            uv = (unsigned long long)(uintptr_t)va_arg(args, void *);
+            flags = (flags & FLAG_LEFT) | FLAG_ALT | FLAG_PTR;
+            out_num(&o, uv, FALSE, 16, flags, width, 0);
+            break;
+        case 'c':
+            if (!(flags & FLAG_LEFT)) {
+                out_pad(&o, ' ', width - 1);
+            }
+            out_char(&o, (char)va_arg(args, int));
+            if (flags & FLAG_LEFT) {
+                out_pad(&o, ' ', width - 1);
+            }
+            break;
+        case 's': {
+            const char *s = va_arg(args, const char *);
+            size_t slen = 0;
+            if (s == NULL) {
+                s = "(null)";
+            }
+            /* 有精度时最多读取 prec 个字符 */
+            while ((s[slen] != '\0') && (!(flags & FLAG_PREC) || (slen < (size_t)prec))) {
+                slen++;
+            }
+            if (!(flags & FLAG_LEFT)) {
+                out_pad(&o, ' ', width - (int)slen);
+            }
+            out_str(&o, s, slen);
+            if (flags & FLAG_LEFT) {
+                out_pad(&o, ' ', width - (int)slen);
+            }
+        } break;
+#if XF_PRINTF_ENABLE_FLOAT
+        case 'f':
+        case 'F': {
+            double v = (len == LEN_LDOUBLE) ? (double)va_arg(args, long double) : va_arg(args, double);
+            if (*p == 'F') {
+                flags |= FLAG_UPPER;
+            }
+            out_float(&o, v, flags, width, (flags & FLAG_PREC) ? prec : 6);
+        } break;
+#else
+        case 'f':
+        case 'F':
+#endif
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            /* 不支持的浮点转换也要按类型取出参数，否则后面的参数全部错位 */
+            if (len == LEN_LDOUBLE) {
+                (void)va_arg(args, long double);
+            } else {
+                (void)va_arg(args, double);
+            }
+            out_char(&o, '%');
+            out_char(&o, *p);
+            break;
+        case 'n':
+            /* 不写入，只取出参数 */
+            (void)va_arg(args, void *);
+            break;
+        case '%':
+            out_char(&o, '%');
+            break;
+        case '\0':
+            /* 格式串以单独的 '%' 结尾 */
+            continue;
+        default:
+            /* 不支持的转换原样输出 */
+            out_char(&o, '%');
+            out_char(&o, *p);
+            break;
+        }
+        p++;
+    }
+
+    if (o.size != 0) {
+        o.buf[(o.pos < o.size) ? o.pos : (o.size - 1)] = '\0';
+    }
+    return (int)o.pos;
+}
+
+int xf_snprintf(char *buf, size_t size, const char *format, ...)
+{
+    va_list args;
+    int ret;
+    va_start(args, format);
+    ret = xf_vsnprintf(buf, size, format, args);
+    va_end(args);
+    return ret;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static void out_char(xf_printf_out_t *o, char c)
+{
+    if ((o->pos + 1) < o->size) {
+        o->buf[o->pos] = c;
+    }
+    o->pos++;
+}
+
+static void out_pad(xf_printf_out_t *o, char c, int n)
+{
+    while (n-- > 0) {
+        out_char(o, c);
+    }
+}
+
+static void out_str(xf_printf_out_t *o, const char *s, size_t len)
+{
+    size_t room = 0;
+    size_t i;
+    if ((o->pos + 1) < o->size) {
+        room = o->size - 1 - o->pos;
+    }
+    if (room > len) {
+        room = len;
+    }
+    for (i = 0; i < room; i++) {
+        o->buf[o->pos + i] = s[i];
+    }
+    o->pos += len;
+}
+
+/**
+ * @brief 无符号数转十进制，从 end 向前写入.
+ *
+ * 能用 32 位表示时走 32 位除法（MCU 上 64 位除法是库函数），每次除以 100 查表输出两位。
+ *
+ * @return size_t 位数。
+ */
+static size_t utoa_dec(char *end, unsigned long long v)
+{
+    char *p = end;
+    uint32_t v32;
+    uint32_t r;
+    while (v > 0xFFFFFFFFULL) {
+        r = (uint32_t)(v % 100U);
+        v /= 100U;
+        p -= 2;
+        p[0] = s_dec_pairs[r * 2U];
+        p[1] = s_dec_pairs[r * 2U + 1U];
+    }
+    v32 = (uint32_t)v;
+    while (v32 >= 100U) {
+        r = v32 % 100U;
+        v32 /= 100U;
+        p -= 2;
+        p[0] = s_dec_pairs[r * 2U];
+        p[1] = s_dec_pairs[r * 2U + 1U];
+    }
+    if (v32 >= 10U) {
+        p -= 2;
+        p[0] = s_dec_pairs[v32 * 2U];
+        p[1] = s_dec_pairs[v32 * 2U + 1U];
+    } else {
+        *--p = (char)('0' + v32);
+    }
+    return (size_t)(end - p);
+}
+
+/**
+ * @brief 无符号数转 2 的幂进制（八进制、十六进制），从 end 向前写入.
+ *
+ * @return size_t 位数。
+ */
+static size_t utoa_pow2(char *end, unsigned long long v, uint8_t shift, bool_t upper)
+{
+    const char *digits = upper ? s_hex_upper : s_hex_lower;
+    const unsigned long long mask = (1ULL << shift) - 1U;
+    char *p = end;
+    do {
+        *--p = digits[v & mask];
+        v >>= shift;
+    } while (v != 0);
+    return (size_t)(end - p);
+}
+
+static void out_num(xf_printf_out_t *o, unsigned long long v, bool_t neg,
+                    uint8_t base, uint32_t flags, int width, int prec)
+{
+    char num[NUM_BUF_SIZE];
+    char prefix[2];
+    size_t prefix_len = 0;
+    int digits;
+    int zeros;
+    int pad;
+
+    if ((flags & FLAG_PREC) && (prec == 0) && (v == 0) && !((flags & FLAG_ALT) && (base == 8))) {
+        /* "%.0d" 输出 0 时不输出数字，但 "%#.0o" 仍输出 "0" */
+        digits = 0;
+    } else if (base == 10) {
+        digits = (int)utoa_dec(&num[NUM_BUF_SIZE], v);
+    } else {
+        digits = (int)utoa_pow2(&num[NUM_BUF_SIZE], v, (base == 8) ? 3 : 4,
+                                (flags & FLAG_UPPER) ? TRUE : FALSE);
+    }
+
+    if (neg) {
+        prefix[prefix_len++] = '-';
+    } else if (flags & FLAG_PLUS) {
+        prefix[prefix_len++] = '+';
+    } else if (flags & FLAG_SPACE) {
+        prefix[prefix_len++] = ' ';
+    }
+    if ((flags & FLAG_ALT) && ((v != 0) || (flags & FLAG_PTR))) {
+        if (base == 16) {
+            prefix[prefix_len++] = '0';
+            prefix[prefix_len++] = (flags & FLAG_UPPER) ? 'X' : 'x';
+        } else if ((base == 8) && (prec <= digits)) {
+            prec = digits + 1;
+        }
+    }
+
+    zeros = (prec > digits) ? (prec - digits) : 0;
+    pad = width - (int)prefix_len - zeros - digits;
+    if ((flags & FLAG_ZERO) && !(flags & (FLAG_LEFT | FLAG_PREC)) && (pad > 0)) {
+        zeros += pad;
+        pad = 0;
+    }
+
+    if (!(flags & FLAG_LEFT)) {
+        out_pad(o, ' ', pad);
+    }
+    out_str(o, prefix, prefix_len);
+    out_pad(o, '0', zeros);
+    out_str(o, &num[NUM_BUF_SIZE - digits], (size_t)digits);
+    if (flags & FLAG_LEFT) {
+        out_pad(o, ' ', pad);
+    }
+}
+
+#if XF_PRINTF_ENABLE_FLOAT
+/**
+ * @brief 输出 %f.
+ *
+ * 把 v 精确分解为 m * 2^e（m 为整数），之后只做整数运算:
+ *      - 整数部分超出 unsigned long long 时用大数，每次除以 10^9 得到 9 位十进制数;
+ *      - 小数部分作为大数纯小数，每次乘以 10^n 溢出的部分就是接下来的 n 位数字。
+ * 因此任意精度、任意大小的有限值都输出真实数字，按精确值舍入到最近，恰为一半时取偶，与 glibc 一致。
+ * 进位可能越过末尾的 9 传到前面的位，所以小数部分先算完并确定进位再输出。
+ * 小数位先存到 dec.frac（有小数部分时整数部分不超过 64 位，不用 dec.limbs），
+ * 精度超出其长度时，再算一遍输出。
+ */
+static void out_float(xf_printf_out_t *o, double v, uint32_t flags, int width, int prec)
+{
+    uint32_t big[FLOAT_BIG_WORDS];
+    union {
+        uint32_t limbs[FLOAT_DEC_LIMBS];
+        char frac[FLOAT_DEC_LIMBS * sizeof(uint32_t)];
+    } dec;
+    char num[NUM_BUF_SIZE];
+    const char *special = NULL;
+    bool_t neg = FALSE;
+    bool_t round_up = FALSE;
+    unsigned long long m = 0;
+    unsigned long long ipart = 0;
+    unsigned long long fbits = 0;
+    int e = 0;
+    int nw = 0;
+    int nl = 0;
+    int idigits;
+    int last_non9 = -1;
+    int nfrac = 0;
+    int c;
+    int j;
+    bool_t rem_zero;
+    char chunk[9];
+    int len;
+    int pad;
+    int i;
+    uint32_t d;
+    uint32_t last;
+    char sign = '\0';
+
+    if (v != v) {
+        special = (flags & FLAG_UPPER) ? "NAN" : "nan";
+    } else {
+        /* -0.0 == 0, 只能由 1 / -0.0 为 -inf 判断符号 */
+        neg = ((v < 0) || ((v == 0) && ((1.0 / v) < 0))) ? TRUE : FALSE;
+        if (neg) {
+            v = -v;
+        }
+        if ((v - v) != 0) {
+            special = (flags & FLAG_UPPER) ? "INF" : "inf";
+        }
+    }
+    if (neg) {
+        sign = '-';
+    } else if (flags & FLAG_PLUS) {
+        sign = '+';
+    } else if (flags & FLAG_SPACE) {
+        sign = ' ';
+    }
+    if (special != NULL) {
+        len = 3 + ((sign != '\0') ? 1 : 0);
+        if (!(flags & FLAG_LEFT)) {
+            out_pad(o, ' ', width - len);
+        }
+        if (sign != '\0') {
+            out_char(o, sign);
+        }
+        out_str(o, special, 3);
+        if (flags & FLAG_LEFT) {
+            out_pad(o, ' ', width - len);
+        }
+        return;
+    }
+
+    if (v != 0) {
+        e = float_decompose(v, &m);
+        if (e >= 0) {
+            if (e <= (64 - FLOAT_MANT_BITS)) {
+                ipart = m << e;
+            } else {
+                /* 整数部分拆成 10^9 进制，低位在前 */
+                nw = (FLOAT_MANT_BITS + e + 31) / 32;
+                big_set(big, nw, m, e);
+                while (nw > 0) {
+                    dec.limbs[nl++] = big_div_1e9(big, &nw);
+                }
+            }
+        } else if (-e < 64) {
+            ipart = m >> -e;
+            fbits = m & ((1ULL << -e) - 1U);
+        } else {
+            fbits = m;
+        }
+    }
+
+    if (fbits != 0) {
+        /* 每次取出最多 9 位；舍去部分与一半比较，并找到最后一个不是 9 的位 */
+        nw = big_frac_init(big, fbits, -e);
+        last = (uint32_t)(ipart & 1U);
+        rem_zero = FALSE;
+        for (i = 0; (i < prec) && !rem_zero; i += c) {
+            c = ((prec - i) < 9) ? (prec - i) : 9;
+            big_frac_digits(big, nw, c, chunk);
+            for (j = 0; j < c; j++) {
+                if (chunk[j] != '9') {
+                    last_non9 = i + j;
+                }
+                if (i + j < (int)sizeof(dec.frac)) {
+                    dec.frac[i + j] = chunk[j];
+                    nfrac = i + j + 1;
+                }
+            }
+            last = (uint32_t)(chunk[c - 1] - '0');
+            rem_zero = big_is_zero(big, nw);
+        }
+        if (!rem_zero) {
+            /* 最高位为一半 */
+            d = big[nw - 1] & 0x7FFFFFFFU;
+            for (i = 0; (i < nw - 1) && (d == 0); i++) {
+                d = big[i];
+            }
+            round_up = ((big[nw - 1] >> 31) && ((d != 0) || (last & 1U))) ? TRUE : FALSE;
+        }
+        if (round_up && (last_non9 < 0)) {
+            /* 小数部分全是 9, 进位到整数部分，小数部分全为 0 */
+            ipart++;
+            fbits = 0;
+            nfrac = 0;
+        } else if (round_up && (last_non9 < nfrac)) {
+            dec.frac[last_non9]++;
+            for (i = last_non9 + 1; i < nfrac; i++) {
+                dec.frac[i] = '0';
+            }
+        }
+    }
+
+    if (nl != 0) {
+        idigits = (int)utoa_dec(&num[NUM_BUF_SIZE], dec.limbs[nl - 1]) + 9 * (nl - 1);
+    } else {
+        idigits = (int)utoa_dec(&num[NUM_BUF_SIZE], ipart);
+    }
+    len = idigits + prec + (((prec > 0) || (flags & FLAG_ALT)) ? 1 : 0);
+    pad = width - len - ((sign != '\0') ? 1 : 0);
+    if (!(flags & (FLAG_LEFT | FLAG_ZERO))) {
+        out_pad(o, ' ', pad);
+    }
+    if (sign != '\0') {
+        out_char(o, sign);
+    }
+    if ((flags & FLAG_ZERO) && !(flags & FLAG_LEFT)) {
+        out_pad(o, '0', pad);
+    }
+
+    if (nl != 0) {
+        out_str(o, &num[NUM_BUF_SIZE - (idigits - 9 * (nl - 1))], (size_t)(idigits - 9 * (nl - 1)));
+        while (--nl > 0) {
+            len = (int)utoa_dec(&num[NUM_BUF_SIZE], dec.limbs[nl - 1]);
+            out_pad(o, '0', 9 - len);
+            out_str(o, &num[NUM_BUF_SIZE - len], (size_t)len);
+        }
+    } else {
+        out_str(o, &num[NUM_BUF_SIZE - idigits], (size_t)idigits);
+    }
+    if ((prec > 0) || (flags & FLAG_ALT)) {
+        out_char(o, '.');
+    }
+
+    /* 先输出存下的小数位；精度超出 dec.frac 时再算一遍输出其后的位，进位位加 1, 其后的 9 变为 0 */
+    out_str(o, dec.frac, (size_t)nfrac);
+    i = nfrac;
+    if ((fbits != 0) && (nfrac == (int)sizeof(dec.frac))) {
+        nw = big_frac_init(big, fbits, -e);
+        for (i = 0; (i < prec) && !big_is_zero(big, nw); i += c) {
+            c = ((prec - i) < 9) ? (prec - i) : 9;
+            big_frac_digits(big, nw, c, chunk);
+            for (j = (i < nfrac) ? (nfrac - i) : 0; j < c; j++) {
+                if (round_up && (i + j >= last_non9)) {
+                    chunk[j] = (i + j == last_non9) ? (char)(chunk[j] + 1) : '0';
+                }
+                out_char(o, chunk[j]);
+            }
+        }
+    }
+    out_pad(o, '0', prec - i);
+    if (flags & FLAG_LEFT) {
+        out_pad(o, ' ', pad);
+    }
+}
+
+/**
+ * @brief 把有限正数 v 精确分解为 m * 2^e, 2^63 <= m < 2^64.
+ *
+ * 乘除 2 的幂是精确的，缩放到 [2^63, 2^64) 后 v 为整数，不依赖 double 的内存布局。
+ *
+ * @return int e.
+ */
+static int float_decompose(double v, unsigned long long *p_m)
+{
+    static const double s_scale[] = {65536.0, 256.0, 16.0, 4.0, 2.0};
+    static const int s_shift[] = {16, 8, 4, 2, 1};
+    const double two64 = 18446744073709551616.0;
+    const double two32 = 4294967296.0;
+    unsigned long long m;
+    int e = 0;
+    uint8_t i;
+    while (v >= two64) {
+        v *= 1.0 / two32;
+        e += 32;
+    }
+    while (v < two32) {
+        v *= two32;
+        e -= 32;
+    }
+    for (i = 0; i < (uint8_t)(sizeof(s_shift) / sizeof(s_shift[0])); i++) {
+        if (v * s_scale[i] < two64) {
+            v *= s_scale[i];
+            e -= s_shift[i];
+        }
+    }
+    m = (unsigned long long)v;
+    *p_m = m;
+    return e;
+}
+
+/**
+ * @brief 大数清零后写入 m << bit_pos, 超出 nw 个字的部分丢弃.
+ */
+static void big_set(uint32_t *big, int nw, unsigned long long m, int bit_pos)
+{
+    int idx = bit_pos / 32;
+    int sh = bit_pos % 32;
+    unsigned long long lo = m << sh;
+    int i;
+    for (i = 0; i < nw; i++) {
+        big[i] = 0;
+    }
+    big[idx] = (uint32_t)lo;
+    if (idx + 1 < nw) {
+        big[idx + 1] = (uint32_t)(lo >> 32);
+    }
+    if ((idx + 2 < nw) && (sh != 0)) {
+        big[idx + 2] = (uint32_t)(m >> (64 - sh));
+    }
+}
+
+/**
+ * @brief 把 fbits / 2^k 写成 nw 个字的纯小数（小数点在最高字之上）.
+ *
+ * @return int 字数 nw.
+ */
+static int big_frac_init(uint32_t *big, unsigned long long fbits, int k)
+{
+    int nw = (k + 31) / 32;
+    big_set(big, nw, fbits, nw * 32 - k);
+    return nw;
+}
+
+/**
+ * @brief 纯小数乘以 10^n, 溢出到整数部分的就是接下来的 n 位数字.
+ *
+ * @param n         位数，1~9.
+ * @param[out] p_digits 传出 n 个数字字符（含前导 0）。
+ */
+static void big_frac_digits(uint32_t *big, int nw, int n, char *p_digits)
+{
+    static const uint32_t s_pow10[10] = {
+        1U, 10U, 100U, 1000U, 10000U, 100000U, 1000000U, 10000000U, 100000000U, 1000000000U,
+    };
+    unsigned long long t;
+    uint32_t carry = 0;
+    int i;
+    for (i = 0; i < nw; i++) {
+        t = (unsigned long long)big[i] * s_pow10[n] + carry;
+        big[i] = (uint32_t)t;
+        carry = (uint32_t)(t >> 32);
+    }
+    for (i = n - (int)utoa_dec(&p_digits[n], carry); i > 0; i--) {
+        p_digits[i - 1] = '0';
+    }
+}
+
+/**
+ * @brief 大数除以 10^9, 去掉高位的 0 字.
+ *
+ * @return uint32_t 余数。
+ */
+static uint32_t big_div_1e9(uint32_t *big, int *p_nw)
+{
+    unsigned long long t;
+    uint32_t rem = 0;
+    int i;
+    for (i = *p_nw - 1; i >= 0; i--) {
+        t = ((unsigned long long)rem << 32) | big[i];
+        big[i] = (uint32_t)(t / FLOAT_DEC_LIMB);
+        rem = (uint32_t)(t % FLOAT_DEC_LIMB);
+    }
+    while ((*p_nw > 0) && (big[*p_nw - 1] == 0)) {
+        (*p_nw)--;
+    }
+    return rem;
+}
+
+static bool_t big_is_zero(const uint32_t *big, int nw)
+{
+    int i;
+    for (i = 0; i < nw; i++) {
+        if (big[i] != 0) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+#endif /* XF_PRINTF_ENABLE_FLOAT */
@@ -0,0 +1,70 @@
+/**
+ * @file xf_printf.h
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 无堆分配的格式化输出。
+ * @version 1.0
+ * @date 2025-07-06
+ *
+ * SPDX-FileCopyrightText: 2025 CompanyNameMagicTag
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef __XF_PRINTF_H__
+#define __XF_PRINTF_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "../common/xf_common.h"
+
+#include <stdarg.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief 格式化到缓冲区.
+ *
+ * 支持:
+ *      - 转换: %d %i %u %x %X %o %c %s %p %% , 以及 XF_PRINTF_ENABLE_FLOAT 时的 %f %F.
+ *      - 标志: '-' '0' '+' ' ' '#'.
+ *      - 宽度与精度: 数字或 '*'.
+ *      - 长度: hh h l ll z j t, 以及浮点数的 L（按 double 处理）.
+ *
+ * %p 总带 "0x" 前缀，NULL 输出 "0x0".
+ * %f 对任意精度、任意大小的有限值输出精确的十进制数字（舍入到最近，一半取偶），
+ * 结果与 glibc 相同，-0.0 输出 "-0.000000".
+ *
+ * 不支持的浮点转换（%e %g %a, 以及未开启 XF_PRINTF_ENABLE_FLOAT 时的 %f）仍按类型取出参数，
+ * 原样输出转换说明，后面的参数不会错位。%n 取出参数但不写入。
+ *
+ * 不使用堆，栈占用固定（不随格式化内容变化），可在中断中调用。
+ * 开启 XF_PRINTF_ENABLE_FLOAT 时 %f 需要约 350 字节栈（大数运算）。
+ *
+ * @param buf       输出缓冲区，可为 NULL（此时 size 必须为 0）。
+ * @param size      缓冲区大小，结果总以 '\0' 结尾（size 为 0 时除外）。
+ * @param format    格式化字符串。
+ * @param args      参数。
+ * @return int      缓冲区足够大时应输出的字符数（不含 '\0'），与 C99 vsnprintf 相同。
+ */
+int xf_vsnprintf(char *buf, size_t size, const char *format, va_list args);
+
+/**
+ * @brief 格式化到缓冲区，见 xf_vsnprintf().
+ */
+int xf_snprintf(char *buf, size_t size, const char *format, ...);
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* __XF_PRINTF_H__ */
@@ -16,6 +16,7 @@
 /* ==================== [Includes] ========================================== */
 
 #include "xf_string.h"
+#include "xf_printf.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -22,11 +22,72 @@
 /* ==================== [Defines] =========================================== */
 
 #define ALIGN_MASK       (sizeof(void *) - 1)
+#define WORD_MASK        (sizeof(uint32_t) - 1)
+
+/*
+    XF_STRING_ENABLE_SIMD 时按编译目标选择向量指令集，
+    XF_SIMD_WIDTH 为 0 表示不支持，退化为按字处理。
+ */
+#if XF_STRING_ENABLE_SIMD && defined(__AVX2__)
+#   include <immintrin.h>
+#   define XF_SIMD_WIDTH                32
+typedef __m256i xf_simd_t;
+#   define XF_SIMD_LOAD(p)              _mm256_loadu_si256((const __m256i *)(const void *)(p))
+#   define XF_SIMD_STORE(p, v)          _mm256_storeu_si256((__m256i *)(void *)(p), (v))
+#   define XF_SIMD_SET1(b)              _mm256_set1_epi8((char)(b))
+#   define XF_SIMD_EQUAL(a, b)          \
+        ((uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8((a), (b))) == 0xFFFFFFFFU)
+#   define XF_SIMD_HAS_ZERO(a)          \
+        (_mm256_movemask_epi8(_mm256_cmpeq_epi8((a), _mm256_setzero_si256())) != 0)
+#elif XF_STRING_ENABLE_SIMD && defined(__SSE2__)
+#   include <emmintrin.h>
+#   define XF_SIMD_WIDTH                16
+typedef __m128i xf_simd_t;
+#   define XF_SIMD_LOAD(p)              _mm_loadu_si128((const __m128i *)(const void *)(p))
+#   define XF_SIMD_STORE(p, v)          _mm_storeu_si128((__m128i *)(void *)(p), (v))
+#   define XF_SIMD_SET1(b)              _mm_set1_epi8((char)(b))
+#   define XF_SIMD_EQUAL(a, b)          \
+        ((uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8((a), (b))) == 0xFFFFU)
+#   define XF_SIMD_HAS_ZERO(a)          \
+        (_mm_movemask_epi8(_mm_cmpeq_epi8((a), _mm_setzero_si128())) != 0)
+#elif XF_STRING_ENABLE_SIMD && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#   include <arm_neon.h>
+#   define XF_SIMD_WIDTH                16
+typedef uint8x16_t xf_simd_t;
+#   define XF_SIMD_LOAD(p)              vld1q_u8((const uint8_t *)(p))
+#   define XF_SIMD_STORE(p, v)          vst1q_u8((uint8_t *)(p), (v))
+#   define XF_SIMD_SET1(b)              vdupq_n_u8((uint8_t)(b))
+#   define XF_SIMD_EQUAL(a, b)          xf_simd_neon_equal((a), (b))
+#   define XF_SIMD_HAS_ZERO(a)          (!xf_simd_neon_equal(vminq_u8((a), vdupq_n_u8(1)), vdupq_n_u8(1)))
+#else
+#   define XF_SIMD_WIDTH                0
+#endif
+
+/*
+    按字查找 0 字节: 某字节为 0 时 (x - 0x01..) & ~x & 0x80.. 在该字节最高位非 0.
+    只读取对齐的字，对齐字不会跨页，因此读到字符串末尾之后的几个字节是安全的。
+ */
+#define WORD_ONES        ((uintptr_t)-1 / 0xFFU)
+#define WORD_HIGHS       (WORD_ONES * 0x80U)
+#define WORD_HAS_ZERO(x) ((((x) - WORD_ONES) & ~(x) & WORD_HIGHS) != 0)
+#define WORD_SIZE        sizeof(uintptr_t)
+#define WORD_ALIGNED(p)  (((uintptr_t)(p) & (WORD_SIZE - 1)) == 0)
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+/* 拼接两个对齐字中偏移 _sh 位开始的 32 位 */
+#   define _MERGE(w0, w1, sh)           (((w0) << (sh)) | ((w1) >> (32U - (sh))))
+#else
+#   define _MERGE(w0, w1, sh)           (((w0) >> (sh)) | ((w1) << (32U - (sh))))
+#endif
 
 /* ==================== [Typedefs] ========================================== */
 
 /* ==================== [Static Prototypes] ================================= */
 
+#if !XF_SIMD_WIDTH
+static uint8_t *xf_memcpy_shift(uint8_t *d8, const uint8_t *s8, size_t *p_len);
+#endif
+
 /* ==================== [Static Variables] ================================== */
 
 /* ==================== [Macros] ============================================ */
@@ -35,6 +96,14 @@
 #define _SET(d, v) *d = v; d++;
 #define _REPEAT8(expr) expr expr expr expr expr expr expr expr
 
+#if (XF_SIMD_WIDTH != 0) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+static inline bool_t xf_simd_neon_equal(uint8x16_t a, uint8x16_t b)
+{
+    uint64x2_t eq = vreinterpretq_u64_u8(vceqq_u8(a, b));
+    return (vgetq_lane_u64(eq, 0) & vgetq_lane_u64(eq, 1)) == UINT64_MAX;
+}
+#endif
+
 /* ==================== [Global Functions] ================================= */
 
 void *XF_ATTR_FAST_MEM xf_memcpy(void *dst, const void *src, size_t len)
@@ -53,18 +122,41 @@ void *XF_ATTR_FAST_MEM xf_memcpy(void *dst, const void *src, size_t len)
         return dst;
     }
 
+#if XF_SIMD_WIDTH
+    /* 非对齐向量读写，先读后写，对 dst < src 的重叠区也安全（供 xf_memmove 使用） */
+    while (len >= (XF_SIMD_WIDTH * 4)) {
+        xf_simd_t v0 = XF_SIMD_LOAD(s8);
+        xf_simd_t v1 = XF_SIMD_LOAD(s8 + XF_SIMD_WIDTH);
+        xf_simd_t v2 = XF_SIMD_LOAD(s8 + XF_SIMD_WIDTH * 2);
+        xf_simd_t v3 = XF_SIMD_LOAD(s8 + XF_SIMD_WIDTH * 3);
+        XF_SIMD_STORE(d8, v0);
+        XF_SIMD_STORE(d8 + XF_SIMD_WIDTH, v1);
+        XF_SIMD_STORE(d8 + XF_SIMD_WIDTH * 2, v2);
+        XF_SIMD_STORE(d8 + XF_SIMD_WIDTH * 3, v3);
+        d8 += XF_SIMD_WIDTH * 4;
+        s8 += XF_SIMD_WIDTH * 4;
+        len -= XF_SIMD_WIDTH * 4;
+    }
+    while (len >= XF_SIMD_WIDTH) {
+        XF_SIMD_STORE(d8, XF_SIMD_LOAD(s8));
+        d8 += XF_SIMD_WIDTH;
+        s8 += XF_SIMD_WIDTH;
+        len -= XF_SIMD_WIDTH;
+    }
+    while (len) {
+        _COPY(d8, s8)
+        len--;
+    }
+    return dst;
+#else
+
     uintptr_t d_align = (uintptr_t)d8 & ALIGN_MASK;
     uintptr_t s_align = (uintptr_t)s8 & ALIGN_MASK;
 
-    /*Byte copy for unaligned memories*/
+    /*Word copy with shifts for unaligned memories*/
     if (s_align != d_align) {
-        while (len > 32) {
-            _REPEAT8(_COPY(d8, s8));
-            _REPEAT8(_COPY(d8, s8));
-            _REPEAT8(_COPY(d8, s8));
-            _REPEAT8(_COPY(d8, s8));
-            len -= 32;
-        }
+        d8 = xf_memcpy_shift(d8, s8, &len);
+        s8 = (const uint8_t *)src + ((size_t)(d8 - (uint8_t *)dst));
         while (len) {
             _COPY(d8, s8)
             len--;
@@ -97,11 +189,32 @@ void *XF_ATTR_FAST_MEM xf_memcpy(void *dst, const void *src, size_t len)
     }
 
     return dst;
+#endif /* XF_SIMD_WIDTH */
 }
 
 void XF_ATTR_FAST_MEM xf_memset(void *dst, uint8_t v, size_t len)
 {
     uint8_t *d8 = (uint8_t *)dst;
+
+#if XF_SIMD_WIDTH
+    if (len >= XF_SIMD_WIDTH) {
+        xf_simd_t vv = XF_SIMD_SET1(v);
+        while (len >= (XF_SIMD_WIDTH * 4)) {
+            XF_SIMD_STORE(d8, vv);
+            XF_SIMD_STORE(d8 + XF_SIMD_WIDTH, vv);
+            XF_SIMD_STORE(d8 + XF_SIMD_WIDTH * 2, vv);
+            XF_SIMD_STORE(d8 + XF_SIMD_WIDTH * 3, vv);
+            d8 += XF_SIMD_WIDTH * 4;
+            len -= XF_SIMD_WIDTH * 4;
+        }
+        while (len >= XF_SIMD_WIDTH) {
+            XF_SIMD_STORE(d8, vv);
+            d8 += XF_SIMD_WIDTH;
+            len -= XF_SIMD_WIDTH;
+        }
+    }
+#endif /* XF_SIMD_WIDTH */
+
     uintptr_t d_align = (uintptr_t) d8 & ALIGN_MASK;
 
     /*Make the address aligned*/
@@ -121,6 +234,10 @@ void XF_ATTR_FAST_MEM xf_memset(void *dst, uint8_t v, size_t len)
         _REPEAT8(_SET(d32, v32));
         len -= 32;
     }
+    while (len >= sizeof(uint32_t)) {
+        _SET(d32, v32);
+        len -= sizeof(uint32_t);
+    }
 
     d8 = (uint8_t *)d32;
     while (len) {
@@ -136,20 +253,36 @@ void *XF_ATTR_FAST_MEM xf_memmove(void *dst, const void *src, size_t len)
     }
 
     if (dst > src) {
-        char *tmp = (char *)dst + len - 1;
-        const char *s = (const char *)src + len - 1;
-
-        while (len--) {
-            /* cppcheck-suppress misra-c2012-13.3 */
-            *tmp-- = *s--;
+        uint8_t *d8 = (uint8_t *)dst + len;
+        const uint8_t *s8 = (const uint8_t *)src + len;
+
+#if XF_SIMD_WIDTH
+        /* 从尾部向前按块复制，每块先读后写 */
+        while (len >= XF_SIMD_WIDTH) {
+            d8 -= XF_SIMD_WIDTH;
+            s8 -= XF_SIMD_WIDTH;
+            XF_SIMD_STORE(d8, XF_SIMD_LOAD(s8));
+            len -= XF_SIMD_WIDTH;
         }
-    } else {
-        char *tmp = (char *)dst;
-        const char *s = (const char *)src;
+#else
+        /* 两者对齐方式相同时按字复制 */
+        if ((((uintptr_t)d8 ^ (uintptr_t)s8) & WORD_MASK) == 0) {
+            while ((len != 0) && (((uintptr_t)d8 & WORD_MASK) != 0)) {
+                *--d8 = *--s8;
+                len--;
+            }
+            while (len >= sizeof(uint32_t)) {
+                d8 -= sizeof(uint32_t);
+                s8 -= sizeof(uint32_t);
+                *(uint32_t *)d8 = *(const uint32_t *)s8;
+                len -= sizeof(uint32_t);
+            }
+        }
+#endif /* XF_SIMD_WIDTH */
 
         while (len--) {
             /* cppcheck-suppress misra-c2012-13.3 */
-            *tmp++ = *s++;
+            *--d8 = *--s8;
         }
     }
 
@@ -158,47 +291,133 @@ void *XF_ATTR_FAST_MEM xf_memmove(void *dst, const void *src, size_t len)
 
 int xf_memcmp(const void *p1, const void *p2, size_t len)
 {
-    const char *s1 = (const char *) p1;
-    const char *s2 = (const char *) p2;
-    while ((--len > 0) && (*s1 == *s2)) {
+    const uint8_t *s1 = (const uint8_t *) p1;
+    const uint8_t *s2 = (const uint8_t *) p2;
+
+#if XF_SIMD_WIDTH
+    while ((len >= XF_SIMD_WIDTH) && XF_SIMD_EQUAL(XF_SIMD_LOAD(s1), XF_SIMD_LOAD(s2))) {
+        s1 += XF_SIMD_WIDTH;
+        s2 += XF_SIMD_WIDTH;
+        len -= XF_SIMD_WIDTH;
+    }
+#else
+    /* 对齐方式相同时按字跳过相同部分，不同处交给逐字节比较 */
+    if ((((uintptr_t)s1 ^ (uintptr_t)s2) & WORD_MASK) == 0) {
+        while ((len != 0) && (((uintptr_t)s1 & WORD_MASK) != 0)) {
+            if (*s1 != *s2) {
+                return *s1 - *s2;
+            }
+            s1++;
+            s2++;
+            len--;
+        }
+        while ((len >= sizeof(uint32_t))
+                && (*(const uint32_t *)s1 == *(const uint32_t *)s2)) {
+            s1 += sizeof(uint32_t);
+            s2 += sizeof(uint32_t);
+            len -= sizeof(uint32_t);
+        }
+    }
+#endif /* XF_SIMD_WIDTH */
+
+    while (len) {
+        if (*s1 != *s2) {
+            return *s1 - *s2;
+        }
         s1++;
         s2++;
+        len--;
     }
-    return *s1 - *s2;
+    return 0;
 }
 
 /* See https://en.cppreference.com/w/c/string/byte/strlen for reference */
 size_t xf_strlen(const char *str)
 {
-    size_t i = 0;
-    while (str[i]) {
-        i++;
+    const char *s = str;
+    const uintptr_t *w;
+
+    while (!WORD_ALIGNED(s)) {
+        if (*s == '\0') {
+            return (size_t)(s - str);
+        }
+        s++;
     }
-    return i;
+#if XF_SIMD_WIDTH
+    /* 先按字对齐到向量宽度，之后每次读取一个对齐的向量 */
+    while ((((uintptr_t)s & (XF_SIMD_WIDTH - 1)) != 0)
+            && !WORD_HAS_ZERO(*(const uintptr_t *)s)) {
+        s += WORD_SIZE;
+    }
+    if (((uintptr_t)s & (XF_SIMD_WIDTH - 1)) == 0) {
+        while (!XF_SIMD_HAS_ZERO(XF_SIMD_LOAD(s))) {
+            s += XF_SIMD_WIDTH;
+        }
+    }
+#endif /* XF_SIMD_WIDTH */
+    w = (const uintptr_t *)s;
+    while (!WORD_HAS_ZERO(*w)) {
+        w++;
+    }
+    s = (const char *)w;
+    while (*s != '\0') {
+        s++;
+    }
+    return (size_t)(s - str);
 }
 
 size_t xf_strnlen(const char *str, size_t maxlen)
 {
-    size_t i = 0;
-    while ((i < maxlen) && str[i]) {
-        i++;
+    const char *s = str;
+    const char *end;
+
+    if (maxlen > ((size_t)-1 - (uintptr_t)str)) {
+        /* 防止 end 回绕 */
+        end = (const char *)(uintptr_t)-1;
+    } else {
+        end = str + maxlen;
+    }
+    while ((s < end) && !WORD_ALIGNED(s)) {
+        if (*s == '\0') {
+            return (size_t)(s - str);
+        }
+        s++;
     }
-    return i;
+    while (((size_t)(end - s) >= WORD_SIZE) && !WORD_HAS_ZERO(*(const uintptr_t *)s)) {
+        s += WORD_SIZE;
+    }
+    while ((s < end) && (*s != '\0')) {
+        s++;
+    }
+    return (size_t)(s - str);
 }
 
 size_t xf_strlcpy(char *dst, const char *src, size_t dst_size)
 {
     size_t i = 0;
     if (dst_size > 0) {
+        /* 两者对齐方式相同时按字复制，留出 '\0' 的位置 */
+        if ((((uintptr_t)dst ^ (uintptr_t)src) & (WORD_SIZE - 1)) == 0) {
+            for (; (i < (dst_size - 1)) && !WORD_ALIGNED(&src[i]) && src[i]; i++) {
+                dst[i] = src[i];
+            }
+            if (WORD_ALIGNED(&src[i])) {
+                while (((dst_size - 1 - i) >= WORD_SIZE)
+                        && !WORD_HAS_ZERO(*(const uintptr_t *)&src[i])) {
+                    *(uintptr_t *)&dst[i] = *(const uintptr_t *)&src[i];
+                    i += WORD_SIZE;
+                }
+            }
+        }
         for (; i < (dst_size - 1) && src[i]; i++) {
             dst[i] = src[i];
         }
         dst[i] = '\0';
     }
-    while (src[i]) {
-        i++;
+    if (src[i] == '\0') {
+        return i;
     }
-    return i;
+    return i + xf_strlen(&src[i]);
 }
 
 char *xf_strncpy(char *dst, const char *src, size_t dst_size)
@@ -224,6 +443,21 @@ char *xf_strcpy(char *dst, const char *src)
 
 int xf_strcmp(const char *s1, const char *s2)
 {
+    /* 两者对齐方式相同时按字跳过相同且不含 '\0' 的部分 */
+    if ((((uintptr_t)s1 ^ (uintptr_t)s2) & (WORD_SIZE - 1)) == 0) {
+        while (!WORD_ALIGNED(s1)) {
+            if ((*s1 == '\0') || (*s1 != *s2)) {
+                return *(const unsigned char *)s1 - *(const unsigned char *)s2;
+            }
+            s1++;
+            s2++;
+        }
+        while ((*(const uintptr_t *)s1 == *(const uintptr_t *)s2)
+                && !WORD_HAS_ZERO(*(const uintptr_t *)s1)) {
+            s1 += WORD_SIZE;
+            s2 += WORD_SIZE;
+        }
+    }
     while (*s1 && (*s1 == *s2)) {
         s1++;
         s2++;
@@ -271,4 +505,56 @@ char *xf_strncat(char *dst, const char *src, size_t src_len)
 
 /* ==================== [Static Functions] ================================== */
 
+#if !XF_SIMD_WIDTH
+/**
+ * @brief 源与目的对齐方式不同时的按字复制.
+ *
+ * 先把目的地址按字对齐，之后每次从源读取一个对齐字，与上一个字移位拼接后写入。
+ * 只读取包含所需字节的对齐字，不会越过源数据所在的字读到下一页。
+ *
+ * @param d8        目的地址。
+ * @param s8        源地址。
+ * @param p_len     剩余长度，返回未复制的长度（小于一个字）。
+ * @return uint8_t* 下一个待写入的目的地址。
+ */
+static uint8_t *xf_memcpy_shift(uint8_t *d8, const uint8_t *s8, size_t *p_len)
+{
+    size_t len = *p_len;
+    uint32_t *d32;
+    const uint32_t *s32;
+    uint32_t w0;
+    uint32_t w1;
+    uint32_t sh;
+
+    while ((len != 0) && (((uintptr_t)d8 & WORD_MASK) != 0)) {
+        _COPY(d8, s8)
+        len--;
+    }
+    sh = (uint32_t)((uintptr_t)s8 & WORD_MASK) * 8U;
+    if ((sh == 0) || (len < sizeof(uint32_t))) {
+        /* 对齐后恰好同为字对齐 */
+        d32 = (uint32_t *)d8;
+        s32 = (const uint32_t *)s8;
+        while (len >= sizeof(uint32_t)) {
+            _COPY(d32, s32)
+            len -= sizeof(uint32_t);
+        }
+        *p_len = len;
+        return (uint8_t *)d32;
+    }
+    d32 = (uint32_t *)d8;
+    s32 = (const uint32_t *)(const void *)(s8 - (sh / 8U));
+    w0 = *s32++;
+    /* 每写一个字都要用到下一个对齐字的前 (sh / 8) 字节，故读取的都是有效数据 */
+    while (len >= sizeof(uint32_t)) {
+        w1 = *s32++;
+        *d32++ = _MERGE(w0, w1, sh);
+        w0 = w1;
+        len -= sizeof(uint32_t);
+    }
+    *p_len = len;
+    return (uint8_t *)d32;
+}
+#endif /* !XF_SIMD_WIDTH */
+
 #endif /* XF_STRING_ENABLE_BUILTIN */
@@ -0,0 +1,164 @@
+/**
+ * @file xf_chan.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief
+ * @version 1.0
+ * @date 2025-07-01
+ *
+ * SPDX-FileCopyrightText: 2025 CompanyNameMagicTag
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_chan.h"
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "xf_chan"
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static void xf_chan_add_waiter(xf_bitmap32_t *p_bm, const xf_task_t *me);
+static bool_t xf_chan_wakeup_one(xf_bitmap32_t *p_bm);
+static void xf_chan_wakeup_all(xf_bitmap32_t *p_bm);
+
+/* ==================== [Static Variables] ================================== */
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+xf_err_t xf_chan_init(
+    xf_chan_t *p_chan, void *p_buf, xf_dq_size_t elem_size, xf_dq_size_t elem_num)
+{
+    uint32_t buf_size;
+    if ((p_chan == NULL) || (elem_size == 0) || (elem_num == 0)) {
+        return XF_ERR_INVALID_ARG;
+    }
+    buf_size = (uint32_t)elem_size * elem_num;
+    if (buf_size > (xf_dq_size_t)~(xf_dq_size_t)0) {
+        return XF_ERR_INVALID_ARG;
+    }
+    xf_memset(p_chan, 0, sizeof(xf_chan_t));
+    p_chan->elem_size = elem_size;
+    return xf_deque_init(&p_chan->dq, p_buf, (xf_dq_size_t)buf_size);
+}
+
+xf_err_t xf_chan_reset(xf_chan_t *p_chan)
+{
+    XF_CRIT_STAT();
+    if (p_chan == NULL) {
+        return XF_ERR_INVALID_ARG;
+    }
+    XF_CRIT_ENTRY();
+    xf_deque_reset(&p_chan->dq);
+    XF_CRIT_EXIT();
+    xf_chan_wakeup_all(p_chan->bm_send);
+    xf_chan_wakeup_all(p_chan->bm_recv);
+    return XF_OK;
+}
+
+xf_dq_size_t xf_chan_get_filled(const xf_chan_t *p_chan)
+{
+    if ((p_chan == NULL) || (p_chan->elem_size == 0)) {
+        return 0;
+    }
+    return xf_deque_get_filled(&p_chan->dq) / p_chan->elem_size;
+}
+
+xf_dq_size_t xf_chan_get_empty(const xf_chan_t *p_chan)
+{
+    if ((p_chan == NULL) || (p_chan->elem_size == 0)) {
+        return 0;
+    }
+    return xf_deque_get_empty(&p_chan->dq) / p_chan->elem_size;
+}
+
+xf_err_t xf_chan_send_(
+    xf_chan_t *p_chan, xf_task_t *me, const void *p_elem, xf_dq_size_t elem_size)
+{
+    xf_dq_size_t pushed_size = 0;
+    XF_CRIT_STAT();
+    if ((p_chan == NULL) || (p_elem == NULL)
+            || (elem_size != p_chan->elem_size)) {
+        XF_ERROR_LINE(); XF_LOGD(TAG, "invalid arg");
+        return XF_ERR_INVALID_ARG;
+    }
+    XF_CRIT_ENTRY();
+    if (xf_deque_get_empty(&p_chan->dq) >= elem_size) {
+        pushed_size = xf_deque_back_push(&p_chan->dq, p_elem, elem_size);
+    } else if (me != NULL) {
+        /* 与满判断在同一临界区内登记，避免错过唤醒 */
+        xf_chan_add_waiter(p_chan->bm_send, me);
+    }
+    XF_CRIT_EXIT();
+    if (pushed_size != elem_size) {
+        return XF_ERR_BUSY;
+    }
+    xf_chan_wakeup_one(p_chan->bm_recv);
+    return XF_OK;
+}
+
+xf_err_t xf_chan_recv_(
+    xf_chan_t *p_chan, xf_task_t *me, void *p_elem, xf_dq_size_t elem_size)
+{
+    xf_dq_size_t popped_size = 0;
+    XF_CRIT_STAT();
+    if ((p_chan == NULL) || (elem_size != p_chan->elem_size)) {
+        XF_ERROR_LINE(); XF_LOGD(TAG, "invalid arg");
+        return XF_ERR_INVALID_ARG;
+    }
+    XF_CRIT_ENTRY();
+    if (xf_deque_get_filled(&p_chan->dq) >= elem_size) {
+        popped_size = (p_elem != NULL)
+                      ? xf_deque_front_pop(&p_chan->dq, p_elem, elem_size)
+                      : xf_deque_front_remove(&p_chan->dq, elem_size);
+    } else if (me != NULL) {
+        xf_chan_add_waiter(p_chan->bm_recv, me);
+    }
+    XF_CRIT_EXIT();
+    if (popped_size != elem_size) {
+        return XF_ERR_BUSY;
+    }
+    xf_chan_wakeup_one(p_chan->bm_send);
+    return XF_OK;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static void xf_chan_add_waiter(xf_bitmap32_t *p_bm, const xf_task_t *me)
+{
+    xf_task_id_t id = xf_task_to_id(me);
+    if (id == XF_TASK_ID_INVALID) {
+        XF_FATAL_ERROR();
+        return;
+    }
+    XF_BITMAP32_SET1(p_bm, id);
+}
+
+static bool_t xf_chan_wakeup_one(xf_bitmap32_t *p_bm)
+{
+    int32_t idx;
+    XF_CRIT_STAT();
+    XF_CRIT_ENTRY();
+    idx = xf_bitmap32_ffs(p_bm, XF_TASK_NUM_MAX);
+    if (idx >= 0) {
+        XF_BITMAP32_SET0(p_bm, idx);
+    }
+    XF_CRIT_EXIT();
+    if (idx < 0) {
+        return FALSE;
+    }
+    xf_task_wakeup(xf_task_id_to_task((xf_task_id_t)idx));
+    return TRUE;
+}
+
+static void xf_chan_wakeup_all(xf_bitmap32_t *p_bm)
+{
+    while (xf_chan_wakeup_one(p_bm)) {
+    }
+}
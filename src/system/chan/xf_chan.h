@@ -0,0 +1,216 @@
+/**
+ * @file xf_chan.h
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 任务间有界通道 (channel)。
+ * @version 1.0
+ * @date 2025-07-01
+ *
+ * SPDX-FileCopyrightText: 2025 CompanyNameMagicTag
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+/*
+    NOTE 通道原理
+
+    1.  通道基于 xf_dq_t, 以固定大小的元素为单位收发，缓冲区由用户提供。
+    1.  发送时通道已满（或接收时通道为空），当前任务登记到通道的等待位图，
+        然后阻塞。
+    1.  对端收发成功后直接唤醒一个等待中的任务（设为就绪并恢复调度器），
+        不经过 xf_ps 的事件队列。
+    1.  被唤醒的任务重新尝试收发，失败则再次登记并阻塞。
+    1.  唤醒会修改任务状态和调度定时器，这些操作不是中断安全的，
+        因此所有收发接口（包括 try_*）只能在任务或主循环中调用，不能在中断内调用。
+ */
+
+#ifndef __XF_CHAN_H__
+#define __XF_CHAN_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "../../utils/xf_utils.h"
+
+#include "../task/xf_task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief 有界通道。
+ */
+typedef struct xf_chan {
+    xf_dq_t                 dq;             /*!< 元素队列 */
+    xf_dq_size_t            elem_size;      /*!< 元素大小（字节） */
+    /* 等待发送的任务（通道满） */
+    xf_bitmap32_t           bm_send[XF_BITMAP32_GET_BLK_SIZE(XF_TASK_NUM_MAX)];
+    /* 等待接收的任务（通道空） */
+    xf_bitmap32_t           bm_recv[XF_BITMAP32_GET_BLK_SIZE(XF_TASK_NUM_MAX)];
+} xf_chan_t;
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief 初始化通道.
+ *
+ * @param p_chan        通道。
+ * @param p_buf         元素缓冲区，大小为 elem_size * elem_num 字节。
+ * @param elem_size     元素大小（字节）。
+ * @param elem_num      元素数量。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_OK                 成功
+ */
+xf_err_t xf_chan_init(
+    xf_chan_t *p_chan, void *p_buf, xf_dq_size_t elem_size, xf_dq_size_t elem_num);
+
+/**
+ * @brief 清空通道，并唤醒所有等待中的任务.
+ *
+ * @param p_chan        通道。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_OK                 成功
+ */
+xf_err_t xf_chan_reset(xf_chan_t *p_chan);
+
+/**
+ * @brief 获取通道内元素数量.
+ *
+ * @param p_chan        通道。
+ * @return xf_dq_size_t 元素数量。
+ */
+xf_dq_size_t xf_chan_get_filled(const xf_chan_t *p_chan);
+
+/**
+ * @brief 获取通道内剩余可发送的元素数量.
+ *
+ * @param p_chan        通道。
+ * @return xf_dq_size_t 剩余元素数量。
+ */
+xf_dq_size_t xf_chan_get_empty(const xf_chan_t *p_chan);
+
+/**
+ * @brief 发送一个元素.
+ *
+ * @param p_chan        通道。
+ * @param me            发送任务。不为 NULL 且通道已满时，登记为等待发送的任务。
+ * @param p_elem        元素。
+ * @param elem_size     元素大小，必须与通道元素大小一致。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_BUSY           通道已满
+ *      - XF_OK                 成功
+ */
+xf_err_t xf_chan_send_(
+    xf_chan_t *p_chan, xf_task_t *me, const void *p_elem, xf_dq_size_t elem_size);
+
+/**
+ * @brief 接收一个元素.
+ *
+ * @param p_chan        通道。
+ * @param me            接收任务。不为 NULL 且通道为空时，登记为等待接收的任务。
+ * @param p_elem        元素，为 NULL 时丢弃。
+ * @param elem_size     元素大小，必须与通道元素大小一致。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_BUSY           通道为空
+ *      - XF_OK                 成功
+ */
+xf_err_t xf_chan_recv_(
+    xf_chan_t *p_chan, xf_task_t *me, void *p_elem, xf_dq_size_t elem_size);
+
+/* ==================== [Macros] ============================================ */
+
+/**
+ * @brief 以数组作为缓冲区初始化通道，元素类型即数组元素类型.
+ *
+ * @param _p_chan       通道。 @ref xf_chan_t* .
+ * @param _buf_array    缓冲区数组（不能是指针）。
+ */
+#define xf_chan_init_array(_p_chan, _buf_array) \
+                                        xf_chan_init((_p_chan), (void *)(_buf_array), \
+                                                     (xf_dq_size_t)sizeof((_buf_array)[0]), \
+                                                     (xf_dq_size_t)ARRAY_SIZE(_buf_array))
+
+/**
+ * @brief 非阻塞发送，可在任务外的主循环中使用.
+ *
+ * @warning 不能在中断内调用：发送成功时会唤醒等待接收的任务。
+ *
+ * @param _p_chan       通道。 @ref xf_chan_t* .
+ * @param _p_elem       元素指针，元素大小由指针类型决定。
+ * @return xf_err_t     见 @ref xf_chan_send_.
+ */
+#define xf_chan_try_send(_p_chan, _p_elem) \
+                                        xf_chan_send_((_p_chan), NULL, (const void *)(_p_elem), \
+                                                      (xf_dq_size_t)sizeof(*(_p_elem)))
+
+/**
+ * @brief 非阻塞接收，可在任务外的主循环中使用.
+ *
+ * @warning 不能在中断内调用：接收成功时会唤醒等待发送的任务。
+ *
+ * @param _p_chan       通道。 @ref xf_chan_t* .
+ * @param _p_elem       元素指针，元素大小由指针类型决定。
+ * @return xf_err_t     见 @ref xf_chan_recv_.
+ */
+#define xf_chan_try_recv(_p_chan, _p_elem) \
+                                        xf_chan_recv_((_p_chan), NULL, (void *)(_p_elem), \
+                                                      (xf_dq_size_t)sizeof(*(_p_elem)))
+
+#define xf_chan_send_i(_me, _p_chan, _p_elem) \
+                                        do { \
+                                            while (xf_chan_send_((_p_chan), xf_task_cast(_me), \
+                                                                 (const void *)(_p_elem), \
+                                                                 (xf_dq_size_t)sizeof(*(_p_elem))) \
+                                                    == XF_ERR_BUSY) { \
+                                                xf_task_block_i((_me)); \
+                                            } \
+                                        } while (0)
+
+#define xf_chan_recv_i(_me, _p_chan, _p_elem) \
+                                        do { \
+                                            while (xf_chan_recv_((_p_chan), xf_task_cast(_me), \
+                                                                 (void *)(_p_elem), \
+                                                                 (xf_dq_size_t)sizeof(*(_p_elem))) \
+                                                    == XF_ERR_BUSY) { \
+                                                xf_task_block_i((_me)); \
+                                            } \
+                                        } while (0)
+
+/**
+ * @brief 任务内发送，通道已满时阻塞，直到有接收方取走元素.
+ *
+ * @warning 阻塞期间任务函数的局部变量不会保留，
+ *          _p_elem 指向的数据必须位于 user_data 或静态存储中。
+ * @warning 不要销毁阻塞在通道上的任务。
+ *
+ * @param _me           当前任务。 @ref xf_task_t* .
+ * @param _p_chan       通道。 @ref xf_chan_t* .
+ * @param _p_elem       元素指针，元素大小由指针类型决定。
+ */
+#define xf_chan_send(_me, _p_chan, _p_elem) \
+                                        xf_chan_send_i((_me), (_p_chan), (_p_elem))
+
+/**
+ * @brief 任务内接收，通道为空时阻塞，直到有发送方放入元素.
+ *
+ * @warning 不要销毁阻塞在通道上的任务。
+ *
+ * @param _me           当前任务。 @ref xf_task_t* .
+ * @param _p_chan       通道。 @ref xf_chan_t* .
+ * @param[out] _p_elem  传出元素，元素大小由指针类型决定。
+ */
+#define xf_chan_recv(_me, _p_chan, _p_elem) \
+                                        xf_chan_recv_i((_me), (_p_chan), (_p_elem))
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* __XF_CHAN_H__ */
@@ -25,7 +25,11 @@ typedef xf_bitmap_t xf_event_bitmap_t;
 /* ==================== [Static Variables] ================================== */
 
 /* 唯一事件 id 位图 */
-static xf_event_bitmap_t s_eid_bm[XF_BITMAP32_GET_BLK_SIZE(XF_EVENT_ID_NUM_MAX)];
+#if XF_EVENT_ENABLE_HBITMAP
+XF_HBITMAP_DEFINE_STATIC(s_eid_hbm, XF_EVENT_ID_NUM_MAX);
+#else
+static xf_event_bitmap_t s_eid_bm[XF_BITMAP_GET_BLK_SIZE(XF_EVENT_ID_NUM_MAX)];
+#endif
 
 /* ==================== [Macros] ============================================ */
 
@@ -34,31 +38,50 @@ static xf_event_bitmap_t s_eid_bm[XF_BITMAP32_GET_BLK_SIZE(XF_EVENT_ID_NUM_MAX)]
 xf_event_id_t xf_event_acquire_id(void)
 {
     int32_t idx;
+#if XF_EVENT_ENABLE_HBITMAP
     XF_CRIT_STAT();
     XF_CRIT_ENTRY();
-    idx = xf_bitmap32_ffz(s_eid_bm, XF_EVENT_ID_NUM_MAX);
+    idx = xf_hbitmap_ffz(&s_eid_hbm);
+    if (idx >= 0) {
+        (void)xf_hbitmap_set1(&s_eid_hbm, (uint32_t)idx);
+    }
     XF_CRIT_EXIT();
     if (idx < 0) {
         return XF_EVENT_ID_INVALID;
     }
-    XF_BITMAP32_SET1(s_eid_bm, idx);
+#else
+    /* 查找与置位是一次比较交换，不需要临界区 */
+    idx = xf_bitmap_ffz_claim(s_eid_bm, XF_EVENT_ID_NUM_MAX);
+    if (idx < 0) {
+        return XF_EVENT_ID_INVALID;
+    }
+#endif
     return idx + XF_EVENT_ID_OFFSET;
 }
 
 xf_err_t xf_event_release_id(xf_event_id_t id)
 {
+#if XF_EVENT_ENABLE_HBITMAP
     XF_CRIT_STAT();
+#endif
     if ((id < XF_EVENT_ID_OFFSET)
             || (id > (XF_EVENT_ID_OFFSET + XF_EVENT_ID_NUM_MAX - 1U))) {
         return XF_FAIL;
     }
     id -= (xf_event_id_t)XF_EVENT_ID_OFFSET;
-    if (XF_BITMAP_GET(s_eid_bm, id) == 0) {
+#if XF_EVENT_ENABLE_HBITMAP
+    XF_CRIT_ENTRY();
+    if (!xf_hbitmap_get(&s_eid_hbm, (uint32_t)id)) {
+        XF_CRIT_EXIT();
         return XF_FAIL;
     }
-    XF_CRIT_ENTRY();
-    XF_BITMAP_SET0(s_eid_bm, id);
+    (void)xf_hbitmap_set0(&s_eid_hbm, (uint32_t)id);
     XF_CRIT_EXIT();
+#else
+    if (!xf_bitmap_test_and_clear(s_eid_bm, (uint32_t)id)) {
+        return XF_FAIL;
+    }
+#endif
     return XF_OK;
 }
 
@@ -0,0 +1,146 @@
+/**
+ * @file xf_prof.c
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 性能剖析区段。
+ * @version 1.0
+ * @date 2025-07-14
+ *
+ * SPDX-FileCopyrightText: 2025 CompanyNameMagicTag
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_prof.h"
+
+#if XF_PROF_ENABLE
+
+#if XF_PROF_COUNTER == 4
+#include <time.h>
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+#if XF_PROF_COUNTER == 1
+#   define DEMCR                        (*(volatile uint32_t *)0xE000EDFCUL)
+#   define DEMCR_TRCENA                 (1UL << 24)
+#   define DWT_CTRL                     (*(volatile uint32_t *)0xE0001000UL)
+#   define DWT_CTRL_CYCCNTENA           (1UL << 0)
+#endif
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+/* ==================== [Static Variables] ================================== */
+
+static xf_prof_zone_t s_zone_pool[XF_PROF_ZONE_NUM_MAX] = {0};
+/* 统计槽用完后的新区段 */
+static xf_prof_zone_t s_zone_other = {"(other)", {0}};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+xf_err_t xf_prof_init(void)
+{
+#if XF_PROF_COUNTER == 1
+    DEMCR |= DEMCR_TRCENA;
+    DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+#endif
+    return xf_prof_reset(NULL);
+}
+
+xf_prof_zone_t *xf_prof_iter_next(const xf_prof_zone_t *zone)
+{
+    uint32_t i;
+    if (zone == &s_zone_other) {
+        return NULL;
+    }
+    i = (zone == NULL) ? 0U : (uint32_t)(zone - &s_zone_pool[0]) + 1U;
+    /* 按首次记录的顺序分配，遇到空槽即结束 */
+    if ((i < XF_PROF_ZONE_NUM_MAX) && (s_zone_pool[i].name != NULL)) {
+        return &s_zone_pool[i];
+    }
+    return (s_zone_other.stats.count != 0) ? &s_zone_other : NULL;
+}
+
+xf_err_t xf_prof_get_stats(const xf_prof_zone_t *zone, xf_prof_stats_t *p_stats)
+{
+    XF_CRIT_STAT();
+    if ((zone == NULL) || (p_stats == NULL)) {
+        return XF_ERR_INVALID_ARG;
+    }
+    XF_CRIT_ENTRY();
+    *p_stats = zone->stats;
+    XF_CRIT_EXIT();
+    p_stats->avg = (p_stats->count != 0)
+                   ? (xf_prof_cycle_t)(p_stats->total / p_stats->count) : 0U;
+    return XF_OK;
+}
+
+xf_err_t xf_prof_reset(xf_prof_zone_t *zone)
+{
+    uint32_t i;
+    XF_CRIT_STAT();
+    XF_CRIT_ENTRY();
+    if (zone != NULL) {
+        xf_memset(&zone->stats, 0, sizeof(xf_prof_stats_t));
+    } else {
+        for (i = 0; i < XF_PROF_ZONE_NUM_MAX; i++) {
+            xf_memset(&s_zone_pool[i].stats, 0, sizeof(xf_prof_stats_t));
+        }
+        xf_memset(&s_zone_other.stats, 0, sizeof(xf_prof_stats_t));
+    }
+    XF_CRIT_EXIT();
+    return XF_OK;
+}
+
+void xf_prof_record_i(xf_prof_zone_t **pp_zone, const char *name, xf_prof_cycle_t cycles)
+{
+    xf_prof_zone_t *zone;
+    uint32_t i;
+    XF_CRIT_STAT();
+    XF_CRIT_ENTRY();
+    zone = *pp_zone;
+    if (unlikely(zone == NULL)) {
+        /* 第一次记录：同名区段共用统计槽，否则取第一个空槽 */
+        zone = &s_zone_other;
+        for (i = 0; i < XF_PROF_ZONE_NUM_MAX; i++) {
+            if (s_zone_pool[i].name == NULL) {
+                s_zone_pool[i].name = name;
+                zone = &s_zone_pool[i];
+                break;
+            }
+            if (xf_strcmp(s_zone_pool[i].name, name) == 0) {
+                zone = &s_zone_pool[i];
+                break;
+            }
+        }
+        *pp_zone = zone;
+    }
+    /* 清空后 min 为 0, 第一次直接写入 */
+    if ((zone->stats.count == 0) || (cycles < zone->stats.min)) {
+        zone->stats.min = cycles;
+    }
+    zone->stats.count++;
+    zone->stats.total += cycles;
+    if (cycles > zone->stats.max) {
+        zone->stats.max = cycles;
+    }
+    XF_CRIT_EXIT();
+}
+
+#if XF_PROF_COUNTER == 4
+xf_prof_cycle_t xf_prof_get_cycle_i(void)
+{
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (xf_prof_cycle_t)(((uint32_t)ts.tv_sec * 1000000000UL) + (uint32_t)ts.tv_nsec);
+}
+#endif
+
+/* ==================== [Static Functions] ================================== */
+
+#endif /* XF_PROF_ENABLE */
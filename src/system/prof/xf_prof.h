@@ -0,0 +1,217 @@
+/**
+ * @file xf_prof.h
+ * @author catcatBlue (catcatblue@qq.com)
+ * @brief 性能剖析区段。
+ * @version 1.0
+ * @date 2025-07-14
+ *
+ * SPDX-FileCopyrightText: 2025 CompanyNameMagicTag
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+/*
+    NOTE 性能剖析
+
+    1.  XF_PROF_ZONE_BEGIN / XF_PROF_ZONE_END 之间的耗时用高精度计数器测量，
+        按区段名记录次数、最小、最大、累计（平均）值，区段名相同的调用处共用一个统计槽。
+        XF_PROF_ENABLE 为 0 时两个宏只剩一对花括号。
+    1.  计数器按以下顺序选择，单位随之不同:
+        - 用户定义的 XF_PROF_GET_CYCLE(): 由用户决定;
+        - Cortex-M3/M4/M7/M33 的 DWT->CYCCNT: CPU 周期，xf_prof_init() 中使能;
+        - x86 的 rdtsc: TSC 周期;
+        - AArch64 的 CNTVCT_EL0: 通用定时器计数;
+        - 其他主机的 clock_gettime(CLOCK_MONOTONIC): 纳秒;
+        - 以上都没有时使用 xf_tick_get_count(): tick.
+    1.  计数值按 32 位回绕相减，单次耗时不能超过 2^32 个计数
+        （168MHz 的 CYCCNT 约 25 秒, 3GHz 的 TSC 约 1.4 秒）。
+    1.  区段第一次结束时分配统计槽，之后只是一次指针判断。
+        记录在临界区内进行，中断内也可以使用。
+    1.  内置区段: xf_stimer_handler, xf_task_sched, xf_task_run（所有任务体）,
+        xf_ps_dispatch, xf_ps_cb（所有订阅者回调）.
+ */
+
+#ifndef __XF_PROF_H__
+#define __XF_PROF_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "../../utils/xf_utils.h"
+#include "../tick/xf_tick.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+#if XF_PROF_ENABLE
+
+/* 计数器后端: 0: 用户定义; 1: DWT; 2: rdtsc; 3: CNTVCT; 4: clock_gettime; 5: tick */
+#if defined(XF_PROF_GET_CYCLE)
+#   define XF_PROF_COUNTER              0
+#elif defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) \
+        || defined(__ARM_ARCH_8M_MAIN__) || defined(__ARM_ARCH_8_1M_MAIN__)
+#   define XF_PROF_COUNTER              1
+#elif XF_COMMON_ENABLE_BUILTIN && defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#   define XF_PROF_COUNTER              2
+#elif XF_COMMON_ENABLE_BUILTIN && defined(__GNUC__) && defined(__aarch64__)
+#   define XF_PROF_COUNTER              3
+#elif defined(__unix__) || defined(__APPLE__)
+#   define XF_PROF_COUNTER              4
+#else
+#   define XF_PROF_COUNTER              5
+#endif
+
+#if XF_PROF_COUNTER == 1
+#   define XF_PROF_DWT_CYCCNT           (*(volatile uint32_t *)0xE0001004UL)
+#endif
+
+#endif /* XF_PROF_ENABLE */
+
+/* ==================== [Typedefs] ========================================== */
+
+#if XF_PROF_ENABLE
+
+/**
+ * @brief 计数值，按 32 位回绕.
+ */
+typedef uint32_t xf_prof_cycle_t;
+
+#if XF_COMMON_ENABLE_64BITS
+typedef uint64_t xf_prof_sum_t;
+#else
+typedef uint32_t xf_prof_sum_t;
+#endif
+
+/**
+ * @brief 区段统计.
+ */
+typedef struct xf_prof_stats {
+    uint32_t                count;          /*!< 次数 */
+    xf_prof_cycle_t         min;            /*!< 单次最小计数 */
+    xf_prof_cycle_t         max;            /*!< 单次最大计数 */
+    xf_prof_cycle_t         avg;            /*!< 平均计数，仅 xf_prof_get_stats() 传出时有效 */
+    xf_prof_sum_t           total;          /*!< 累计计数 */
+} xf_prof_stats_t;
+
+/**
+ * @brief 区段.
+ */
+typedef struct xf_prof_zone {
+    const char             *name;           /*!< 区段名 */
+    xf_prof_stats_t         stats;          /*!< 统计 */
+} xf_prof_zone_t;
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief 初始化计数器（DWT 时使能 CYCCNT）并清空所有区段.
+ *
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ */
+xf_err_t xf_prof_init(void);
+
+/**
+ * @brief 遍历已使用的区段.
+ *
+ * @param zone          上一个区段，为 NULL 时从头开始。
+ * @return xf_prof_zone_t *
+ *      - NULL                  遍历结束
+ *      - OTHER                 下一个区段
+ */
+xf_prof_zone_t *xf_prof_iter_next(const xf_prof_zone_t *zone);
+
+/**
+ * @brief 获取区段统计，并计算平均值.
+ *
+ * @param zone          区段。
+ * @param[out] p_stats  传出统计。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_OK                 成功
+ */
+xf_err_t xf_prof_get_stats(const xf_prof_zone_t *zone, xf_prof_stats_t *p_stats);
+
+/**
+ * @brief 清空区段统计，区段保留.
+ *
+ * @param zone          区段，为 NULL 时清空所有区段。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ */
+xf_err_t xf_prof_reset(xf_prof_zone_t *zone);
+
+/**
+ * @brief 记录一次区段耗时.
+ *
+ * @note 仅供 XF_PROF_ZONE_END 使用。
+ *
+ * @param pp_zone       调用处缓存的区段，为 NULL 时按 name 查找或分配。
+ * @param name          区段名。
+ * @param cycles        耗时。
+ */
+void xf_prof_record_i(xf_prof_zone_t **pp_zone, const char *name, xf_prof_cycle_t cycles);
+
+#if XF_PROF_COUNTER == 4
+xf_prof_cycle_t xf_prof_get_cycle_i(void);
+#endif
+
+/* ==================== [Macros] ============================================ */
+
+/**
+ * @brief 读取计数器.
+ */
+__STATIC_INLINE xf_prof_cycle_t xf_prof_get_cycle(void)
+{
+#if XF_PROF_COUNTER == 0
+    return (xf_prof_cycle_t)XF_PROF_GET_CYCLE();
+#elif XF_PROF_COUNTER == 1
+    return XF_PROF_DWT_CYCCNT;
+#elif XF_PROF_COUNTER == 2
+    return (xf_prof_cycle_t)__builtin_ia32_rdtsc();
+#elif XF_PROF_COUNTER == 3
+    uint64_t cnt;
+    __asm__ volatile("isb\n\tmrs %0, cntvct_el0" : "=r"(cnt) : : "memory");
+    return (xf_prof_cycle_t)cnt;
+#elif XF_PROF_COUNTER == 4
+    return xf_prof_get_cycle_i();
+#else
+    return (xf_prof_cycle_t)xf_tick_get_count();
+#endif
+}
+
+/**
+ * @brief 区段：XF_PROF_ZONE_BEGIN 与 XF_PROF_ZONE_END 之间的耗时计入区段 _name.
+ *
+ * 两者必须在同一函数内成对使用，中间不能 return. _name 是标识符，同名区段共用统计。
+ *
+ * @code{c}
+ * XF_PROF_ZONE_BEGIN(my_parse);
+ * parse(buf);
+ * XF_PROF_ZONE_END(my_parse);
+ * @endcode
+ */
+#define XF_PROF_ZONE_BEGIN(_name) \
+    do { \
+        static xf_prof_zone_t *_xf_prof_zone_##_name = NULL; \
+        xf_prof_cycle_t _xf_prof_start_##_name = xf_prof_get_cycle()
+
+#define XF_PROF_ZONE_END(_name) \
+        xf_prof_record_i(&_xf_prof_zone_##_name, #_name, \
+                         (xf_prof_cycle_t)(xf_prof_get_cycle() - _xf_prof_start_##_name)); \
+    } while (0)
+
+#else /* !XF_PROF_ENABLE */
+
+#define XF_PROF_ZONE_BEGIN(_name)       do {
+#define XF_PROF_ZONE_END(_name)         } while (0)
+
+#endif /* XF_PROF_ENABLE */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* __XF_PROF_H__ */
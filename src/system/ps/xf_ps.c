@@ -13,11 +13,15 @@
 /* ==================== [Includes] ========================================== */
 
 #include "xf_ps.h"
+#include "../prof/xf_prof.h"
 
 /* ==================== [Defines] =========================================== */
 
 /* 内部循环变量均使用 uint8_t */
 STATIC_ASSERT(XF_PS_SUBSCRIBER_NUM_MAX < ((uint8_t)~(uint8_t)0));
+#if XF_PS_ENABLE_STATIC
+STATIC_ASSERT(XF_PS_STATIC_NUM_MAX < ((uint8_t)~(uint8_t)0));
+#endif
 
 /* ==================== [Typedefs] ========================================== */
 
@@ -32,8 +36,7 @@ typedef struct xf_ps_channel {
 static xf_err_t xf_ps_notify(xf_event_msg_t *msg);
 
 static xf_ps_subscr_t *xf_ps_acquire_subscriber(void);
-
-#define xf_ps_release_subscriber(s) /*!< 什么也不做 */
+static void xf_ps_release_subscriber(xf_ps_subscr_t *s);
 
 static void xf_ps_subscriber_init(
     xf_ps_subscr_t *s,
@@ -43,12 +46,19 @@ static void xf_ps_subscriber_deinit(xf_ps_subscr_t *s);
 
 static uint8_t xf_ps_get_event_ref_cnt(xf_event_id_t event_id);
 
+#if XF_PS_ENABLE_STATIC
+static xf_err_t xf_ps_static_index_build(void);
+static uint8_t xf_ps_static_find(xf_event_id_t event_id, uint8_t *p_first);
+#endif
+
 /* ==================== [Static Variables] ================================== */
 
 static const char *const TAG = "xf_ps";
 
-/* 订阅者池 */
+/* 订阅者池，订阅者是否在用以 cb_func 是否为 NULL 判断（cb_func 不在块开头） */
 static xf_ps_subscr_t s_subscr_pool[XF_PS_SUBSCRIBER_NUM_MAX] = {0};
+static xf_mempool_t s_subscr_mp = XF_MEMPOOL_INIT(
+                                      s_subscr_pool, sizeof(xf_ps_subscr_t), XF_PS_SUBSCRIBER_NUM_MAX);
 
 /* 默认通道及其事件池 */
 static xf_ps_ch_t s_default_ch = {0};
@@ -57,6 +67,19 @@ static xf_ps_ch_t *const sp_ch = &s_default_ch;
 /* 消息池 */
 static xf_event_msg_t s_msg_pool[XF_PS_MSG_NUM_MAX] = {0};
 
+/* 分发用的临时区域，每条消息通知完后回退 */
+static xf_arena_t *s_dispatch_arena = NULL;
+
+#if XF_PS_ENABLE_STATIC
+/* 静态订阅表，由链接器生成；没有静态订阅者时弱引用为 NULL */
+extern const xf_ps_subscr_t __start_xf_ps_static[] __weak;
+extern const xf_ps_subscr_t __stop_xf_ps_static[] __weak;
+
+/* 静态订阅者按事件 ID 升序排列的下标，同一事件内保持链接顺序；由 xf_ps_init 建立 */
+static uint8_t s_static_idx[XF_PS_STATIC_NUM_MAX] = {0};
+static uint8_t s_static_num = 0;
+#endif
+
 /* ==================== [Macros] ============================================ */
 
 /* ==================== [Global Functions] ================================== */
@@ -66,7 +89,11 @@ xf_err_t xf_ps_init(void)
     if (sp_ch->event_queue.buf_size == 0) {
         xf_deque_init(&sp_ch->event_queue, s_msg_pool, sizeof(s_msg_pool));
     }
+#if XF_PS_ENABLE_STATIC
+    return xf_ps_static_index_build();
+#else
     return XF_OK;
+#endif
 }
 
 xf_ps_subscr_t *xf_ps_subscribe(
@@ -113,6 +140,10 @@ xf_err_t xf_ps_unsubscribe(
     /* 统一处理所有订阅者 */
     for (i = 0; i < XF_PS_SUBSCRIBER_NUM_MAX; i++) {
         bool_t match = TRUE;
+        /* 跳过空闲订阅者，其 event_id 处存放的是空闲链表指针 */
+        if (s_subscr_pool[i].cb_func == NULL) {
+            continue;
+        }
         /* 事件匹配检查 */
         if (match_event
                 && (s_subscr_pool[i].event_id != event_id)) {
@@ -147,6 +178,10 @@ xf_err_t xf_ps_unsubscribe_by_subscr(xf_ps_subscr_t *s)
             || (s > &s_subscr_pool[XF_PS_SUBSCRIBER_NUM_MAX - 1])) {
         return XF_ERR_INVALID_ARG;
     }
+    /* 已退订 */
+    if (s->cb_func == NULL) {
+        return XF_OK;
+    }
     xf_ps_subscriber_deinit(s);
     xf_ps_release_subscriber(s);
     return XF_OK;
@@ -163,7 +198,7 @@ xf_err_t xf_ps_publish(xf_event_id_t event_id, void *arg)
     }
     ref_cnt = xf_ps_get_event_ref_cnt(event_id);
     if (ref_cnt == 0) {
-        XF_ERROR_LINE(); XF_LOGD(TAG, "no subscriber");
+        XF_ERROR_LINE(); XF_LOGD_RL(TAG, "no subscriber");
         return XF_FAIL;
     }
     msg.id = event_id;
@@ -196,6 +231,9 @@ xf_err_t xf_ps_dispatch(void)
     xf_dq_size_t filled_size;
     xf_dq_size_t popped_size;
     xf_event_msg_t msg = {0};
+#if XF_PS_DISPATCH_BUDGET
+    xf_tick_t tick_start = xf_tick_get_count();
+#endif
     XF_CRIT_STAT();
     XF_CRIT_ENTRY();
     filled_size = xf_deque_get_filled(&sp_ch->event_queue);
@@ -212,6 +250,7 @@ xf_err_t xf_ps_dispatch(void)
         XF_FATAL_ERROR();
     }
 #endif
+    XF_PROF_ZONE_BEGIN(xf_ps_dispatch);
     while (filled_size >= XF_PS_ELEM_SIZE) {
         XF_CRIT_ENTRY();
         popped_size = xf_deque_front_pop(&sp_ch->event_queue,
@@ -224,12 +263,37 @@ xf_err_t xf_ps_dispatch(void)
         if (unlikely((popped_size != XF_PS_ELEM_SIZE))) {
             XF_FATAL_ERROR();
         }
-        xf_ret = xf_ps_notify(&msg);
+        if (s_dispatch_arena != NULL) {
+            xf_arena_t *p_arena = s_dispatch_arena;
+            xf_arena_mark_t arena_mark = xf_arena_mark(p_arena);
+            xf_ret = xf_ps_notify(&msg);
+            (void)xf_arena_reset_to(p_arena, &arena_mark);
+        } else {
+            xf_ret = xf_ps_notify(&msg);
+        }
         filled_size -= XF_PS_ELEM_SIZE;
+#if XF_PS_DISPATCH_BUDGET
+        if (xf_tick_elaps(tick_start) >= XF_PS_DISPATCH_BUDGET) {
+            /* 预算用完，剩余事件按原顺序留到下一次 dispatch */
+            break;
+        }
+#endif
     }
+    XF_PROF_ZONE_END(xf_ps_dispatch);
     return xf_ret;
 }
 
+xf_err_t xf_ps_set_dispatch_arena(xf_arena_t *p_arena)
+{
+    s_dispatch_arena = p_arena;
+    return XF_OK;
+}
+
+xf_arena_t *xf_ps_get_dispatch_arena(void)
+{
+    return s_dispatch_arena;
+}
+
 xf_ps_subscr_id_t xf_ps_subscr_to_id(const xf_ps_subscr_t *s)
 {
     if ((s == NULL)
@@ -252,18 +316,17 @@ xf_ps_subscr_t *xf_ps_id_to_subscr(xf_ps_subscr_id_t subscr_id)
 
 static xf_ps_subscr_t *xf_ps_acquire_subscriber(void)
 {
-    uint8_t i;
-    XF_CRIT_STAT();
-    XF_CRIT_ENTRY();
-    for (i = 0; i < XF_PS_SUBSCRIBER_NUM_MAX; i++) {
-        if (s_subscr_pool[i].cb_func == NULL) {
-            s_subscr_pool[i].cb_func = (xf_ps_subscr_cb_t)XF_CRIT_PTR_UNINIT;
-            XF_CRIT_EXIT();
-            return &s_subscr_pool[i];
-        }
+    xf_ps_subscr_t *s = (xf_ps_subscr_t *)xf_mempool_alloc_safe(&s_subscr_mp);
+    if (s != NULL) {
+        /* 块开头存放过空闲链表指针 */
+        xf_memset(s, 0, sizeof(xf_ps_subscr_t));
     }
-    XF_CRIT_EXIT();
-    return NULL;
+    return s;
+}
+
+static void xf_ps_release_subscriber(xf_ps_subscr_t *s)
+{
+    (void)xf_mempool_free_safe(&s_subscr_mp, s);
 }
 
 static void xf_ps_subscriber_init(
@@ -284,14 +347,19 @@ static uint8_t xf_ps_get_event_ref_cnt(xf_event_id_t event_id)
 {
     uint8_t ref_cnt = 0;
     uint8_t i;
+#if XF_PS_ENABLE_STATIC
+    uint8_t first;
+#endif
     XF_CRIT_STAT();
     if (event_id == XF_EVENT_ID_INVALID) {
         return 0;
     }
+#if XF_PS_ENABLE_STATIC
+    ref_cnt = xf_ps_static_find(event_id, &first);
+#endif
     XF_CRIT_ENTRY();
     for (i = 0; i < XF_PS_SUBSCRIBER_NUM_MAX; i++) {
         if ((s_subscr_pool[i].cb_func)
-                && (s_subscr_pool[i].cb_func != XF_CRIT_PTR_UNINIT)
                 && (s_subscr_pool[i].event_id == event_id)) {
             ref_cnt++;
         }
@@ -304,22 +372,39 @@ static xf_err_t xf_ps_notify(xf_event_msg_t *msg)
 {
     uint8_t i;
     uint8_t ref_cnt;
+#if XF_PS_ENABLE_STATIC
+    const xf_ps_subscr_t *s;
+    uint8_t first;
+    uint8_t num;
+#endif
     XF_CRIT_STAT();
     ref_cnt = xf_ps_get_event_ref_cnt(msg->id);
     if (ref_cnt == 0) {
         return XF_FAIL;
     }
+#if XF_PS_ENABLE_STATIC
+    /* 静态订阅者及其下标只读，不需要临界区 */
+    num = xf_ps_static_find(msg->id, &first);
+    for (i = first; i < (uint8_t)(first + num); i++) {
+        s = &__start_xf_ps_static[s_static_idx[i]];
+        --ref_cnt;
+        XF_PROF_ZONE_BEGIN(xf_ps_cb);
+        s->cb_func((xf_ps_subscr_t *)s, ref_cnt, msg->arg);
+        XF_PROF_ZONE_END(xf_ps_cb);
+    }
+#endif
     for (i = 0; i < XF_PS_SUBSCRIBER_NUM_MAX; i++) {
         XF_CRIT_ENTRY();
-        if (!(s_subscr_pool[i].cb_func)
-                || (s_subscr_pool[i].cb_func == XF_CRIT_PTR_UNINIT)) {
+        if (!(s_subscr_pool[i].cb_func)) {
             XF_CRIT_EXIT();
             continue;
         }
         XF_CRIT_EXIT();
         if (s_subscr_pool[i].event_id == msg->id) {
             --ref_cnt;
+            XF_PROF_ZONE_BEGIN(xf_ps_cb);
             s_subscr_pool[i].cb_func(&s_subscr_pool[i], ref_cnt, msg->arg);
+            XF_PROF_ZONE_END(xf_ps_cb);
             /* 
                 TODO 如果有在回调中订阅或取消订阅，需要重新计算 ref_cnt
              */
@@ -327,3 +412,50 @@ static xf_err_t xf_ps_notify(xf_event_msg_t *msg)
     }
     return XF_OK;
 }
+
+#if XF_PS_ENABLE_STATIC
+static xf_err_t xf_ps_static_index_build(void)
+{
+    const xf_ps_subscr_t *p_tbl = &__start_xf_ps_static[0];
+    uint32_t num = (uint32_t)(&__stop_xf_ps_static[0] - &__start_xf_ps_static[0]);
+    uint8_t i;
+    uint8_t j;
+    s_static_num = 0;
+    if (num > XF_PS_STATIC_NUM_MAX) {
+        XF_ERROR_LINE(); XF_LOGD(TAG, "too many static subscribers: %u", (unsigned int)num);
+        return XF_ERR_NO_MEM;
+    }
+    /* 插入排序，事件 ID 相等时不移动，保持链接顺序 */
+    for (i = 0; i < (uint8_t)num; i++) {
+        for (j = i; (j > 0) && (p_tbl[s_static_idx[j - 1]].event_id > p_tbl[i].event_id); --j) {
+            s_static_idx[j] = s_static_idx[j - 1];
+        }
+        s_static_idx[j] = i;
+    }
+    s_static_num = (uint8_t)num;
+    return XF_OK;
+}
+
+static uint8_t xf_ps_static_find(xf_event_id_t event_id, uint8_t *p_first)
+{
+    const xf_ps_subscr_t *p_tbl = &__start_xf_ps_static[0];
+    uint8_t lo = 0;
+    uint8_t hi = s_static_num;
+    uint8_t mid;
+    /* 二分查找第一个事件 ID 不小于 event_id 的下标 */
+    while (lo < hi) {
+        mid = (uint8_t)((lo + hi) / 2U);
+        if (p_tbl[s_static_idx[mid]].event_id < event_id) {
+            lo = (uint8_t)(mid + 1U);
+        } else {
+            hi = mid;
+        }
+    }
+    *p_first = lo;
+    hi = lo;
+    while ((hi < s_static_num) && (p_tbl[s_static_idx[hi]].event_id == event_id)) {
+        hi++;
+    }
+    return (uint8_t)(hi - lo);
+}
+#endif
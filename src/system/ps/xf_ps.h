@@ -66,6 +66,23 @@ xf_err_t xf_ps_publish_sync(xf_event_id_t event_id, void *arg);
 
 xf_err_t xf_ps_dispatch(void);
 
+/**
+ * @brief 设置分发用的临时区域.
+ *
+ * xf_ps_dispatch() 通知每条消息前标记该区域，所有订阅者回调返回后回退，
+ * 回调内从 xf_ps_get_dispatch_arena() 分配的内存因此一次性释放。
+ *
+ * @param p_arena       区域，为 NULL 时不使用。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ */
+xf_err_t xf_ps_set_dispatch_arena(xf_arena_t *p_arena);
+
+/**
+ * @brief 获取分发用的临时区域，未设置时返回 NULL.
+ */
+xf_arena_t *xf_ps_get_dispatch_arena(void);
+
 xf_ps_subscr_id_t xf_ps_subscr_to_id(const xf_ps_subscr_t *s);
 xf_ps_subscr_t *xf_ps_id_to_subscr(xf_ps_subscr_id_t subscr_id);
 
@@ -94,6 +111,38 @@ xf_ps_subscr_t *xf_ps_id_to_subscr(xf_ps_subscr_id_t subscr_id);
 #define xf_subscr_to_id(_s)             xf_ps_subscr_to_id(_s)
 #define xf_id_to_subscr(_subscr_id)     xf_ps_id_to_subscr(_subscr_id)
 
+#if XF_PS_ENABLE_STATIC
+
+/**
+ * @brief 定义静态订阅者.
+ *
+ * 订阅者在编译期放入 xf_ps_static 段，不需要运行时订阅，也不占用订阅者池。
+ * xf_ps_init 中按事件 ID 为该段建立有序下标，通知时二分查找该事件的静态订阅者
+ * （同一事件按链接顺序调用），再遍历订阅者池。
+ *
+ * @note 1. 静态订阅者不能取消订阅， xf_ps_subscr_to_id 返回 XF_PS_ID_INVALID.
+ *          数量不能超过 XF_PS_STATIC_NUM_MAX, 否则 xf_ps_init 返回 XF_ERR_NO_MEM
+ *          且静态订阅者都不会被通知。
+ * @note 2. 使用自定义链接脚本时，需要 KEEP(*(xf_ps_static)) 并保持段名不变，
+ *          以便链接器生成 __start_xf_ps_static / __stop_xf_ps_static.
+ * @warning 订阅者位于只读段，回调内不要修改 s 指向的内容。
+ *
+ * @param _name         静态订阅者名，需全局唯一。
+ * @param _event_id     事件 ID，必须是常量表达式。
+ * @param _cb_func      回调函数。 @ref xf_ps_subscr_cb_t.
+ * @param _user_data    用户数据，必须是常量表达式。
+ */
+#define XF_SUBSCRIBE_STATIC(_name, _event_id, _cb_func, _user_data) \
+                                        const xf_ps_subscr_t XCAT2(xf_ps_static_, _name) \
+                                        __used __section("xf_ps_static") \
+                                        __aligned(__alignof__(xf_ps_subscr_t)) = { \
+                                            (xf_event_id_t)(_event_id), \
+                                            (xf_ps_subscr_cb_t)(_cb_func), \
+                                            (void *)(uintptr_t)(_user_data), \
+                                        }
+
+#endif /* XF_PS_ENABLE_STATIC */
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
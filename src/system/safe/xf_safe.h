@@ -31,17 +31,7 @@ extern "C" {
 
 /* ==================== [Macros] ============================================ */
 
-#if !defined(XF_CRIT_STAT)
-#   define XF_CRIT_STAT()               ((void)0)
-#endif
-
-#if !defined(XF_CRIT_ENTRY)
-#   define XF_CRIT_ENTRY()              ((void)0)
-#endif
-
-#if !defined(XF_CRIT_EXIT)
-#   define XF_CRIT_EXIT()               ((void)0)
-#endif
+/* XF_CRIT_STAT / XF_CRIT_ENTRY / XF_CRIT_EXIT 的默认定义见 common/xf_common.h */
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -16,11 +16,12 @@
 /* ==================== [Includes] ========================================== */
 
 #include "xf_stimer.h"
+#include "../prof/xf_prof.h"
 
 /* ==================== [Defines] =========================================== */
 
 #define TAG "xf_stimer"
-#define IDLE_MEAS_PERIOD 500 /*!< 空闲测量周期，单位 [tick] */
+#define IDLE_MEAS_PERIOD xf_ms_to_tick(500U) /*!< 空闲测量周期，500 ms */
 
 /* ==================== [Typedefs] ========================================== */
 
@@ -28,6 +29,7 @@
 
 static bool_t xf_stimer_exec(xf_stimer_t *stimer);
 static xf_tick_t xf_stimer_time_remaining(xf_stimer_t *stimer);
+static void xf_stimer_advance(xf_stimer_t *stimer);
 static xf_tick_t xf_stimer_get_min(xf_stimer_t **pp_stimer);
 
 /* ==================== [Static Variables] ================================== */
@@ -35,8 +37,13 @@ static xf_tick_t xf_stimer_get_min(xf_stimer_t **pp_stimer);
 /* 定时器池 */
 static xf_stimer_t s_stimer_pool[XF_STIMER_NUM_MAX] = {0};
 static xf_stimer_t *const sp_pool = s_stimer_pool;
-/* 用于指示已使用的定时器 */
+static xf_mempool_t s_stimer_mp = XF_MEMPOOL_INIT(s_stimer_pool, sizeof(xf_stimer_t), XF_STIMER_NUM_MAX);
+/* 用于指示已使用的定时器，xf_stimer_handler 按此扫描 */
+#if XF_STIMER_ENABLE_HBITMAP
+XF_HBITMAP_DEFINE_STATIC(s_stimer_hbm, XF_STIMER_NUM_MAX);
+#else
 static xf_bitmap32_t s_stimer_bm[XF_BITMAP32_GET_BLK_SIZE(XF_STIMER_NUM_MAX)] = {0};
+#endif
 static xf_stimer_t *sp_stimer_min = NULL;  /*!< TODO 还需获取此指针的接口，或移除 */
 
 static xf_tick_t s_idle_period_start = 0;
@@ -49,30 +56,52 @@ static bool_t sb_stimer_ready = FALSE;
 
 /* ==================== [Macros] ============================================ */
 
+/* 已使用定时器位图的操作, FLS 查找序号小于 _below 的最后一个定时器 */
+#if XF_STIMER_ENABLE_HBITMAP
+#   define XF_STIMER_BM_GET(_idx)       xf_hbitmap_get(&s_stimer_hbm, (uint32_t)(_idx))
+#   define XF_STIMER_BM_SET1(_idx)      (void)xf_hbitmap_set1(&s_stimer_hbm, (uint32_t)(_idx))
+#   define XF_STIMER_BM_SET0(_idx)      (void)xf_hbitmap_set0(&s_stimer_hbm, (uint32_t)(_idx))
+#   define XF_STIMER_BM_FLS(_below)     xf_hbitmap_find_prev_set(&s_stimer_hbm, (uint32_t)(_below) - 1U)
+#else
+#   define XF_STIMER_BM_GET(_idx)       XF_BITMAP32_GET(s_stimer_bm, (_idx))
+#   define XF_STIMER_BM_SET1(_idx)      (void)xf_bitmap32_test_and_set(s_stimer_bm, (uint32_t)(_idx))
+#   define XF_STIMER_BM_SET0(_idx)      (void)xf_bitmap32_test_and_clear(s_stimer_bm, (uint32_t)(_idx))
+#   define XF_STIMER_BM_FLS(_below)     xf_bitmap32_fls(s_stimer_bm, (uint32_t)(_below))
+#endif
+
 /* ==================== [Global Functions] ================================== */
 
 xf_stimer_t *xf_stimer_acquire(void)
 {
-    int32_t idx;
+    xf_stimer_t *stimer;
+#if XF_STIMER_ENABLE_HBITMAP
     XF_CRIT_STAT();
-    XF_CRIT_ENTRY();
-    idx = xf_bitmap32_flz(s_stimer_bm, XF_STIMER_NUM_MAX);
-    XF_CRIT_EXIT();
-    if (idx < 0) {
+#endif
+    stimer = (xf_stimer_t *)xf_mempool_alloc_safe(&s_stimer_mp);
+    if (stimer == NULL) {
         XF_FATAL_ERROR();
         return NULL;
     }
+    /* 块开头存放过空闲链表指针 */
+    xf_memset(stimer, 0, sizeof(xf_stimer_t));
+#if XF_STIMER_ENABLE_HBITMAP
     XF_CRIT_ENTRY();
-    XF_BITMAP32_SET1(s_stimer_bm, idx);
-    sb_stimer_created = TRUE;
+    XF_STIMER_BM_SET1(xf_stimer_to_id(stimer));
     XF_CRIT_EXIT();
-    return &sp_pool[idx];
+#else
+    /* 原子置位，不需要临界区 */
+    XF_STIMER_BM_SET1(xf_stimer_to_id(stimer));
+#endif
+    sb_stimer_created = TRUE;
+    return stimer;
 }
 
 xf_err_t xf_stimer_release(xf_stimer_t *stimer)
 {
     intptr_t idx;
+#if XF_STIMER_ENABLE_HBITMAP
     XF_CRIT_STAT();
+#endif
     if (stimer == NULL) {
         return XF_ERR_INVALID_ARG;
     }
@@ -80,15 +109,23 @@ xf_err_t xf_stimer_release(xf_stimer_t *stimer)
     if (idx == XF_STIMER_ID_INVALID) {
         return XF_ERR_INVALID_ARG;
     }
-    if (XF_BITMAP32_GET(s_stimer_bm, idx) == 0) {
+#if XF_STIMER_ENABLE_HBITMAP
+    XF_CRIT_ENTRY();
+    if (XF_STIMER_BM_GET(idx) == 0) {
+        XF_CRIT_EXIT();
         return XF_ERR_INVALID_ARG;
     }
-    XF_CRIT_ENTRY();
-    XF_BITMAP32_SET0(s_stimer_bm, idx);
+    XF_STIMER_BM_SET0(idx);
+    XF_CRIT_EXIT();
+#else
+    /* 原子清零，同时防止重复释放 */
+    if (!xf_bitmap32_test_and_clear(s_stimer_bm, (uint32_t)idx)) {
+        return XF_ERR_INVALID_ARG;
+    }
+#endif
     xf_memset(stimer, 0, sizeof(xf_stimer_t));
     sb_stimer_deleted = TRUE;
-    XF_CRIT_EXIT();
-    return XF_OK;
+    return xf_mempool_free_safe(&s_stimer_mp, stimer);
 }
 
 xf_err_t xf_stimer_set_cb(xf_stimer_t *stimer, xf_stimer_cb_t cb_func)
@@ -118,6 +155,15 @@ xf_err_t xf_stimer_set_period(xf_stimer_t *stimer, xf_tick_t tick_period)
     return XF_OK;
 }
 
+xf_err_t xf_stimer_set_fixed_rate(xf_stimer_t *stimer, bool_t enable)
+{
+    if (stimer == NULL) {
+        return XF_ERR_INVALID_ARG;
+    }
+    stimer->fixed_rate = enable ? TRUE : FALSE;
+    return XF_OK;
+}
+
 xf_err_t xf_stimer_init(xf_stimer_t *stimer)
 {
     return xf_stimer_reset(stimer);
@@ -185,8 +231,11 @@ xf_tick_t xf_stimer_handler(void)
     int32_t stimer_idx;
     xf_tick_t tick_min;
     xf_tick_t idle_period_time;
+#if !XF_STIMER_ENABLE_HBITMAP
     /* cppcheck-suppress misra-c2012-18.8 */
     xf_bitmap32_t stimer_bm_temp[XF_BITMAP32_GET_BLK_SIZE(XF_STIMER_NUM_MAX)];
+    xf_bitmap_iter_t it;
+#endif
     xf_tick_t handler_start = xf_tick_get_count();
     XF_CRIT_STAT();
 
@@ -196,11 +245,12 @@ xf_tick_t xf_stimer_handler(void)
         s_run_cnt++;
         if (s_run_cnt > 100U) {
             s_run_cnt = 0U;
-            XF_LOGD(TAG, "It seems xf_tick_inc() is not called.");
+            XF_LOGE(TAG, "It seems xf_tick_inc() is not called.");
             XF_FATAL_ERROR();
         }
     }
 
+    XF_PROF_ZONE_BEGIN(xf_stimer_handler);
     /* 如果运行过程中有定时器创建或移除或设为就绪，则重新检测所有定时器是否执行。 */
     do {
         sb_stimer_deleted = FALSE;
@@ -213,23 +263,44 @@ xf_tick_t xf_stimer_handler(void)
                    可能会重复执行已执行定时器，或者未执行可能需要执行的定时器” 的问题。
             此处全部再次扫描。
          */
+#if XF_STIMER_ENABLE_HBITMAP
+        /*
+            分层位图直接找下一个，不需要快照：
+            定时器有增删时跳出重新扫描，本轮后面的序号不会受影响。
+         */
         XF_CRIT_ENTRY();
-        xf_memcpy(stimer_bm_temp, s_stimer_bm, sizeof(s_stimer_bm));
+        stimer_idx = xf_hbitmap_ffs(&s_stimer_hbm);
         XF_CRIT_EXIT();
-        stimer_idx = xf_bitmap32_fls(stimer_bm_temp, XF_STIMER_NUM_MAX);
         while (stimer_idx >= 0) {
             if (xf_stimer_exec(&sp_pool[stimer_idx])) {
                 if (sb_stimer_created || sb_stimer_deleted || sb_stimer_ready) {
                     break;
                 }
             }
-            XF_BITMAP32_SET0(stimer_bm_temp, stimer_idx);
-            stimer_idx = xf_bitmap32_fls(stimer_bm_temp, stimer_idx);
+            XF_CRIT_ENTRY();
+            stimer_idx = xf_hbitmap_find_next_set(&s_stimer_hbm, (uint32_t)stimer_idx + 1U);
+            XF_CRIT_EXIT();
         }
+#else
+        XF_CRIT_ENTRY();
+        xf_memcpy(stimer_bm_temp, s_stimer_bm, sizeof(s_stimer_bm));
+        XF_CRIT_EXIT();
+        /* 按序号从低到高遍历；序号由内存池分配，同时到期的定时器执行顺序不保证 */
+        XF_BITMAP32_FOR_EACH_SET_BIT(stimer_idx, &it, stimer_bm_temp, XF_STIMER_NUM_MAX) {
+            /* 快照之后被释放的定时器，块开头已是空闲链表指针，不能执行 */
+            if (XF_BITMAP32_GET(s_stimer_bm, stimer_idx)
+                    && xf_stimer_exec(&sp_pool[stimer_idx])) {
+                if (sb_stimer_created || sb_stimer_deleted || sb_stimer_ready) {
+                    break;
+                }
+            }
+        }
+#endif
     } while (stimer_idx >= 0);
 
     /* 获取下一次唤醒的最小时间 */
     tick_min = xf_stimer_get_min(&sp_stimer_min);
+    XF_PROF_ZONE_END(xf_stimer_handler);
 
     /* 统计空闲时间 */
     s_busy_time += xf_tick_elaps(handler_start);
@@ -255,7 +326,7 @@ static bool_t xf_stimer_exec(xf_stimer_t *stimer)
 {
     bool_t exec = FALSE;
     if (xf_stimer_time_remaining(stimer) == 0U) {
-        stimer->tick_last_run = xf_tick_get_count();
+        xf_stimer_advance(stimer);
         if (stimer->cb_func) {
             stimer->cb_func(stimer);
         }
@@ -273,6 +344,28 @@ static xf_tick_t xf_stimer_time_remaining(xf_stimer_t *stimer)
     return stimer->tick_period - elp;
 }
 
+static void xf_stimer_advance(xf_stimer_t *stimer)
+{
+#if !XF_STIMER_ENABLE_CATCH_UP
+    xf_tick_t elp;
+#endif
+    if ((!stimer->fixed_rate)
+            || (stimer->tick_period == 0U)
+            || (stimer->tick_period == XF_STIMER_INFINITY)) {
+        stimer->tick_last_run = xf_tick_get_count();
+        return;
+    }
+    /* 起点只前进一个周期，执行延迟不会累积 */
+    stimer->tick_last_run += stimer->tick_period;
+#if !XF_STIMER_ENABLE_CATCH_UP
+    /* 仍然超时说明错过了整周期，跳过这些周期 */
+    elp = xf_tick_elaps(stimer->tick_last_run);
+    if (elp >= stimer->tick_period) {
+        stimer->tick_last_run += (elp / stimer->tick_period) * stimer->tick_period;
+    }
+#endif
+}
+
 static xf_tick_t xf_stimer_get_min(xf_stimer_t **pp_stimer)
 {
     int32_t i;
@@ -281,7 +374,7 @@ static xf_tick_t xf_stimer_get_min(xf_stimer_t **pp_stimer)
     xf_tick_t tick_min;
     XF_CRIT_STAT();
     XF_CRIT_ENTRY();
-    i = xf_bitmap32_fls(s_stimer_bm, XF_STIMER_NUM_MAX);
+    i = XF_STIMER_BM_FLS(XF_STIMER_NUM_MAX);
     XF_CRIT_EXIT();
     if (i < 0) {
         return XF_STIMER_NO_READY_DELAY;
@@ -290,7 +383,7 @@ static xf_tick_t xf_stimer_get_min(xf_stimer_t **pp_stimer)
     j = i;
     while (i > 0) {
         XF_CRIT_ENTRY();
-        i = xf_bitmap32_fls(s_stimer_bm, i);
+        i = XF_STIMER_BM_FLS(i);
         XF_CRIT_EXIT();
         if (i >= 0) {
             tick_temp = xf_stimer_time_remaining(&sp_pool[i]);
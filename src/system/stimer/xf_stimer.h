@@ -46,6 +46,7 @@ struct xf_soft_timer {
     void                       *user_data;          /*!< 回调函数用户数据 */
     xf_tick_t                   tick_last_run;      /*!< 定时器开始时间/上一次运行时间，单位 tick */
     xf_tick_t                   tick_period;        /*!< 定时器周期，单位 tick */
+    bool_t                      fixed_rate;         /*!< 固定速率模式，见 @ref xf_stimer_set_fixed_rate */
 };
 
 /* ==================== [Global Prototypes] ================================= */
@@ -58,6 +59,24 @@ xf_err_t xf_stimer_set_cb(xf_stimer_t *stimer, xf_stimer_cb_t cb_func);
 xf_err_t xf_stimer_set_user_data(xf_stimer_t *stimer, void *user_data);
 xf_err_t xf_stimer_set_period(xf_stimer_t *stimer, xf_tick_t tick_period);
 
+/**
+ * @brief 设置固定速率模式.
+ *
+ * 默认模式下，定时器执行时以当前时间作为下一周期的起点，执行延迟会累积。
+ * 固定速率模式下，下一周期的起点只前进一个周期，不随执行延迟漂移。
+ *
+ * 延迟超过一个周期（overrun）时：
+ * - XF_STIMER_ENABLE_CATCH_UP 为 1: 补执行错过的周期，直到追上；
+ * - XF_STIMER_ENABLE_CATCH_UP 为 0: 跳过错过的周期，保持原有相位。
+ *
+ * @param stimer        定时器。
+ * @param enable        TRUE: 固定速率; FALSE: 默认模式。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_OK                 成功
+ */
+xf_err_t xf_stimer_set_fixed_rate(xf_stimer_t *stimer, bool_t enable);
+
 xf_err_t xf_stimer_reset(xf_stimer_t *stimer);
 xf_err_t xf_stimer_set_ready(xf_stimer_t *stimer);
 
@@ -13,6 +13,7 @@
 /* ==================== [Includes] ========================================== */
 
 #include "xf_task.h"
+#include "../prof/xf_prof.h"
 
 /* ==================== [Defines] =========================================== */
 
@@ -33,15 +34,34 @@ typedef struct xf_task_event_msg {
 static xf_err_t xf_task_set_event_msg(const xf_task_t *me, xf_event_msg_t *p_msg);
 
 static void xf_task_sched_resume(void);
+static void xf_task_sched_resume_next(void);
 static void xf_task_sched_suspend(void);
 
 static xf_err_t xf_task_resume_root(xf_task_t *task, void *arg);
+static xf_task_async_t xf_task_run_root(xf_task_t *task, void *arg);
 static xf_err_t xf_task_sched(void *arg);
+static bool_t xf_task_sched_range(void *arg, uint8_t start, uint8_t end, xf_tick_t tick_start);
+static bool_t xf_task_sched_one(xf_task_t *task, void *arg, xf_tick_t tick_start);
+
+static bool_t xf_task_tick_before(xf_tick_t a, xf_tick_t b);
+static xf_err_t xf_task_sleep_insert(xf_task_t *me, xf_tick_t tick_wake);
+static void xf_task_sleep_rearm(void);
+
+#if XF_TASK_ENABLE_STATIC
+static void xf_task_static_init(void);
+#endif
 
 /* ==================== [Static Variables] ================================== */
 
-/* 任务池 */
+/* 任务池，任务是否在用以 cb_func 是否为 NULL 判断（cb_func 不在块开头） */
 static xf_task_t s_task_pool[XF_TASK_NUM_MAX] = {0};
+static xf_mempool_t s_task_mp = XF_MEMPOOL_INIT(s_task_pool, sizeof(xf_task_t), XF_TASK_NUM_MAX);
+/* 已分配的任务，调度及遍历时跳过空闲的任务 */
+#if XF_TASK_ENABLE_HBITMAP
+XF_HBITMAP_DEFINE_STATIC(s_task_hbm, XF_TASK_NUM_MAX);
+#else
+static xf_bitmap_t s_task_bm[XF_BITMAP_GET_BLK_SIZE(XF_TASK_NUM_MAX)] = {0};
+#endif
 
 /* 事件消息池 */
 static xf_task_event_msg_t s_msg_pool[XF_TASK_EVENT_MSG_NUM_MAX] = {0};
@@ -49,36 +69,64 @@ static xf_task_event_msg_t s_msg_pool[XF_TASK_EVENT_MSG_NUM_MAX] = {0};
 /* 嵌套深度 */
 static volatile int8_t s_nest_depth = 0;
 
+/* 下一轮调度开始的任务 id ，用于时间预算用完后轮转 */
+static uint8_t s_sched_rr = 0;
+
 /* 给调度器用的定时任务 */
 static xf_stimer_t *s_sched_stimer = NULL;
 
+/* 睡眠队列，按唤醒时间升序排列 */
+static xf_task_id_t s_sleep_head = XF_TASK_ID_INVALID;
+
+/* 给睡眠队列用的定时任务，周期为队首任务剩余的睡眠时间 */
+static xf_stimer_t *s_sleep_stimer = NULL;
+
+/* 临时区域，每次运行顶级任务后回退 */
+static xf_arena_t *s_scratch_arena = NULL;
+
+#if XF_TASK_ENABLE_STATIC
+/* 静态任务表，由链接器生成；没有静态任务时弱引用为 NULL */
+extern const xf_task_static_t __start_xf_task_static[] __weak;
+extern const xf_task_static_t __stop_xf_task_static[] __weak;
+#endif
+
 /* ==================== [Macros] ============================================ */
 
+#if XF_TASK_ENABLE_HBITMAP
+#   define XF_TASK_BM_SET1(_id)     (void)xf_hbitmap_set1(&s_task_hbm, (_id))
+#   define XF_TASK_BM_SET0(_id)     (void)xf_hbitmap_set0(&s_task_hbm, (_id))
+#else
+#   define XF_TASK_BM_SET1(_id)     XF_BITMAP_SET1(s_task_bm, (_id))
+#   define XF_TASK_BM_SET0(_id)     XF_BITMAP_SET0(s_task_bm, (_id))
+#endif
+
 /* ==================== [Global Functions] ================================== */
 
 xf_task_t *xf_task_acquire(void)
 {
-    uint8_t i;
+    xf_task_t *task = (xf_task_t *)xf_mempool_alloc_safe(&s_task_mp);
     XF_CRIT_STAT();
-    XF_CRIT_ENTRY();
-    for (i = 0; i < XF_TASK_NUM_MAX; ++i) {
-        if (s_task_pool[i].cb_func == NULL) {
-            s_task_pool[i].cb_func = (xf_task_cb_t)XF_CRIT_PTR_UNINIT;
-            XF_CRIT_EXIT();
-            return &s_task_pool[i];
-        }
+    if (task != NULL) {
+        /* 块开头存放过空闲链表指针 */
+        xf_memset(task, 0, sizeof(xf_task_t));
+        XF_CRIT_ENTRY();
+        XF_TASK_BM_SET1(xf_task_to_id(task));
+        XF_CRIT_EXIT();
     }
-    XF_CRIT_EXIT();
-    return NULL;
+    return task;
 }
 
 xf_err_t xf_task_release(xf_task_t *task)
 {
+    XF_CRIT_STAT();
     if (task == NULL) {
         return XF_ERR_INVALID_ARG;
     }
     task->cb_func = NULL;
-    return XF_OK;
+    XF_CRIT_ENTRY();
+    XF_TASK_BM_SET0(xf_task_to_id(task));
+    XF_CRIT_EXIT();
+    return xf_mempool_free_safe(&s_task_mp, task);
 }
 
 xf_err_t xf_task_init(xf_task_t *task, xf_task_cb_t cb_func, void *user_data)
@@ -89,7 +137,9 @@ xf_err_t xf_task_init(xf_task_t *task, xf_task_cb_t cb_func, void *user_data)
     xf_task_lc_init(xf_task_cast(task)->lc);
     xf_task_cast(task)->cb_func = cb_func;
     xf_task_cast(task)->user_data = user_data;
-    task->id_stimer = XF_STIMER_ID_INVALID;
+    task->tick_wake = 0;
+    task->id_sleep_next = XF_TASK_ID_INVALID;
+    xf_task_attr_set_sleep(task, 0);
     task->id_subscr = XF_PS_ID_INVALID;
     task->id_parent = XF_TASK_ID_INVALID;
     task->id_child = XF_TASK_ID_INVALID;
@@ -127,7 +177,8 @@ xf_task_t *xf_task_create_(xf_task_t *parent, xf_task_cb_t cb_func, void *user_d
 
 xf_err_t xf_task_destroy_(xf_task_t *task)
 {
-    if (task == NULL) {
+    /* 已销毁的任务 cb_func 为 NULL ，避免重复归还任务池 */
+    if ((task == NULL) || (task->cb_func == NULL)) {
         return XF_ERR_INVALID_ARG;
     }
     xf_task_teardown_wait_until(task);
@@ -154,6 +205,96 @@ xf_task_t *xf_task_id_to_task(xf_task_id_t id)
     return &s_task_pool[id];
 }
 
+xf_task_t *xf_task_iter_next(const xf_task_t *task)
+{
+    uint8_t i = 0;
+    int32_t next;
+#if XF_TASK_ENABLE_HBITMAP
+    XF_CRIT_STAT();
+#else
+    xf_bitmap_iter_t it;
+#endif
+    if (task != NULL) {
+        if (xf_task_to_id(task) == XF_TASK_ID_INVALID) {
+            return NULL;
+        }
+        i = (uint8_t)(xf_task_to_id(task) + 1U);
+    }
+#if XF_TASK_ENABLE_HBITMAP
+    XF_CRIT_ENTRY();
+    next = xf_hbitmap_find_next_set(&s_task_hbm, i);
+    while ((next >= 0) && (s_task_pool[next].cb_func == NULL)) {
+        next = xf_hbitmap_find_next_set(&s_task_hbm, (uint32_t)next + 1U);
+    }
+    XF_CRIT_EXIT();
+    if (next >= 0) {
+        return &s_task_pool[next];
+    }
+#else
+    XF_BITMAP_FOR_EACH_SET_BIT_IN(next, &it, s_task_bm, i, XF_TASK_NUM_MAX) {
+        if (s_task_pool[next].cb_func != NULL) {
+            return &s_task_pool[next];
+        }
+    }
+#endif
+    return NULL;
+}
+
+#if XF_TASK_ENABLE_STATS
+xf_err_t xf_task_get_stats(const xf_task_t *task, xf_task_stats_t *p_stats)
+{
+    XF_CRIT_STAT();
+    if ((xf_task_to_id(task) == XF_TASK_ID_INVALID) || (p_stats == NULL)) {
+        return XF_ERR_INVALID_ARG;
+    }
+    XF_CRIT_ENTRY();
+    *p_stats = task->stats;
+    XF_CRIT_EXIT();
+    return XF_OK;
+}
+
+xf_err_t xf_task_reset_stats(xf_task_t *task)
+{
+    uint8_t i;
+    XF_CRIT_STAT();
+    XF_CRIT_ENTRY();
+    if (task != NULL) {
+        xf_memset(&task->stats, 0, sizeof(xf_task_stats_t));
+    } else {
+        for (i = 0; i < XF_TASK_NUM_MAX; ++i) {
+            xf_memset(&s_task_pool[i].stats, 0, sizeof(xf_task_stats_t));
+        }
+    }
+    XF_CRIT_EXIT();
+    return XF_OK;
+}
+#endif
+
+#if XF_TASK_ENABLE_STATIC
+xf_task_t *xf_task_static_to_task(const xf_task_static_t *desc)
+{
+    if ((desc == NULL)
+            || (desc < &__start_xf_task_static[0])
+            || (desc >= &__stop_xf_task_static[0])
+            || ((desc - &__start_xf_task_static[0]) >= XF_TASK_NUM_MAX)) {
+        return NULL;
+    }
+    /* 静态任务按段内顺序占用任务池的前几项 */
+    return &s_task_pool[desc - &__start_xf_task_static[0]];
+}
+#endif
+
+xf_err_t xf_task_set_scratch_arena(xf_arena_t *p_arena)
+{
+    s_scratch_arena = p_arena;
+    return XF_OK;
+}
+
+xf_arena_t *xf_task_get_scratch_arena(void)
+{
+    return s_scratch_arena;
+}
+
 void xf_task_get_wait_until_result(const xf_task_t *me, xf_err_t *p_xf_ret)
 {
     if (me && p_xf_ret) {
@@ -202,6 +343,21 @@ xf_err_t xf_task_sched_init(void)
             s_msg_pool[i].id = XF_TASK_ID_INVALID;
         }
         XF_CRIT_EXIT();
+#if XF_TASK_ENABLE_STATIC
+        xf_task_static_init();
+#endif
+    }
+    if (s_sleep_stimer == NULL) {
+        s_sleep_stimer = xf_stimer_create(
+                             XF_STIMER_INFINITY,
+                             (xf_stimer_cb_t)xf_task_sleep_timer_cb,
+                             NULL);
+        if (s_sleep_stimer == NULL) {
+            XF_FATAL_ERROR();
+        }
+        XF_CRIT_ENTRY();
+        s_sleep_head = XF_TASK_ID_INVALID;
+        XF_CRIT_EXIT();
     }
     return XF_OK;
 }
@@ -212,42 +368,78 @@ xf_err_t xf_task_sched_deinit(void)
         xf_stimer_destroy(s_sched_stimer);
         s_sched_stimer = NULL;
     }
+    if (s_sleep_stimer != NULL) {
+        xf_stimer_destroy(s_sleep_stimer);
+        s_sleep_stimer = NULL;
+    }
     return XF_OK;
 }
 
-xf_err_t xf_task_acquire_timer(xf_task_t *me, xf_tick_t tick_period)
+xf_err_t xf_task_sleep_enqueue(xf_task_t *me, xf_tick_t tick)
 {
-    xf_stimer_t *stimer;
-    if (me == NULL) {
-        return XF_ERR_INVALID_ARG;
-    }
-    if (me->id_stimer != XF_STIMER_ID_INVALID) {
-        return XF_ERR_INITED;
+    /* 永久阻塞，不需要入队 */
+    if (tick == XF_STIMER_INFINITY) {
+        return XF_OK;
     }
-    stimer = xf_stimer_create(
-                 tick_period,
-                 (xf_stimer_cb_t)xf_resume_task_timer_cb,
-                 (void *)(me));
-    if (stimer == NULL) {
-        XF_FATAL_ERROR();
+    return xf_task_sleep_insert(me, xf_tick_get_count() + tick);
+}
+
+xf_err_t xf_task_sleep_enqueue_until(
+    xf_task_t *me, xf_tick_t *p_tick_last_wake, xf_tick_t tick_period)
+{
+    xf_tick_t tick_wake;
+#if !XF_TASK_ENABLE_DELAY_UNTIL_CATCH_UP
+    xf_tick_t tick_now;
+    xf_tick_t tick_late;
+#endif
+    if (p_tick_last_wake == NULL) {
+        return XF_ERR_INVALID_ARG;
     }
-    me->id_stimer = xf_stimer_to_id(stimer);
-    return XF_OK;
+    if (tick_period == XF_STIMER_INFINITY) {
+        return XF_OK;
+    }
+    tick_wake = *p_tick_last_wake + tick_period;
+#if !XF_TASK_ENABLE_DELAY_UNTIL_CATCH_UP
+    tick_now = xf_tick_get_count();
+    /* 错过了唤醒时间，推迟到 tick_now 之后的第一个周期点 */
+    if ((tick_period != 0U) && xf_task_tick_before(tick_wake, tick_now)) {
+        tick_late = tick_now - tick_wake;
+        tick_wake += ((tick_late - 1U) / tick_period + 1U) * tick_period;
+    }
+#endif
+    /* 唤醒时间已过去（追赶模式）时，入队后会在下一次调度时立即唤醒 */
+    *p_tick_last_wake = tick_wake;
+    return xf_task_sleep_insert(me, tick_wake);
 }
 
-xf_err_t xf_task_release_timer(xf_task_t *me)
+xf_err_t xf_task_sleep_remove(xf_task_t *me)
 {
-    xf_stimer_t *stimer;
-    if (me == NULL) {
+    xf_task_id_t id;
+    xf_task_id_t *p_link;
+    bool_t is_head;
+    XF_CRIT_STAT();
+    id = xf_task_to_id(me);
+    if (id == XF_TASK_ID_INVALID) {
         return XF_ERR_INVALID_ARG;
     }
-    if (me->id_stimer != XF_STIMER_ID_INVALID) {
-        stimer = xf_stimer_id_to_stimer(me->id_stimer);
-        if (stimer == NULL) {
-            XF_FATAL_ERROR();
-        }
-        xf_stimer_destroy(stimer);
-        me->id_stimer = XF_STIMER_ID_INVALID;
+    XF_CRIT_ENTRY();
+    if (!xf_task_attr_get_sleep(me)) {
+        XF_CRIT_EXIT();
+        return XF_OK;
+    }
+    is_head = (s_sleep_head == id) ? TRUE : FALSE;
+    p_link = &s_sleep_head;
+    while ((*p_link != XF_TASK_ID_INVALID) && (*p_link != id)) {
+        p_link = &s_task_pool[*p_link].id_sleep_next;
+    }
+    if (*p_link == id) {
+        *p_link = me->id_sleep_next;
+    }
+    me->id_sleep_next = XF_TASK_ID_INVALID;
+    xf_task_attr_set_sleep(me, 0);
+    XF_CRIT_EXIT();
+    if (is_head) {
+        xf_task_sleep_rearm();
     }
     return XF_OK;
 }
@@ -281,14 +473,44 @@ xf_err_t xf_task_release_subscr(xf_task_t *me)
     return XF_OK;
 }
 
-void xf_resume_task_timer_cb(xf_stimer_t *stimer)
+void xf_task_sleep_timer_cb(xf_stimer_t *stimer)
 {
-    xf_task_t *task = xf_task_cast(stimer->user_data);
-    if (task->id_stimer != xf_stimer_to_id(stimer)) {
-        XF_FATAL_ERROR();
+    xf_tick_t tick_now;
+    xf_task_t *task;
+    xf_task_id_t num_expired = 0;
+    xf_task_id_t id;
+    XF_CRIT_STAT();
+    UNUSED(stimer);
+    /*
+     * 先统计本次到期的任务数，最多唤醒这么多个任务。
+     * 被唤醒的任务可能再次睡眠并重新入队，不能在本次回调内再次处理；
+     * 也可能移除或删除其他睡眠任务，因此每次出队前仍要检查队首是否到期。
+     */
+    tick_now = xf_tick_get_count();
+    XF_CRIT_ENTRY();
+    id = s_sleep_head;
+    while ((id != XF_TASK_ID_INVALID)
+            && (!xf_task_tick_before(tick_now, s_task_pool[id].tick_wake))) {
+        ++num_expired;
+        id = s_task_pool[id].id_sleep_next;
     }
-    xf_task_release_timer(task);
-    xf_task_resume_root(task, NULL);
+    XF_CRIT_EXIT();
+    while (num_expired--) {
+        XF_CRIT_ENTRY();
+        id = s_sleep_head;
+        if ((id == XF_TASK_ID_INVALID)
+                || xf_task_tick_before(tick_now, s_task_pool[id].tick_wake)) {
+            XF_CRIT_EXIT();
+            break;
+        }
+        task = &s_task_pool[id];
+        s_sleep_head = task->id_sleep_next;
+        task->id_sleep_next = XF_TASK_ID_INVALID;
+        xf_task_attr_set_sleep(task, 0);
+        XF_CRIT_EXIT();
+        xf_task_resume_root(task, NULL);
+    }
+    xf_task_sleep_rearm();
 }
 
 void xf_resume_task_subscr_cb(xf_subscr_t *s, uint8_t ref_cnt, void *arg)
@@ -320,9 +542,7 @@ xf_err_t xf_task_setup_wait_until(
     if (id == XF_EVENT_ID_INVALID) {
         return XF_ERR_INVALID_ARG;
     }
-    if (tick_period != XF_STIMER_INFINITY) {
-        xf_task_acquire_timer(me, tick_period);
-    }
+    xf_task_sleep_enqueue(me, tick_period);
     xf_task_acquire_subscr(me, id);
     return XF_OK;
 }
@@ -332,16 +552,37 @@ xf_err_t xf_task_teardown_wait_until(xf_task_t *me)
     if (me == NULL) {
         return XF_ERR_INVALID_ARG;
     }
-    xf_task_release_timer(me);
+    xf_task_sleep_remove(me);
     xf_task_release_subscr(me);
     return XF_OK;
 }
 
+xf_err_t xf_task_wakeup(xf_task_t *task)
+{
+    xf_task_t *root;
+    if ((task == NULL) || (task->cb_func == NULL)) {
+        return XF_ERR_INVALID_ARG;
+    }
+    root = task;
+    while (root->id_parent != XF_TASK_ID_INVALID) {
+        root = xf_task_id_to_task(root->id_parent);
+        if (root == NULL) {
+            XF_FATAL_ERROR();
+            return XF_FAIL;
+        }
+    }
+    /* 不在此处直接运行，避免在其他任务内重入；交给 xf_task_sched 调度 */
+    xf_task_attr_set_state(root, XF_TASK_READY);
+    xf_task_sched_resume();
+    return XF_OK;
+}
+
 void xf_task_sched_timer_cb(xf_stimer_t *stimer)
 {
     UNUSED(stimer);
-    xf_task_sched(NULL);
+    /* 先挂起，调度过程中被唤醒或新建的任务会重新恢复调度器 */
     xf_task_sched_suspend();
+    xf_task_sched(NULL);
 }
 
 void xf_task_nest_depth_inc(void)
@@ -390,11 +631,110 @@ static void xf_task_sched_resume(void)
     xf_stimer_set_ready(s_sched_stimer);
 }
 
+/* 不触发 xf_stimer_handler 重新扫描，留到下一次 xf_stimer_handler 再调度 */
+static void xf_task_sched_resume_next(void)
+{
+    xf_stimer_set_period(s_sched_stimer, 0);
+}
+
 static void xf_task_sched_suspend(void)
 {
     xf_stimer_set_period(s_sched_stimer, XF_STIMER_INFINITY);
 }
 
+#if XF_TASK_ENABLE_STATIC
+static void xf_task_static_init(void)
+{
+    const xf_task_static_t *desc;
+    xf_task_t *task;
+    uint8_t num = 0;
+    for (desc = &__start_xf_task_static[0]; desc < &__stop_xf_task_static[0]; ++desc) {
+        task = xf_task_static_to_task(desc);
+        /*
+            任务池不足，或静态任务初始化前已有任务占用。
+            未分配过任何任务时，任务池按序号升序分配。
+         */
+        if ((task == NULL) || (xf_task_acquire() != task)) {
+            XF_FATAL_ERROR();
+            return;
+        }
+        xf_task_init(task, desc->cb_func, desc->user_data);
+        ++num;
+    }
+    if (num != 0) {
+        xf_task_sched_resume();
+    }
+}
+#endif
+
+/* 考虑回绕，a 早于 b 时返回 TRUE */
+static bool_t xf_task_tick_before(xf_tick_t a, xf_tick_t b)
+{
+    return ((xf_tick_t)(a - b) > (XF_TICK_MAX / 2)) ? TRUE : FALSE;
+}
+
+static xf_err_t xf_task_sleep_insert(xf_task_t *me, xf_tick_t tick_wake)
+{
+    xf_task_id_t id;
+    xf_task_id_t *p_link;
+    xf_task_t *cur;
+    bool_t is_head;
+    XF_CRIT_STAT();
+    id = xf_task_to_id(me);
+    if (id == XF_TASK_ID_INVALID) {
+        return XF_ERR_INVALID_ARG;
+    }
+    if (xf_task_attr_get_sleep(me)) {
+        return XF_ERR_INITED;
+    }
+    if (s_sleep_stimer == NULL) {
+        XF_FATAL_ERROR();
+        return XF_FAIL;
+    }
+    XF_CRIT_ENTRY();
+    me->tick_wake = tick_wake;
+    /* 插入到唤醒时间相同的任务之后，保持先入先出 */
+    p_link = &s_sleep_head;
+    while (*p_link != XF_TASK_ID_INVALID) {
+        cur = &s_task_pool[*p_link];
+        if (xf_task_tick_before(me->tick_wake, cur->tick_wake)) {
+            break;
+        }
+        p_link = &cur->id_sleep_next;
+    }
+    me->id_sleep_next = *p_link;
+    *p_link = id;
+    xf_task_attr_set_sleep(me, 1);
+    is_head = (s_sleep_head == id) ? TRUE : FALSE;
+    XF_CRIT_EXIT();
+    if (is_head) {
+        xf_task_sleep_rearm();
+    }
+    return XF_OK;
+}
+
+static void xf_task_sleep_rearm(void)
+{
+    xf_tick_t tick_now;
+    xf_tick_t tick_period;
+    XF_CRIT_STAT();
+    if (s_sleep_stimer == NULL) {
+        return;
+    }
+    tick_now = xf_tick_get_count();
+    XF_CRIT_ENTRY();
+    if (s_sleep_head == XF_TASK_ID_INVALID) {
+        tick_period = XF_STIMER_INFINITY;
+    } else if (xf_task_tick_before(tick_now, s_task_pool[s_sleep_head].tick_wake)) {
+        tick_period = s_task_pool[s_sleep_head].tick_wake - tick_now;
+    } else {
+        tick_period = 0;
+    }
+    XF_CRIT_EXIT();
+    xf_stimer_set_period(s_sleep_stimer, tick_period);
+    xf_stimer_reset(s_sleep_stimer);
+}
+
 static xf_err_t xf_task_resume_root(xf_task_t *task, void *arg)
 {
     xf_task_t *parent;
@@ -412,22 +752,121 @@ static xf_err_t xf_task_resume_root(xf_task_t *task, void *arg)
             parent = xf_task_id_to_task(parent->id_parent);
         } while (parent != NULL);
     }
-    xf_task_run(root, arg);
+    xf_task_attr_set_state(root, XF_TASK_READY);
+    xf_task_run_root(root, arg);
     return XF_OK;
 }
 
-static xf_err_t xf_task_sched(void *arg)
+static xf_task_async_t xf_task_run_root(xf_task_t *task, void *arg)
 {
-    uint8_t i;
-    xf_task_t *task;
-    for (i = 0; i < XF_TASK_NUM_MAX; ++i) {
-        task = &s_task_pool[i];
-        if ((task->cb_func)
-                && (xf_task_attr_get_state(task) == XF_TASK_READY)
-                && (task->id_parent == XF_TASK_ID_INVALID) /*!< 只调度顶级任务 */
-           ) {
-            xf_task_run_direct(task, arg);
+    xf_task_async_t state;
+    xf_arena_t *p_arena = s_scratch_arena;
+    xf_arena_mark_t arena_mark = xf_arena_mark(p_arena);
+#if XF_TASK_ENABLE_STATS
+    xf_tick_t tick_start = xf_tick_get_count();
+    xf_tick_t tick_run;
+#endif
+    XF_PROF_ZONE_BEGIN(xf_task_run);
+    state = xf_task_run_direct(task, arg);
+    XF_PROF_ZONE_END(xf_task_run);
+    if (p_arena != NULL) {
+        (void)xf_arena_reset_to(p_arena, &arena_mark);
+    }
+#if XF_TASK_ENABLE_STATS
+    /* 任务结束后已被清空，不再统计 */
+    if (state != XF_TASK_TERMINATED) {
+        tick_run = xf_tick_elaps(tick_start);
+        task->stats.run_cnt++;
+        task->stats.tick_total += tick_run;
+        if (tick_run > task->stats.tick_max) {
+            task->stats.tick_max = tick_run;
         }
     }
+#endif
+    return state;
+}
+
+static xf_err_t xf_task_sched(void *arg)
+{
+    /* 预算用完时 s_sched_rr 会被修改，先取出本轮的起点 */
+    uint8_t rr = s_sched_rr;
+#if XF_TASK_SCHED_BUDGET
+    xf_tick_t tick_start = xf_tick_get_count();
+#else
+    xf_tick_t tick_start = 0;
+#endif
+    XF_PROF_ZONE_BEGIN(xf_task_sched);
+    /* 从 rr 到末尾，再回绕到 rr 之前 */
+    if (xf_task_sched_range(arg, rr, XF_TASK_NUM_MAX, tick_start)) {
+        (void)xf_task_sched_range(arg, 0, rr, tick_start);
+    }
+    XF_PROF_ZONE_END(xf_task_sched);
     return XF_OK;
 }
+
+/**
+ * @brief 调度 [start, end) 内已分配的任务.
+ *
+ * @return bool_t 预算用完时返回 FALSE.
+ */
+static bool_t xf_task_sched_range(void *arg, uint8_t start, uint8_t end, xf_tick_t tick_start)
+{
+    int32_t id;
+#if XF_TASK_ENABLE_HBITMAP
+    XF_CRIT_STAT();
+    if (start >= end) {
+        return TRUE;
+    }
+    XF_CRIT_ENTRY();
+    id = xf_hbitmap_find_next_set(&s_task_hbm, start);
+    XF_CRIT_EXIT();
+    while ((id >= 0) && (id < (int32_t)end)) {
+        if (!xf_task_sched_one(&s_task_pool[id], arg, tick_start)) {
+            return FALSE;
+        }
+        XF_CRIT_ENTRY();
+        id = xf_hbitmap_find_next_set(&s_task_hbm, (uint32_t)id + 1U);
+        XF_CRIT_EXIT();
+    }
+#else
+    xf_bitmap_iter_t it;
+    XF_BITMAP_FOR_EACH_SET_BIT_IN(id, &it, s_task_bm, start, end) {
+        if (!xf_task_sched_one(&s_task_pool[id], arg, tick_start)) {
+            return FALSE;
+        }
+    }
+#endif
+    return TRUE;
+}
+
+/**
+ * @brief 调度一个任务.
+ *
+ * @return bool_t 预算用完时返回 FALSE.
+ */
+static bool_t xf_task_sched_one(xf_task_t *task, void *arg, xf_tick_t tick_start)
+{
+#if !XF_TASK_SCHED_BUDGET
+    UNUSED(tick_start);
+#endif
+    if ((task->cb_func == NULL)
+            || (xf_task_attr_get_state(task) != XF_TASK_READY)
+            || (task->id_parent != XF_TASK_ID_INVALID) /*!< 只调度顶级任务 */
+       ) {
+        return TRUE;
+    }
+    if (xf_task_run_root(task, arg) == XF_TASK_READY) {
+        /* 让出的任务仍然就绪，下一轮继续调度 */
+        xf_task_sched_resume_next();
+    }
+#if XF_TASK_SCHED_BUDGET
+    if (xf_tick_elaps(tick_start) >= XF_TASK_SCHED_BUDGET) {
+        /* 预算用完，下一轮从下一个任务开始，剩余任务不会被饿死 */
+        uint8_t idx = (uint8_t)xf_task_to_id(task);
+        s_sched_rr = (uint8_t)((idx + 1U < XF_TASK_NUM_MAX) ? (idx + 1U) : 0U);
+        xf_task_sched_resume_next();
+        return FALSE;
+    }
+#endif
+    return TRUE;
+}
@@ -63,6 +63,79 @@ xf_task_id_t xf_task_to_id(const xf_task_t *task);
  */
 xf_task_t *xf_task_id_to_task(xf_task_id_t id);
 
+/**
+ * @brief 遍历任务池中已创建的任务（包括子任务）.
+ *
+ * @code{.c}
+ * xf_task_t *task = NULL;
+ * while ((task = xf_task_iter_next(task)) != NULL) {
+ *     // ...
+ * }
+ * @endcode
+ *
+ * @param task          上一个任务，为 NULL 时从头开始。
+ * @return xf_task_t *
+ *      - NULL                  遍历结束
+ *      - OTHER                 下一个任务
+ */
+xf_task_t *xf_task_iter_next(const xf_task_t *task);
+
+#if XF_TASK_ENABLE_STATS
+/**
+ * @brief 获取任务运行统计.
+ *
+ * @param task          任务句柄。
+ * @param[out] p_stats  传出运行统计。
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_OK                 成功
+ */
+xf_err_t xf_task_get_stats(const xf_task_t *task, xf_task_stats_t *p_stats);
+
+/**
+ * @brief 清空任务运行统计.
+ *
+ * @param task          任务句柄，为 NULL 时清空所有任务。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ */
+xf_err_t xf_task_reset_stats(xf_task_t *task);
+#endif
+
+#if XF_TASK_ENABLE_STATIC
+/**
+ * @brief 静态任务描述符转任务句柄.
+ *
+ * @param desc          静态任务描述符，见 @ref XF_TASK_DEFINE_STATIC.
+ * @return xf_task_t *
+ *      - NULL                  无效描述符
+ *      - OTHER                 任务句柄
+ */
+xf_task_t *xf_task_static_to_task(const xf_task_static_t *desc);
+#endif
+
+/**
+ * @brief 设置任务的临时区域.
+ *
+ * 调度器每次运行一个顶级任务（连同其子任务）前标记该区域，任务让出或结束后回退。
+ * 任务在两次让出之间从 xf_task_get_scratch_arena() 分配的内存因此一次性释放，
+ * 与协程的局部变量一样，不能跨越 xf_task_delay 等让出点使用。
+ *
+ * @param p_arena       区域，为 NULL 时不使用。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ */
+xf_err_t xf_task_set_scratch_arena(xf_arena_t *p_arena);
+
+/**
+ * @brief 获取任务的临时区域.
+ *
+ * @return xf_arena_t *
+ *      - NULL                  未设置
+ *      - OTHER                 区域
+ */
+xf_arena_t *xf_task_get_scratch_arena(void);
+
 /* ==================== [Macros] ============================================ */
 
 /**
@@ -73,6 +146,47 @@ xf_task_t *xf_task_id_to_task(xf_task_id_t id);
 #define XF_TASK_FUNC(_name)             XF_TASK_FUNC_IMPL(_name)
 #define XF_TASK_FUNC_IMPL(_name)        xf_task_async_t _name(xf_task_t *me, void *arg)
 
+#if XF_TASK_ENABLE_STATIC
+
+/**
+ * @brief 定义静态任务.
+ *
+ * 描述符在编译期放入 xf_task_static 段，xf_task_sched_init() 时
+ * 按段内顺序直接填入任务池的前几项并统一恢复调度，不需要逐个 xf_task_create.
+ *
+ * @note 1. 必须在任何 xf_task_create 之前调用 xf_task_sched_init().
+ * @note 2. 使用自定义链接脚本时，需要 KEEP(*(xf_task_static)) 并保持段名不变，
+ *          以便链接器生成 __start_xf_task_static / __stop_xf_task_static.
+ *
+ * @param _name         静态任务名，需全局唯一。
+ * @param _cb_func      任务函数。 @ref xf_task_cb_t.
+ * @param _user_data    任务内的用户数据，必须是常量表达式。
+ */
+#define XF_TASK_DEFINE_STATIC(_name, _cb_func, _user_data) \
+                                        const xf_task_static_t XCAT2(xf_task_static_, _name) \
+                                        __used __section("xf_task_static") \
+                                        __aligned(__alignof__(xf_task_static_t)) = { \
+                                            xf_task_cb_cast(_cb_func), \
+                                            (void *)(uintptr_t)(_user_data), \
+                                        }
+
+/**
+ * @brief 声明其他文件中定义的静态任务.
+ *
+ * @param _name         静态任务名。
+ */
+#define XF_TASK_DECLARE_STATIC(_name)   extern const xf_task_static_t XCAT2(xf_task_static_, _name)
+
+/**
+ * @brief 获取静态任务的任务句柄.
+ *
+ * @param _name         静态任务名。
+ * @return xf_task_t*   任务句柄。
+ */
+#define xf_task_static_get(_name)       xf_task_static_to_task(&XCAT2(xf_task_static_, _name))
+
+#endif /* XF_TASK_ENABLE_STATIC */
+
 /**
  * @brief 创建任务.
  *
@@ -266,6 +380,25 @@ xf_task_t *xf_task_id_to_task(xf_task_id_t id);
  */
 #define xf_task_delay_ms(_me, _ms)      xf_task_delay_ms_i((_me), (_ms))
 
+/**
+ * @brief 任务延时到上一次唤醒时间之后的一个周期，用于固定周期的循环.
+ *
+ * 与 xf_task_delay 不同，延时从 *_p_tick_last_wake 开始计算，
+ * 循环体和调度的耗时不会累积成漂移。
+ * 唤醒时间已过去一个周期以上时（overrun）：
+ * - XF_TASK_ENABLE_DELAY_UNTIL_CATCH_UP 为 1: 不再延时，立即补执行错过的周期；
+ * - XF_TASK_ENABLE_DELAY_UNTIL_CATCH_UP 为 0: 跳过错过的周期，保持原有相位。
+ *
+ * @warning _p_tick_last_wake 指向的变量必须位于 user_data 或静态存储中，
+ *          并在进入循环前用 xf_tick_get_count() 初始化。
+ *
+ * @param _me               当前任务。 @ref xf_task_t* .
+ * @param _p_tick_last_wake 上一次唤醒时间，返回时更新为本次唤醒时间。 @ref xf_tick_t* .
+ * @param _tick_period      周期，单位 (tick)。 @ref xf_tick_t.
+ */
+#define xf_task_delay_until(_me, _p_tick_last_wake, _tick_period) \
+                                        xf_task_delay_until_i((_me), (_p_tick_last_wake), (_tick_period))
+
 /**
  * @brief 任务等待事件.
  *
@@ -102,7 +102,11 @@ typedef xf_task_async_t (*xf_task_cb_t)(xf_task_t *me, void *arg);
  *    - XF_TASK_READY
  *    - XF_TASK_BLOCKED
  *
- * 2. B2 ~ B7: 保留位 (reserved).
+ * 2. B2: 睡眠 (sleep).
+ *
+ *    为 1 时任务位于睡眠队列中，见 @ref xf_task_sleep_enqueue.
+ *
+ * 3. B3 ~ B7: 保留位 (reserved).
  *
  *    系统保留。
  *
@@ -113,9 +117,21 @@ typedef xf_task_async_t (*xf_task_cb_t)(xf_task_t *me, void *arg);
  */
 typedef struct xf_task_attr {
     uint8_t state:          2;
-    uint8_t reserved:       6;
+    uint8_t sleep:          1;
+    uint8_t reserved:       5;
 } xf_task_attr_t;
 
+#if XF_TASK_ENABLE_STATS
+/**
+ * @brief 任务运行统计，只统计顶级任务（子任务计入顶级任务）。
+ */
+typedef struct xf_task_stats {
+    uint32_t                run_cnt;        /*!< 运行次数 */
+    xf_tick_t               tick_total;     /*!< 累计运行时间，单位 tick */
+    xf_tick_t               tick_max;       /*!< 单次最长运行时间，单位 tick */
+} xf_task_stats_t;
+#endif
+
 /**
  * @brief 无栈协程上下文（系统上下文）基类。
  */
@@ -128,13 +144,25 @@ struct xf_task {
      * @brief Local Continuations（本地延续，当前代码的执行位置）。
      */
     volatile xf_task_lc_t   lc;
-    xf_stimer_id_t          id_stimer;      /*!< 定时器 id */
+    xf_tick_t               tick_wake;      /*!< 睡眠队列中的唤醒时间，单位 tick */
+    xf_task_id_t            id_sleep_next;  /*!< 睡眠队列中的下一个任务 id */
     xf_ps_subscr_id_t       id_subscr;      /*!< 发布订阅 id */
     xf_task_id_t            id_parent;      /*!< 父任务 id */
     xf_task_id_t            id_child;       /*!< 子任务 id ，此处决定一个任务只能等一个子任务 */
     xf_task_attr_t          attr;           /*!< 任务属性 */
+#if XF_TASK_ENABLE_STATS
+    xf_task_stats_t         stats;          /*!< 运行统计 */
+#endif
 };
 
+/**
+ * @brief 静态任务描述符，见 @ref XF_TASK_DEFINE_STATIC.
+ */
+typedef struct xf_task_static {
+    xf_task_cb_t            cb_func;        /*!< 协程执行函数 */
+    void                   *user_data;      /*!< 用户数据 */
+} xf_task_static_t;
+
 /* ==================== [Global Prototypes] ================================= */
 
 /* ==================== [Macros] ============================================ */
@@ -153,6 +181,11 @@ struct xf_task {
 #define xf_task_attr_set_state(_task, _value) \
                                         (xf_task_cast(_task)->attr.state = (_value))
 
+#define xf_task_attr_get_sleep(_task)   (xf_task_cast(_task)->attr.sleep)
+
+#define xf_task_attr_set_sleep(_task, _value) \
+                                        (xf_task_cast(_task)->attr.sleep = (_value))
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -37,19 +37,23 @@ xf_err_t xf_task_release(xf_task_t *task);
 xf_err_t xf_task_init(xf_task_t *task, xf_task_cb_t cb_func, void *user_data);
 xf_err_t xf_task_deinit(xf_task_t *task);
 
-xf_err_t xf_task_acquire_timer(xf_task_t *me, xf_tick_t tick_period);
-xf_err_t xf_task_release_timer(xf_task_t *me);
+xf_err_t xf_task_sleep_enqueue(xf_task_t *me, xf_tick_t tick);
+xf_err_t xf_task_sleep_enqueue_until(
+    xf_task_t *me, xf_tick_t *p_tick_last_wake, xf_tick_t tick_period);
+xf_err_t xf_task_sleep_remove(xf_task_t *me);
 
 xf_err_t xf_task_acquire_subscr(xf_task_t *me, xf_event_id_t id);
 xf_err_t xf_task_release_subscr(xf_task_t *me);
 
 void xf_task_sched_timer_cb(xf_stimer_t *stimer);
-void xf_resume_task_timer_cb(xf_stimer_t *stimer);
+void xf_task_sleep_timer_cb(xf_stimer_t *stimer);
 void xf_resume_task_subscr_cb(xf_subscr_t *s, uint8_t ref_cnt, void *arg);
 
 xf_err_t xf_task_setup_wait_until(xf_task_t *me, xf_event_id_t id, xf_tick_t tick_period);
 xf_err_t xf_task_teardown_wait_until(xf_task_t *me);
 
+xf_err_t xf_task_wakeup(xf_task_t *task);
+
 xf_task_t *xf_task_create_(xf_task_t *parent, xf_task_cb_t cb_func, void *user_data);
 xf_err_t xf_task_destroy_(xf_task_t *task);
 
@@ -154,12 +158,20 @@ xf_err_t xf_task_get_event_msg(const xf_task_t *me, xf_event_msg_t *p_msg);
                                         } while (0)
 
 #define xf_task_delay_i(_me, _tick)     do { \
-                                            xf_task_acquire_timer((_me), (_tick)); \
+                                            xf_task_sleep_enqueue(xf_task_cast(_me), (_tick)); \
+                                            xf_task_block_i((_me)); \
+                                            xf_task_sleep_remove(xf_task_cast(_me)); \
+                                        } while (0)
+
+#define xf_task_delay_until_i(_me, _p_tick_last_wake, _tick_period) \
+                                        do { \
+                                            xf_task_sleep_enqueue_until(xf_task_cast(_me), \
+                                                                        (_p_tick_last_wake), (_tick_period)); \
                                             xf_task_block_i((_me)); \
-                                            xf_task_release_timer((_me)); \
+                                            xf_task_sleep_remove(xf_task_cast(_me)); \
                                         } while (0)
 
-#define xf_task_delay_ms_i(_me, _ms)    xf_task_delay_i((_me), xf_tick_to_ms(_ms))
+#define xf_task_delay_ms_i(_me, _ms)    xf_task_delay_i((_me), xf_ms_to_tick(_ms))
 
 #define xf_task_wait_until_i(_me, _id, _tick, _p_xf_err, _p_e_msg) \
                                         do { \
@@ -173,7 +185,7 @@ xf_err_t xf_task_get_event_msg(const xf_task_t *me, xf_event_msg_t *p_msg);
                                         } while (0)
 
 #define xf_task_wait_until_ms_i(_me, _id, _ms, _p_xf_err, _p_e_msg) \
-                                        xf_task_wait_until_i((_me), (_id), xf_tick_to_ms(_ms), (_p_xf_err), (_p_e_msg))
+                                        xf_task_wait_until_i((_me), (_id), xf_ms_to_tick(_ms), (_p_xf_err), (_p_e_msg))
 
 #ifdef __cplusplus
 } /* extern "C" */
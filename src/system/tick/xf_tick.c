@@ -16,6 +16,7 @@
 /* ==================== [Includes] ========================================== */
 
 #include "xf_tick.h"
+#include "../safe/xf_safe.h"
 
 /* ==================== [Defines] =========================================== */
 
@@ -23,12 +24,20 @@
 
 /* ==================== [Static Prototypes] ================================= */
 
+static void tick_store(xf_tick_t tick);
+static xf_tick_t tick_hw_counter_get(void);
+static void tick_update_get_cb(void);
+
 /* ==================== [Static Variables] ================================== */
 
-static xf_tick_t s_sys_tick = 0U;
-static volatile uint8_t tick_irq_flag;
 static xf_tick_get_cb_t s_get_tick_cb = NULL;
 static xf_tick_delay_cb_t s_delay_cb = NULL;
+static xf_tick_hw_counter_cb_t s_hw_counter_cb = NULL;
+static uint32_t s_hw_counter_last = 0U;
+
+/* ==================== [Global Variables] ================================== */
+
+xf_tick_state_t xf_tick_i = {0};
 
 /* ==================== [Macros] ============================================ */
 
@@ -36,35 +45,16 @@ static xf_tick_delay_cb_t s_delay_cb = NULL;
 
 xf_tick_t xf_tick_inc(xf_tick_t tick)
 {
-    xf_tick_t sys_tick_prev = s_sys_tick;
-    tick_irq_flag = 0;
-    s_sys_tick += tick;
+    /* 只有一个写者，读-改-写不需要原子 */
+    xf_tick_t sys_tick_prev = xf_tick_load_i();
+    tick_store(sys_tick_prev + tick);
     return sys_tick_prev;
 }
 
-xf_tick_t xf_tick_get_count(void)
-{
-    xf_tick_t result = 0;
-    if (s_get_tick_cb) {
-        return s_get_tick_cb();
-    }
-    do {
-        tick_irq_flag = 1;
-        result        = s_sys_tick;
-    } while (!tick_irq_flag);
-    return result;
-}
-
 xf_tick_t xf_tick_elaps(xf_tick_t prev_tick)
 {
-    xf_tick_t act_time = xf_tick_get_count();
-    if (act_time >= prev_tick) {
-        prev_tick = act_time - prev_tick;
-    } else {
-        prev_tick = XF_TICK_MAX - prev_tick + 1;
-        prev_tick += act_time;
-    }
-    return prev_tick;
+    /* 无符号减法即按 XF_TICK_MAX + 1 取模，回绕时也正确 */
+    return (xf_tick_t)(xf_tick_get_count() - prev_tick);
 }
 
 void xf_tick_delay(xf_tick_t tick)
@@ -75,7 +65,7 @@ void xf_tick_delay(xf_tick_t tick)
         xf_tick_t start_tick = xf_tick_get_count();
         while (xf_tick_elaps(start_tick) < tick) {
             volatile uint32_t i;
-            volatile uint32_t x = tick;
+            volatile uint32_t x = (uint32_t)tick;
             for (i = 0; i < 100; i++) {
                 x = x * 3;
             }
@@ -85,7 +75,11 @@ void xf_tick_delay(xf_tick_t tick)
 
 void xf_tick_set_tick_cb(xf_tick_get_cb_t cb)
 {
+    XF_CRIT_STAT();
+    XF_CRIT_ENTRY();
     s_get_tick_cb = cb;
+    tick_update_get_cb();
+    XF_CRIT_EXIT();
 }
 
 void xf_tick_set_delay_cb(xf_tick_delay_cb_t cb)
@@ -93,4 +87,56 @@ void xf_tick_set_delay_cb(xf_tick_delay_cb_t cb)
     s_delay_cb = cb;
 }
 
+void xf_tick_set_hw_counter_cb(xf_tick_hw_counter_cb_t cb)
+{
+    XF_CRIT_STAT();
+    XF_CRIT_ENTRY();
+    if (cb != NULL) {
+        s_hw_counter_last = cb();
+    }
+    s_hw_counter_cb = cb;
+    tick_update_get_cb();
+    XF_CRIT_EXIT();
+}
+
 /* ==================== [Static Functions] ================================== */
+
+static void tick_store(xf_tick_t tick)
+{
+#if XF_TICK_ENABLE_SEQLOCK
+    uint32_t seq = xf_tick_i.seq;
+    /* 上一次递增序号先于本次写副本，读者读到本次写入时必然看到序号已变 */
+    XF_TICK_FENCE_REL_I();
+    xf_tick_i.count[(seq + 1U) & 1U] = tick;
+    XF_TICK_STORE_REL_I(&xf_tick_i.seq, seq + 1U);
+#else
+    XF_TICK_STORE_I(&xf_tick_i.count, tick);
+#endif
+}
+
+static xf_tick_t tick_hw_counter_get(void)
+{
+    xf_tick_t result;
+    uint32_t counter;
+    XF_CRIT_STAT();
+    XF_CRIT_ENTRY();
+    /* 无符号差值自动处理计数器的 32 位回绕 */
+    counter = s_hw_counter_cb();
+    result = xf_tick_load_i() + (xf_tick_t)(uint32_t)(counter - s_hw_counter_last);
+    s_hw_counter_last = counter;
+    tick_store(result);
+    XF_CRIT_EXIT();
+    return result;
+}
+
+static void tick_update_get_cb(void)
+{
+    /* tick_cb 优先于硬件计数器 */
+    if (s_get_tick_cb != NULL) {
+        xf_tick_i.get_cb = s_get_tick_cb;
+    } else if (s_hw_counter_cb != NULL) {
+        xf_tick_i.get_cb = tick_hw_counter_get;
+    } else {
+        xf_tick_i.get_cb = NULL;
+    }
+}
@@ -26,19 +26,86 @@ extern "C" {
 
 /* ==================== [Defines] =========================================== */
 
+/*
+    NOTE 时基
+
+    1.  默认由中断周期调用 xf_tick_inc() 计数，也可以用 xf_tick_set_tick_cb()
+        直接提供计数值。
+    1.  无节拍（tick-less）模式: xf_tick_set_hw_counter_cb() 设置一个读取
+        硬件自由运行计数器（如 SysTick 以外的 32 位定时器、DWT->CYCCNT、
+        主机的 clock_gettime）的回调，计数频率即 XF_TICK_FREQ, 不需要 tick 中断。
+        计数器的 32 位回绕在 xf_tick_get_count() 内扩展为 xf_tick_t,
+        因此两次调用 xf_tick_get_count() 的间隔不能超过一次回绕
+        （例如 1MHz 约 71 分钟, 168MHz 约 25 秒），xf_stimer_handler 每轮都会调用。
+    1.  XF_TICK_ENABLE_64BITS 时 xf_tick_t 为 64 位，XF_TICK_FREQ 可以设为
+        1000000（微秒）或 CPU 频率而不用担心回绕。32 位时各模块也按回绕处理，
+        但单个周期、延时不能超过 XF_TICK_MAX / 2.
+    1.  xf_tick_get_count() 是内联函数。xf_tick_t 不超过 CPU 字长时只有一次原子读；
+        32 位 CPU 上的 64 位 xf_tick_t 使用带两个副本的序列锁（latch）:
+        xf_tick_inc() 先写另一个副本再递增序号，读者读序号指示的副本，
+        序号变化时重读。写者被高优先级中断打断时，中断内读到的是旧副本，不会自旋。
+        xf_tick_inc() 只能在一个上下文（如 tick 中断）中调用。
+ */
+
+#if !defined(XF_TICK_ENABLE_SEQLOCK)
+#   if XF_TICK_ENABLE_64BITS && !(defined(UINTPTR_MAX) && (UINTPTR_MAX > 0xFFFFFFFFU))
+#       define XF_TICK_ENABLE_SEQLOCK   1
+#   else
+#       define XF_TICK_ENABLE_SEQLOCK   0
+#   endif
+#endif
+
+#if XF_COMMON_ENABLE_BUILTIN && defined(__GNUC__)
+#   define XF_TICK_LOAD_I(_p)           __atomic_load_n((_p), __ATOMIC_RELAXED)
+#   define XF_TICK_LOAD_ACQ_I(_p)       __atomic_load_n((_p), __ATOMIC_ACQUIRE)
+#   define XF_TICK_STORE_I(_p, _v)      __atomic_store_n((_p), (_v), __ATOMIC_RELAXED)
+#   define XF_TICK_STORE_REL_I(_p, _v)  __atomic_store_n((_p), (_v), __ATOMIC_RELEASE)
+#   define XF_TICK_FENCE_ACQ_I()        __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#   define XF_TICK_FENCE_REL_I()        __atomic_thread_fence(__ATOMIC_RELEASE)
+#else
+/* 单核上 volatile 访问之间不会被编译器重排 */
+#   define XF_TICK_LOAD_I(_p)           (*(_p))
+#   define XF_TICK_LOAD_ACQ_I(_p)       (*(_p))
+#   define XF_TICK_STORE_I(_p, _v)      (*(_p) = (_v))
+#   define XF_TICK_STORE_REL_I(_p, _v)  (*(_p) = (_v))
+#   define XF_TICK_FENCE_ACQ_I()        ((void)0)
+#   define XF_TICK_FENCE_REL_I()        ((void)0)
+#endif
+
 /* ==================== [Typedefs] ========================================== */
 
+#if XF_TICK_ENABLE_64BITS
+typedef uint64_t xf_tick_t;
+#else
 typedef uint32_t xf_tick_t;
+#endif
 #define XF_TICK_MAX ((xf_tick_t)~(xf_tick_t)0)
 
 typedef xf_tick_t (*xf_tick_get_cb_t)(void);
 
 typedef void (*xf_tick_delay_cb_t)(xf_tick_t tick);
 
+/**
+ * @brief 读取硬件自由运行计数器，按 XF_TICK_FREQ 递增，32 位回绕.
+ */
+typedef uint32_t (*xf_tick_hw_counter_cb_t)(void);
+
+/**
+ * @brief 时基内部状态，仅供内联的 xf_tick_get_count() 使用.
+ */
+typedef struct xf_tick_state {
+#if XF_TICK_ENABLE_SEQLOCK
+    volatile xf_tick_t      count[2];       /*!< 两个副本，序号最低位指示当前副本 */
+    volatile uint32_t       seq;            /*!< 序号 */
+#else
+    volatile xf_tick_t      count;          /*!< 计数值 */
+#endif
+    xf_tick_get_cb_t        get_cb;         /*!< 非 NULL 时由此读取计数值 */
+} xf_tick_state_t;
+
 /* ==================== [Global Prototypes] ================================= */
 
 xf_tick_t xf_tick_inc(xf_tick_t tick);
-xf_tick_t xf_tick_get_count(void);
 xf_tick_t xf_tick_elaps(xf_tick_t prev_tick);
 
 /* 阻塞 delay ，小心使用！如果未设 tick_cb/delay_cb 且不在中断中调用 xf_tick_inc() 将死机 */
@@ -47,15 +114,133 @@ void xf_tick_delay(xf_tick_t tick);
 void xf_tick_set_tick_cb(xf_tick_get_cb_t cb);
 void xf_tick_set_delay_cb(xf_tick_delay_cb_t cb);
 
+/**
+ * @brief 设置硬件计数器回调，进入无节拍模式. 当前计数值从此延续，不会跳变.
+ *
+ * @param cb    为 NULL 时回到 xf_tick_inc() 计数。
+ */
+void xf_tick_set_hw_counter_cb(xf_tick_hw_counter_cb_t cb);
+
+extern xf_tick_state_t xf_tick_i;
+
 /* ==================== [Macros] ============================================ */
 
 #define xf_tick_get_tick_freq()         (XF_TICK_FREQ)
-#define xf_tick_to_us(_tick)            (((_tick) * 1000000U) / xf_tick_get_tick_freq())
-#define xf_tick_to_ms(_tick)            (((_tick) * 1000U) / xf_tick_get_tick_freq())
-#define xf_us_to_tick(_us)              ((_us) * xf_tick_get_tick_freq() / (1000000U))
-#define xf_ms_to_tick(_ms)              (((_ms) * xf_tick_get_tick_freq()) / (1000U))
-#define xf_tick_get_us()                ((xf_tick_get_count() * 1000000U) / xf_tick_get_tick_freq())
-#define xf_tick_get_ms()                ((xf_tick_get_count() * 1000U) / xf_tick_get_tick_freq())
+
+/*
+    NOTE tick 与时间的换算
+
+    1.  编译时把 XF_TICK_FREQ 与 10^3 / 10^6 / 10^9 约分（只有 2 和 5 两个公因子），
+        换算为 v * MUL / DIV. 例如 1kHz 时 tick 与 ms 相同，不做乘除；
+        32768Hz 时 DIV 为 2 的幂，只有移位。
+    1.  按 (v / DIV) * MUL + (v % DIV) * MUL / DIV 计算，结果精确（向下取整），
+        中间结果不会比最终结果先溢出；余数项超出 32 位时才使用 64 位。
+    1.  DIV 是常数，编译器会把除法编译为乘法加移位；
+        参数为常量时整个表达式是常量表达式，可用于静态初始化。
+ */
+
+/* XF_TICK_FREQ 中因子 2 与 5 的部分（各最多取 9 个） */
+#define XF_TICK_FREQ_P2                 \
+    (((XF_TICK_FREQ) % 512UL == 0) ? 512UL : ((XF_TICK_FREQ) % 256UL == 0) ? 256UL \
+     : ((XF_TICK_FREQ) % 128UL == 0) ? 128UL : ((XF_TICK_FREQ) % 64UL == 0) ? 64UL \
+     : ((XF_TICK_FREQ) % 32UL == 0) ? 32UL : ((XF_TICK_FREQ) % 16UL == 0) ? 16UL \
+     : ((XF_TICK_FREQ) % 8UL == 0) ? 8UL : ((XF_TICK_FREQ) % 4UL == 0) ? 4UL \
+     : ((XF_TICK_FREQ) % 2UL == 0) ? 2UL : 1UL)
+#define XF_TICK_FREQ_P5                 \
+    (((XF_TICK_FREQ) % 1953125UL == 0) ? 1953125UL : ((XF_TICK_FREQ) % 390625UL == 0) ? 390625UL \
+     : ((XF_TICK_FREQ) % 78125UL == 0) ? 78125UL : ((XF_TICK_FREQ) % 15625UL == 0) ? 15625UL \
+     : ((XF_TICK_FREQ) % 3125UL == 0) ? 3125UL : ((XF_TICK_FREQ) % 625UL == 0) ? 625UL \
+     : ((XF_TICK_FREQ) % 125UL == 0) ? 125UL : ((XF_TICK_FREQ) % 25UL == 0) ? 25UL \
+     : ((XF_TICK_FREQ) % 5UL == 0) ? 5UL : 1UL)
+
+#define XF_TICK_CONV_MIN(_a, _b)        (((_a) < (_b)) ? (_a) : (_b))
+
+/* 单位时间 = tick * XF_TICK_xx_MUL / XF_TICK_xx_DIV */
+#define XF_TICK_MS_MUL                  (1000UL / (XF_TICK_CONV_MIN(XF_TICK_FREQ_P2, 8UL) \
+                                                   * XF_TICK_CONV_MIN(XF_TICK_FREQ_P5, 125UL)))
+#define XF_TICK_MS_DIV                  ((XF_TICK_FREQ) / (1000UL / XF_TICK_MS_MUL))
+#define XF_TICK_US_MUL                  (1000000UL / (XF_TICK_CONV_MIN(XF_TICK_FREQ_P2, 64UL) \
+                                                      * XF_TICK_CONV_MIN(XF_TICK_FREQ_P5, 15625UL)))
+#define XF_TICK_US_DIV                  ((XF_TICK_FREQ) / (1000000UL / XF_TICK_US_MUL))
+#define XF_TICK_NS_MUL                  (1000000000UL / (XF_TICK_FREQ_P2 * XF_TICK_FREQ_P5))
+#define XF_TICK_NS_DIV                  ((XF_TICK_FREQ) / (1000000000UL / XF_TICK_NS_MUL))
+
+/**
+ * @brief 精确计算 floor(_v * _mul / _div), _v 的类型为 _type, 余数项使用 _rtype.
+ */
+#define XF_TICK_MULDIV(_type, _rtype, _v, _mul, _div) \
+    ((_type)((((_type)(_v) / (_div)) * (_mul)) \
+             + (_type)(((_rtype)((_type)(_v) % (_div)) * (_mul)) / (_div))))
+
+/* 余数项 (DIV - 1) * MUL 超出 32 位时使用 64 位；微秒有 64 位时总是 64 位，见下 */
+#if ((XF_TICK_MS_DIV - 1UL) * XF_TICK_MS_MUL > 0xFFFFFFFFUL) \
+        || ((XF_TICK_MS_MUL - 1UL) * XF_TICK_MS_DIV > 0xFFFFFFFFUL) \
+        || (!XF_COMMON_ENABLE_64BITS \
+            && (((XF_TICK_US_DIV - 1UL) * XF_TICK_US_MUL > 0xFFFFFFFFUL) \
+                || ((XF_TICK_US_MUL - 1UL) * XF_TICK_US_DIV > 0xFFFFFFFFUL)))
+#   if !XF_COMMON_ENABLE_64BITS
+#       error "XF_TICK_FREQ needs 64-bit intermediates, enable XF_COMMON_ENABLE_64BITS"
+#   endif
+typedef uint64_t xf_tick_conv_t;
+#else
+typedef uint32_t xf_tick_conv_t;
+#endif
+
+#define xf_tick_to_ms(_tick)            XF_TICK_MULDIV(xf_tick_t, xf_tick_conv_t, (_tick), XF_TICK_MS_MUL, XF_TICK_MS_DIV)
+#define xf_ms_to_tick(_ms)              XF_TICK_MULDIV(xf_tick_t, xf_tick_conv_t, (_ms), XF_TICK_MS_DIV, XF_TICK_MS_MUL)
+#define xf_tick_get_ms()                xf_tick_to_ms(xf_tick_get_count())
+
+#if XF_COMMON_ENABLE_64BITS
+/*
+    微秒与纳秒总是 64 位，与 xf_tick_t 的宽度无关
+    （32 位的微秒在 1kHz 时约 71.6 分钟就会回绕）。
+    转换为 tick 时按 64 位计算，结果为 xf_tick_t.
+ */
+#define xf_tick_to_us(_tick)            XF_TICK_MULDIV(uint64_t, uint64_t, (_tick), XF_TICK_US_MUL, XF_TICK_US_DIV)
+#define xf_us_to_tick(_us)              ((xf_tick_t)XF_TICK_MULDIV(uint64_t, uint64_t, (_us), XF_TICK_US_DIV, XF_TICK_US_MUL))
+#define xf_tick_get_us()                xf_tick_to_us(xf_tick_get_count())
+#define xf_tick_to_ns(_tick)            XF_TICK_MULDIV(uint64_t, uint64_t, (_tick), XF_TICK_NS_MUL, XF_TICK_NS_DIV)
+#define xf_ns_to_tick(_ns)              ((xf_tick_t)XF_TICK_MULDIV(uint64_t, uint64_t, (_ns), XF_TICK_NS_DIV, XF_TICK_NS_MUL))
+#define xf_tick_get_ns()                xf_tick_to_ns(xf_tick_get_count())
+#else
+/* 没有 64 位整数时微秒为 xf_tick_t, 会回绕 */
+#define xf_tick_to_us(_tick)            XF_TICK_MULDIV(xf_tick_t, xf_tick_conv_t, (_tick), XF_TICK_US_MUL, XF_TICK_US_DIV)
+#define xf_us_to_tick(_us)              XF_TICK_MULDIV(xf_tick_t, xf_tick_conv_t, (_us), XF_TICK_US_DIV, XF_TICK_US_MUL)
+#define xf_tick_get_us()                xf_tick_to_us(xf_tick_get_count())
+#endif
+
+/**
+ * @brief 读取原始计数值，不经过回调.
+ */
+__STATIC_INLINE xf_tick_t xf_tick_load_i(void)
+{
+#if XF_TICK_ENABLE_SEQLOCK
+    uint32_t seq;
+    xf_tick_t result;
+    do {
+        seq = XF_TICK_LOAD_ACQ_I(&xf_tick_i.seq);
+        result = xf_tick_i.count[seq & 1U];
+        XF_TICK_FENCE_ACQ_I();
+    } while (seq != XF_TICK_LOAD_I(&xf_tick_i.seq));
+    return result;
+#else
+    return XF_TICK_LOAD_I(&xf_tick_i.count);
+#endif
+}
+
+/**
+ * @brief 获取计数值.
+ *
+ * 未设置 tick_cb 及硬件计数器时只有一次回调指针判断和一次（原子）读。
+ */
+__STATIC_INLINE xf_tick_t xf_tick_get_count(void)
+{
+    xf_tick_get_cb_t get_cb = xf_tick_i.get_cb;
+    if (get_cb != NULL) {
+        return get_cb();
+    }
+    return xf_tick_load_i();
+}
 
 #ifdef __cplusplus
 } /* extern "C" */
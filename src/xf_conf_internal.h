@@ -110,6 +110,41 @@
 
 /* -------------------- components/dstruct ---------------------------------- */
 
+/* 内存池统计已分配块数的历史最大值及分配失败次数 */
+#ifndef XF_MEMPOOL_ENABLE_STATS
+    #ifdef CONFIG_XF_MEMPOOL_ENABLE_STATS
+        #define XF_MEMPOOL_ENABLE_STATS CONFIG_XF_MEMPOOL_ENABLE_STATS
+    #else
+        #define XF_MEMPOOL_ENABLE_STATS             0
+    #endif
+#endif
+
+/* TLSF 每个 2 的幂区间再细分为 2^N 个桶，越大内部碎片越少，控制结构越大（1~5） */
+#ifndef XF_TLSF_SL_INDEX_COUNT_LOG2
+    #ifdef CONFIG_XF_TLSF_SL_INDEX_COUNT_LOG2
+        #define XF_TLSF_SL_INDEX_COUNT_LOG2 CONFIG_XF_TLSF_SL_INDEX_COUNT_LOG2
+    #else
+        #define XF_TLSF_SL_INDEX_COUNT_LOG2         4
+    #endif
+#endif
+/* TLSF 单个块的容量小于 2^N 字节 */
+#ifndef XF_TLSF_FL_INDEX_MAX
+    #ifdef CONFIG_XF_TLSF_FL_INDEX_MAX
+        #define XF_TLSF_FL_INDEX_MAX CONFIG_XF_TLSF_FL_INDEX_MAX
+    #else
+        #define XF_TLSF_FL_INDEX_MAX                16
+    #endif
+#endif
+
+/* 位图查找使用 SIMD (AVX2/SSE2/NEON) 跳过全 0 / 全 1 的区域，不支持时逐块查找 */
+#ifndef XF_BITMAP_ENABLE_SIMD
+    #ifdef CONFIG_XF_BITMAP_ENABLE_SIMD
+        #define XF_BITMAP_ENABLE_SIMD CONFIG_XF_BITMAP_ENABLE_SIMD
+    #else
+        #define XF_BITMAP_ENABLE_SIMD               0
+    #endif
+#endif
+
 /* -------------------- components/log -------------------------------------- */
 
 #ifndef XF_LOG_ENABLE_CUSTOM_PORTING
@@ -177,6 +212,109 @@
     #endif
 #endif
 
+/* 单条日志最大长度（字节，含换行），超出部分截断；异步日志要求不超过 255 */
+#ifndef XF_LOG_LINE_SIZE
+    #ifdef CONFIG_XF_LOG_LINE_SIZE
+        #define XF_LOG_LINE_SIZE CONFIG_XF_LOG_LINE_SIZE
+    #else
+        #define XF_LOG_LINE_SIZE                    128
+    #endif
+#endif
+
+/* 运行时按标签设置日志等级（xf_log_set_level） */
+#ifndef XF_LOG_ENABLE_RUNTIME_LEVEL
+    #ifdef CONFIG_XF_LOG_ENABLE_RUNTIME_LEVEL
+        #define XF_LOG_ENABLE_RUNTIME_LEVEL CONFIG_XF_LOG_ENABLE_RUNTIME_LEVEL
+    #else
+        #define XF_LOG_ENABLE_RUNTIME_LEVEL         0
+    #endif
+#endif
+/* 可单独设置等级的标签个数 */
+#ifndef XF_LOG_TAG_LEVEL_NUM
+    #ifdef CONFIG_XF_LOG_TAG_LEVEL_NUM
+        #define XF_LOG_TAG_LEVEL_NUM CONFIG_XF_LOG_TAG_LEVEL_NUM
+    #else
+        #define XF_LOG_TAG_LEVEL_NUM                8
+    #endif
+#endif
+/* 标签指针到等级的缓存项数，必须是 2 的幂 */
+#ifndef XF_LOG_TAG_CACHE_SIZE
+    #ifdef CONFIG_XF_LOG_TAG_CACHE_SIZE
+        #define XF_LOG_TAG_CACHE_SIZE CONFIG_XF_LOG_TAG_CACHE_SIZE
+    #else
+        #define XF_LOG_TAG_CACHE_SIZE               16
+    #endif
+#endif
+
+/* 限频日志 XF_LOGx_RL: 每个调用点每个时间窗内最多输出 BURST 条 */
+#ifndef XF_LOG_ENABLE_RATELIMIT
+    #ifdef XF_KCONFIG_PRESENT
+        #ifdef CONFIG_XF_LOG_ENABLE_RATELIMIT
+            #define XF_LOG_ENABLE_RATELIMIT CONFIG_XF_LOG_ENABLE_RATELIMIT
+        #else
+            #define XF_LOG_ENABLE_RATELIMIT 0
+        #endif
+    #else
+        #define XF_LOG_ENABLE_RATELIMIT             1
+    #endif
+#endif
+#ifndef XF_LOG_RATELIMIT_BURST
+    #ifdef CONFIG_XF_LOG_RATELIMIT_BURST
+        #define XF_LOG_RATELIMIT_BURST CONFIG_XF_LOG_RATELIMIT_BURST
+    #else
+        #define XF_LOG_RATELIMIT_BURST              5
+    #endif
+#endif
+#ifndef XF_LOG_RATELIMIT_INTERVAL_MS
+    #ifdef CONFIG_XF_LOG_RATELIMIT_INTERVAL_MS
+        #define XF_LOG_RATELIMIT_INTERVAL_MS CONFIG_XF_LOG_RATELIMIT_INTERVAL_MS
+    #else
+        #define XF_LOG_RATELIMIT_INTERVAL_MS        1000
+    #endif
+#endif
+
+/* 延迟日志: XF_LOGx 只记录格式字符串地址、标签、tick 及原始参数，由主机端解码 */
+#ifndef XF_LOG_ENABLE_DEFERRED
+    #ifdef CONFIG_XF_LOG_ENABLE_DEFERRED
+        #define XF_LOG_ENABLE_DEFERRED CONFIG_XF_LOG_ENABLE_DEFERRED
+    #else
+        #define XF_LOG_ENABLE_DEFERRED              0
+    #endif
+#endif
+/* 延迟日志缓冲区大小（字节），必须是 2 的幂 */
+#ifndef XF_LOG_DEFERRED_BUF_SIZE
+    #ifdef CONFIG_XF_LOG_DEFERRED_BUF_SIZE
+        #define XF_LOG_DEFERRED_BUF_SIZE CONFIG_XF_LOG_DEFERRED_BUF_SIZE
+    #else
+        #define XF_LOG_DEFERRED_BUF_SIZE            1024
+    #endif
+#endif
+
+/* 异步日志: xf_log_level 格式化到环形缓冲区后立即返回，由后台任务输出 */
+#ifndef XF_LOG_ENABLE_ASYNC
+    #ifdef CONFIG_XF_LOG_ENABLE_ASYNC
+        #define XF_LOG_ENABLE_ASYNC CONFIG_XF_LOG_ENABLE_ASYNC
+    #else
+        #define XF_LOG_ENABLE_ASYNC                 0
+    #endif
+#endif
+/* 异步日志缓冲区大小（字节），必须是 2 的幂 */
+#ifndef XF_LOG_ASYNC_BUF_SIZE
+    #ifdef CONFIG_XF_LOG_ASYNC_BUF_SIZE
+        #define XF_LOG_ASYNC_BUF_SIZE CONFIG_XF_LOG_ASYNC_BUF_SIZE
+    #else
+        #define XF_LOG_ASYNC_BUF_SIZE               1024
+    #endif
+#endif
+/* 缓冲区满时的策略: 0 丢弃新日志, 1 丢弃旧日志, 2 阻塞（调用者同步输出旧日志） */
+#ifndef XF_LOG_ASYNC_OVERFLOW_POLICY
+    #ifdef CONFIG_XF_LOG_ASYNC_OVERFLOW_POLICY
+        #define XF_LOG_ASYNC_OVERFLOW_POLICY CONFIG_XF_LOG_ASYNC_OVERFLOW_POLICY
+    #else
+        #define XF_LOG_ASYNC_OVERFLOW_POLICY        0
+    #endif
+#endif
+
 /* -------------------- components/std -------------------------------------- */
 
 /* XF_STD_STRING_* 只能二选一 */
@@ -198,6 +336,23 @@
         #define XF_STRING_ENABLE_LIBC               1
     #endif
 #endif
+/* builtin 内存函数使用 SIMD (AVX2/SSE2/NEON)，按编译目标自动选择，不支持时退化为按字处理 */
+#ifndef XF_STRING_ENABLE_SIMD
+    #ifdef CONFIG_XF_STRING_ENABLE_SIMD
+        #define XF_STRING_ENABLE_SIMD CONFIG_XF_STRING_ENABLE_SIMD
+    #else
+        #define XF_STRING_ENABLE_SIMD               0
+    #endif
+#endif
+
+/* xf_snprintf 支持 %f */
+#ifndef XF_PRINTF_ENABLE_FLOAT
+    #ifdef CONFIG_XF_PRINTF_ENABLE_FLOAT
+        #define XF_PRINTF_ENABLE_FLOAT CONFIG_XF_PRINTF_ENABLE_FLOAT
+    #else
+        #define XF_PRINTF_ENABLE_FLOAT              0
+    #endif
+#endif
 
 /* -------------------- components/system ----------------------------------- */
 
@@ -239,6 +394,34 @@
 
 /* -------------------- components/system/event ----------------------------- */
 
+/* 事件 id 分配使用分层位图（xf_hbitmap），id 数量很大时查找仍为 O(1) */
+#ifndef XF_EVENT_ENABLE_HBITMAP
+    #ifdef CONFIG_XF_EVENT_ENABLE_HBITMAP
+        #define XF_EVENT_ENABLE_HBITMAP CONFIG_XF_EVENT_ENABLE_HBITMAP
+    #else
+        #define XF_EVENT_ENABLE_HBITMAP             0
+    #endif
+#endif
+
+/* -------------------- components/system/prof ------------------------------ */
+
+/* 性能剖析区段 XF_PROF_ZONE_BEGIN/END，关闭时不产生任何代码 */
+#ifndef XF_PROF_ENABLE
+    #ifdef CONFIG_XF_PROF_ENABLE
+        #define XF_PROF_ENABLE CONFIG_XF_PROF_ENABLE
+    #else
+        #define XF_PROF_ENABLE                      0
+    #endif
+#endif
+/* 区段统计槽数量，用完后新区段计入 "(other)" */
+#ifndef XF_PROF_ZONE_NUM_MAX
+    #ifdef CONFIG_XF_PROF_ZONE_NUM_MAX
+        #define XF_PROF_ZONE_NUM_MAX CONFIG_XF_PROF_ZONE_NUM_MAX
+    #else
+        #define XF_PROF_ZONE_NUM_MAX                16
+    #endif
+#endif
+
 /* -------------------- components/system/ps -------------------------------- */
 
 /* 内置消息队列中最大消息数量 */
@@ -257,6 +440,30 @@
         #define XF_PS_SUBSCRIBER_NUM_MAX            16
     #endif
 #endif
+/* 静态订阅表 XF_SUBSCRIBE_STATIC，需要 GNU 工具链及链接器生成 __start_/__stop_ 符号 */
+#ifndef XF_PS_ENABLE_STATIC
+    #ifdef CONFIG_XF_PS_ENABLE_STATIC
+        #define XF_PS_ENABLE_STATIC CONFIG_XF_PS_ENABLE_STATIC
+    #else
+        #define XF_PS_ENABLE_STATIC                 0
+    #endif
+#endif
+/* 静态订阅者数量上限，用于 xf_ps_init 建立按事件 ID 排序的下标 */
+#ifndef XF_PS_STATIC_NUM_MAX
+    #ifdef CONFIG_XF_PS_STATIC_NUM_MAX
+        #define XF_PS_STATIC_NUM_MAX CONFIG_XF_PS_STATIC_NUM_MAX
+    #else
+        #define XF_PS_STATIC_NUM_MAX                16
+    #endif
+#endif
+/* 每次 xf_ps_dispatch 的时间预算，单位 tick ，超出后剩余事件留到下一次。0: 不限制 */
+#ifndef XF_PS_DISPATCH_BUDGET
+    #ifdef CONFIG_XF_PS_DISPATCH_BUDGET
+        #define XF_PS_DISPATCH_BUDGET CONFIG_XF_PS_DISPATCH_BUDGET
+    #else
+        #define XF_PS_DISPATCH_BUDGET               0
+    #endif
+#endif
 
 /* -------------------- components/system/safe ------------------------------ */
 
@@ -278,6 +485,22 @@
         #define XF_STIMER_NO_READY_DELAY            1000
     #endif
 #endif
+/* 固定速率定时器超时一个周期以上时，1: 补执行错过的周期; 0: 跳过 */
+#ifndef XF_STIMER_ENABLE_CATCH_UP
+    #ifdef CONFIG_XF_STIMER_ENABLE_CATCH_UP
+        #define XF_STIMER_ENABLE_CATCH_UP CONFIG_XF_STIMER_ENABLE_CATCH_UP
+    #else
+        #define XF_STIMER_ENABLE_CATCH_UP           0
+    #endif
+#endif
+/* 已使用定时器使用分层位图（xf_hbitmap）记录，定时器数量很大时扫描不再逐块进行 */
+#ifndef XF_STIMER_ENABLE_HBITMAP
+    #ifdef CONFIG_XF_STIMER_ENABLE_HBITMAP
+        #define XF_STIMER_ENABLE_HBITMAP CONFIG_XF_STIMER_ENABLE_HBITMAP
+    #else
+        #define XF_STIMER_ENABLE_HBITMAP            0
+    #endif
+#endif
 
 /* -------------------- components/system/task ------------------------------ */
 
@@ -325,9 +548,50 @@
         #define XF_TASK_EVENT_MSG_NUM_MAX           4
     #endif
 #endif
+/* xf_task_delay_until 超时一个周期以上时，1: 立即补执行错过的周期; 0: 跳过 */
+#ifndef XF_TASK_ENABLE_DELAY_UNTIL_CATCH_UP
+    #ifdef CONFIG_XF_TASK_ENABLE_DELAY_UNTIL_CATCH_UP
+        #define XF_TASK_ENABLE_DELAY_UNTIL_CATCH_UP CONFIG_XF_TASK_ENABLE_DELAY_UNTIL_CATCH_UP
+    #else
+        #define XF_TASK_ENABLE_DELAY_UNTIL_CATCH_UP 0
+    #endif
+#endif
+/* 静态任务表 XF_TASK_DEFINE_STATIC，需要 GNU 工具链及链接器生成 __start_/__stop_ 符号 */
+#ifndef XF_TASK_ENABLE_STATIC
+    #ifdef CONFIG_XF_TASK_ENABLE_STATIC
+        #define XF_TASK_ENABLE_STATIC CONFIG_XF_TASK_ENABLE_STATIC
+    #else
+        #define XF_TASK_ENABLE_STATIC               0
+    #endif
+#endif
+/* 每轮调度的时间预算，单位 tick ，超出后剩余任务留到下一轮。0: 不限制 */
+#ifndef XF_TASK_SCHED_BUDGET
+    #ifdef CONFIG_XF_TASK_SCHED_BUDGET
+        #define XF_TASK_SCHED_BUDGET CONFIG_XF_TASK_SCHED_BUDGET
+    #else
+        #define XF_TASK_SCHED_BUDGET                0
+    #endif
+#endif
+/* 统计每个任务的运行次数、累计耗时及单次最长耗时 */
+#ifndef XF_TASK_ENABLE_STATS
+    #ifdef CONFIG_XF_TASK_ENABLE_STATS
+        #define XF_TASK_ENABLE_STATS CONFIG_XF_TASK_ENABLE_STATS
+    #else
+        #define XF_TASK_ENABLE_STATS                0
+    #endif
+#endif
+/* 已分配任务使用分层位图（xf_hbitmap）记录，调度及遍历时跳过空闲的任务 */
+#ifndef XF_TASK_ENABLE_HBITMAP
+    #ifdef CONFIG_XF_TASK_ENABLE_HBITMAP
+        #define XF_TASK_ENABLE_HBITMAP CONFIG_XF_TASK_ENABLE_HBITMAP
+    #else
+        #define XF_TASK_ENABLE_HBITMAP              0
+    #endif
+#endif
 
 /* -------------------- components/system/tick ------------------------------ */
 
+/* tick 频率，单位 Hz. 使用 64 位 tick 时可设为 1000000（微秒）或 CPU 频率 */
 #ifndef XF_TICK_FREQ
     #ifdef CONFIG_XF_TICK_FREQ
         #define XF_TICK_FREQ CONFIG_XF_TICK_FREQ
@@ -335,6 +599,14 @@
         #define XF_TICK_FREQ                        1000
     #endif
 #endif
+/* xf_tick_t 使用 64 位，高频 tick 也不会回绕 */
+#ifndef XF_TICK_ENABLE_64BITS
+    #ifdef CONFIG_XF_TICK_ENABLE_64BITS
+        #define XF_TICK_ENABLE_64BITS CONFIG_XF_TICK_ENABLE_64BITS
+    #else
+        #define XF_TICK_ENABLE_64BITS               0
+    #endif
+#endif
 
 /* -------------------- components/utils ------------------------------------ */
 
@@ -0,0 +1,168 @@
+#!/usr/bin/env python3
+
+# ------------------------------------------------------------------------------
+# @brief Decodes the deferred binary log (XF_LOG_ENABLE_DEFERRED) using the firmware ELF
+# SPDX-FileCopyrightText: 2025 CompanyNameMagicTag
+# SPDX-License-Identifier: Apache-2.0
+# ------------------------------------------------------------------------------
+
+'''
+Decodes the raw stream produced by xf_log_deferred_read() into text lines in the
+same layout as xf_log_level():
+
+    <level> (<ms>)-<tag>: <message>
+
+Each record is a sequence of native words (uintptr_t):
+
+    format address, tag address, tick,
+    (MAGIC << 24) | (arg_num << 8) | level,
+    arg[0] ... arg[arg_num - 1]
+
+Format strings, tags and "%s" arguments are resolved from the allocated sections
+of the ELF file. Word size and byte order are taken from the ELF header.
+
+Usage:
+    python3 tools/xf_log_decode.py firmware.elf log.bin [--tick-freq 1000]
+'''
+
+import argparse
+import re
+import struct
+import sys
+
+XF_LOG_DEFERRED_MAGIC = 0x4C
+XF_LOG_DEFERRED_ARG_NUM_MAX = 8
+
+LEVEL_TO_PROMPT = {1: 'E', 2: 'W', 3: 'I', 4: 'D', 5: 'V'}
+
+SHF_ALLOC = 0x2
+SHT_NOBITS = 8
+
+# printf conversion: %[flags][width][.precision][length]conversion
+FMT_SPEC = re.compile(r'%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?(hh|h|ll|l|j|z|t|L)?([diouxXcspfFeEgGaA%])')
+
+
+class Elf:
+    '''Minimal ELF reader: word size, byte order and allocated section contents.'''
+
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+        if self.data[:4] != b'\x7fELF':
+            raise ValueError(f'{path}: not an ELF file')
+        self.word_size = 8 if self.data[4] == 2 else 4
+        self.endian = '<' if self.data[5] == 1 else '>'
+        self.sections = []
+        if self.word_size == 8:
+            shoff, = struct.unpack_from(self.endian + 'Q', self.data, 0x28)
+            shentsize, shnum = struct.unpack_from(self.endian + 'HH', self.data, 0x3A)
+            sh_fmt = self.endian + 'IIQQQQIIQQ'
+        else:
+            shoff, = struct.unpack_from(self.endian + 'I', self.data, 0x20)
+            shentsize, shnum = struct.unpack_from(self.endian + 'HH', self.data, 0x2E)
+            sh_fmt = self.endian + 'IIIIIIIIII'
+        for i in range(shnum):
+            sh = struct.unpack_from(sh_fmt, self.data, shoff + i * shentsize)
+            sh_type, sh_flags, sh_addr, sh_offset, sh_size = sh[1], sh[2], sh[3], sh[4], sh[5]
+            if (sh_flags & SHF_ALLOC) and sh_type != SHT_NOBITS and sh_addr != 0:
+                self.sections.append((sh_addr, sh_offset, sh_size))
+
+    def read_str(self, addr):
+        for sh_addr, sh_offset, sh_size in self.sections:
+            if sh_addr <= addr < sh_addr + sh_size:
+                start = sh_offset + (addr - sh_addr)
+                end = self.data.find(b'\0', start, sh_offset + sh_size)
+                if end < 0:
+                    end = sh_offset + sh_size
+                return self.data[start:end].decode('utf-8', errors='replace')
+        return None
+
+
+def to_signed(value, bits):
+    value &= (1 << bits) - 1
+    return value - (1 << bits) if value >> (bits - 1) else value
+
+
+def format_message(elf, fmt, args):
+    '''Applies the C format to raw words; only integer, char, pointer and string args.'''
+    out = []
+    pos = 0
+    arg_idx = 0
+    word_bits = elf.word_size * 8
+    for m in FMT_SPEC.finditer(fmt):
+        out.append(fmt[pos:m.start()])
+        pos = m.end()
+        flags, width, prec, length, conv = m.groups()
+        if conv == '%':
+            out.append('%')
+            continue
+        if width == '*' or prec == '*':
+            out.append(m.group(0))
+            continue
+        value = args[arg_idx] if arg_idx < len(args) else 0
+        arg_idx += 1
+        # int 以外的长度按字宽处理
+        bits = word_bits if length in ('l', 'll', 'j', 'z', 't') else 32
+        spec = '%' + (flags or '') + (width or '') + ('.' + prec if prec is not None else '')
+        if conv in 'di':
+            out.append((spec + 'd') % to_signed(value, bits))
+        elif conv in 'ouxX':
+            out.append((spec + conv) % (value & ((1 << bits) - 1)))
+        elif conv == 'c':
+            out.append((spec + 'c') % chr(value & 0xFF))
+        elif conv == 's':
+            s = elf.read_str(value)
+            out.append((spec + 's') % (s if s is not None else f'<0x{value:x}>'))
+        elif conv == 'p':
+            out.append(f'0x{value:x}')
+        else:
+            # 浮点参数在记录时已被截断为整数
+            out.append(f'<{conv}?>')
+    out.append(fmt[pos:])
+    return ''.join(out)
+
+
+def decode(elf, raw, tick_freq, out):
+    word = elf.endian + ('Q' if elf.word_size == 8 else 'I')
+    words = [v for (v,) in struct.iter_unpack(word, raw[:len(raw) - len(raw) % elf.word_size])]
+    i = 0
+    while i + 4 <= len(words):
+        fmt_addr, tag_addr, tick, info = words[i:i + 4]
+        level = info & 0xFF
+        arg_num = (info >> 8) & 0xFF
+        if ((info >> 24) & 0xFF) != XF_LOG_DEFERRED_MAGIC or arg_num > XF_LOG_DEFERRED_ARG_NUM_MAX:
+            # 失去同步，逐字向后查找下一条记录
+            i += 1
+            continue
+        if i + 4 + arg_num > len(words):
+            break
+        args = words[i + 4:i + 4 + arg_num]
+        i += 4 + arg_num
+        fmt = elf.read_str(fmt_addr)
+        tag = elf.read_str(tag_addr)
+        if fmt is None:
+            fmt = f'<fmt 0x{fmt_addr:x}>'
+        if tag is None:
+            tag = f'<tag 0x{tag_addr:x}>'
+        ms = (tick & 0xFFFFFFFF) * 1000 // tick_freq
+        out.write(f'{LEVEL_TO_PROMPT.get(level, "?")} ({ms})-{tag}: {format_message(elf, fmt, args)}\n')
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode xtiny deferred binary log.')
+    parser.add_argument('elf', help='firmware ELF file with symbols and .rodata')
+    parser.add_argument('log', help='raw data read by xf_log_deferred_read(), "-" for stdin')
+    parser.add_argument('--tick-freq', type=int, default=1000, help='XF_TICK_FREQ, in Hz (default: 1000)')
+    args = parser.parse_args()
+
+    elf = Elf(args.elf)
+    if args.log == '-':
+        raw = sys.stdin.buffer.read()
+    else:
+        with open(args.log, 'rb') as f:
+            raw = f.read()
+    decode(elf, raw, args.tick_freq, sys.stdout)
+
+
+if __name__ == '__main__':
+    main()
@@ -39,6 +39,17 @@
 
 /* -------------------- components/dstruct ---------------------------------- */
 
+/* 内存池统计已分配块数的历史最大值及分配失败次数 */
+#define XF_MEMPOOL_ENABLE_STATS             0
+
+/* TLSF 每个 2 的幂区间再细分为 2^N 个桶，越大内部碎片越少，控制结构越大（1~5） */
+#define XF_TLSF_SL_INDEX_COUNT_LOG2         4
+/* TLSF 单个块的容量小于 2^N 字节 */
+#define XF_TLSF_FL_INDEX_MAX                16
+
+/* 位图查找使用 SIMD (AVX2/SSE2/NEON) 跳过全 0 / 全 1 的区域，不支持时逐块查找 */
+#define XF_BITMAP_ENABLE_SIMD               0
+
 /* -------------------- components/log -------------------------------------- */
 
 #define XF_LOG_ENABLE_CUSTOM_PORTING        0
@@ -50,11 +61,43 @@
 #define XF_LOG_ENABLE_DEBUG_LEVEL           1
 #define XF_LOG_ENABLE_VERBOSE_LEVEL         1
 
+/* 单条日志最大长度（字节，含换行），超出部分截断；异步日志要求不超过 255 */
+#define XF_LOG_LINE_SIZE                    128
+
+/* 运行时按标签设置日志等级（xf_log_set_level） */
+#define XF_LOG_ENABLE_RUNTIME_LEVEL         0
+/* 可单独设置等级的标签个数 */
+#define XF_LOG_TAG_LEVEL_NUM                8
+/* 标签指针到等级的缓存项数，必须是 2 的幂 */
+#define XF_LOG_TAG_CACHE_SIZE               16
+
+/* 限频日志 XF_LOGx_RL: 每个调用点每个时间窗内最多输出 BURST 条 */
+#define XF_LOG_ENABLE_RATELIMIT             1
+#define XF_LOG_RATELIMIT_BURST              5
+#define XF_LOG_RATELIMIT_INTERVAL_MS        1000
+
+/* 延迟日志: XF_LOGx 只记录格式字符串地址、标签、tick 及原始参数，由主机端解码 */
+#define XF_LOG_ENABLE_DEFERRED              0
+/* 延迟日志缓冲区大小（字节），必须是 2 的幂 */
+#define XF_LOG_DEFERRED_BUF_SIZE            1024
+
+/* 异步日志: xf_log_level 格式化到环形缓冲区后立即返回，由后台任务输出 */
+#define XF_LOG_ENABLE_ASYNC                 0
+/* 异步日志缓冲区大小（字节），必须是 2 的幂 */
+#define XF_LOG_ASYNC_BUF_SIZE               1024
+/* 缓冲区满时的策略: 0 丢弃新日志, 1 丢弃旧日志, 2 阻塞（调用者同步输出旧日志） */
+#define XF_LOG_ASYNC_OVERFLOW_POLICY        0
+
 /* -------------------- components/std -------------------------------------- */
 
 /* XF_STD_STRING_* 只能二选一 */
 #define XF_STRING_ENABLE_BUILTIN            0
 #define XF_STRING_ENABLE_LIBC               1
+/* builtin 内存函数使用 SIMD (AVX2/SSE2/NEON)，按编译目标自动选择，不支持时退化为按字处理 */
+#define XF_STRING_ENABLE_SIMD               0
+
+/* xf_snprintf 支持 %f */
+#define XF_PRINTF_ENABLE_FLOAT              0
 
 /* -------------------- components/system ----------------------------------- */
 
@@ -66,12 +109,28 @@
 
 /* -------------------- components/system/event ----------------------------- */
 
+/* 事件 id 分配使用分层位图（xf_hbitmap），id 数量很大时查找仍为 O(1) */
+#define XF_EVENT_ENABLE_HBITMAP             0
+
+/* -------------------- components/system/prof ------------------------------ */
+
+/* 性能剖析区段 XF_PROF_ZONE_BEGIN/END，关闭时不产生任何代码 */
+#define XF_PROF_ENABLE                      0
+/* 区段统计槽数量，用完后新区段计入 "(other)" */
+#define XF_PROF_ZONE_NUM_MAX                16
+
 /* -------------------- components/system/ps -------------------------------- */
 
 /* 内置消息队列中最大消息数量 */
 #define XF_PS_MSG_NUM_MAX                   16
 /* 订阅者数量 */
 #define XF_PS_SUBSCRIBER_NUM_MAX            16
+/* 静态订阅表 XF_SUBSCRIBE_STATIC，需要 GNU 工具链及链接器生成 __start_/__stop_ 符号 */
+#define XF_PS_ENABLE_STATIC                 0
+/* 静态订阅者数量上限，用于 xf_ps_init 建立按事件 ID 排序的下标 */
+#define XF_PS_STATIC_NUM_MAX                16
+/* 每次 xf_ps_dispatch 的时间预算，单位 tick ，超出后剩余事件留到下一次。0: 不限制 */
+#define XF_PS_DISPATCH_BUDGET               0
 
 /* -------------------- components/system/safe ------------------------------ */
 
@@ -81,6 +140,10 @@
 #define XF_STIMER_NUM_MAX                   16
 /* 没有定时器就绪时的延时时间，单位 tick */
 #define XF_STIMER_NO_READY_DELAY            1000
+/* 固定速率定时器超时一个周期以上时，1: 补执行错过的周期; 0: 跳过 */
+#define XF_STIMER_ENABLE_CATCH_UP           0
+/* 已使用定时器使用分层位图（xf_hbitmap）记录，定时器数量很大时扫描不再逐块进行 */
+#define XF_STIMER_ENABLE_HBITMAP            0
 
 /* -------------------- components/system/task ------------------------------ */
 
@@ -94,10 +157,23 @@
 #define XF_TASK_NEST_DEPTH_MAX              6
 /* 任务事件消息缓存数量，至少为 1 。由于未测试，此处使用 4 */
 #define XF_TASK_EVENT_MSG_NUM_MAX           4
+/* xf_task_delay_until 超时一个周期以上时，1: 立即补执行错过的周期; 0: 跳过 */
+#define XF_TASK_ENABLE_DELAY_UNTIL_CATCH_UP 0
+/* 静态任务表 XF_TASK_DEFINE_STATIC，需要 GNU 工具链及链接器生成 __start_/__stop_ 符号 */
+#define XF_TASK_ENABLE_STATIC               0
+/* 每轮调度的时间预算，单位 tick ，超出后剩余任务留到下一轮。0: 不限制 */
+#define XF_TASK_SCHED_BUDGET                0
+/* 统计每个任务的运行次数、累计耗时及单次最长耗时 */
+#define XF_TASK_ENABLE_STATS                0
+/* 已分配任务使用分层位图（xf_hbitmap）记录，调度及遍历时跳过空闲的任务 */
+#define XF_TASK_ENABLE_HBITMAP              0
 
 /* -------------------- components/system/tick ------------------------------ */
 
+/* tick 频率，单位 Hz. 使用 64 位 tick 时可设为 1000000（微秒）或 CPU 频率 */
 #define XF_TICK_FREQ                        1000
+/* xf_tick_t 使用 64 位，高频 tick 也不会回绕 */
+#define XF_TICK_ENABLE_64BITS               0
 
 /* -------------------- components/utils ------------------------------------ */
 
@@ -28,18 +28,25 @@
 #include "src/common/xf_macro_definition.h"
 #include "src/common/xf_types.h"
 
+#include "src/dstruct/xf_arena.h"
 #include "src/dstruct/xf_bitmap.h"
 #include "src/dstruct/xf_deque.h"
 #include "src/dstruct/xf_dstruct.h"
+#include "src/dstruct/xf_hbitmap.h"
 #include "src/dstruct/xf_list.h"
+#include "src/dstruct/xf_mempool.h"
+#include "src/dstruct/xf_tlsf.h"
 
 #include "src/log/xf_log.h"
 
+#include "src/std/xf_printf.h"
 #include "src/std/xf_std.h"
 #include "src/std/xf_string.h"
 
+#include "src/system/chan/xf_chan.h"
 #include "src/system/check/xf_check.h"
 #include "src/system/event/xf_event.h"
+#include "src/system/prof/xf_prof.h"
 #include "src/system/ps/xf_ps.h"
 #include "src/system/safe/xf_safe.h"
 #include "src/system/stimer/xf_stimer.h"